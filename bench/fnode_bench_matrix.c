@@ -0,0 +1,178 @@
+/**********************************************************************************************
+*
+*   FNode 1.1 - Matrix kernels micro-benchmark
+*
+*   DESCRIPTION:
+*
+*   Times FNode matrix kernels used by nodes values calculation and mesh vertices batches:
+*   FMatrixMultiply(), FMultiplyMatrixVector(), FMatrixTranspose() and FLanesTransform().
+*   Build it defining FNODE_NO_SIMD to time the scalar kernels instead of the SSE2 ones.
+*
+*   Enable FNODE_BENCH option in CMake to build it:
+*   cmake -S . -B build -DFNODE_BENCH=ON && cmake --build build --target FNodeBenchMatrix FNodeBenchMatrixScalar
+*
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2016-2020 Victor Fisac
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*
+**********************************************************************************************/
+
+//----------------------------------------------------------------------------------
+// Includes
+//----------------------------------------------------------------------------------
+#define FNODE_IMPLEMENTATION
+#include "fnode.h"
+
+#include <time.h>               // Required for: clock(), CLOCKS_PER_SEC
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define     BENCH_MATRICES              4096                                        // Matrices and vectors count of every benchmark pass
+#define     BENCH_PASSES                500                                         // Benchmark passes over all matrices and vectors
+#define     BENCH_SEED                  3                                           // Random values seed, so every build times the same values
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static Matrix matrices[BENCH_MATRICES];                 // Random matrices operated by kernels
+static Vector4 vectors[BENCH_MATRICES];                 // Random vectors transformed by kernels
+static float lanes[4*BENCH_MATRICES];                   // Components lanes vectors transformed by lanes kernel (x lanes, y lanes...)
+static volatile float sink = 0.0f;                      // Kernels results accumulator, so compiler does not discard them
+
+//----------------------------------------------------------------------------------
+// Functions Declaration
+//----------------------------------------------------------------------------------
+static float RandomValue(void);                                 // Returns a random value between -12.87 and 12.87
+static double BenchMultiply(void);                              // Returns FMatrixMultiply() elapsed seconds
+static double BenchMultiplyVector(void);                        // Returns FMultiplyMatrixVector() elapsed seconds
+static double BenchTranspose(void);                             // Returns FMatrixTranspose() elapsed seconds
+static double BenchLanesTransform(void);                        // Returns FLanesTransform() elapsed seconds
+static void PrintResult(const char *name, double seconds);      // Prints a kernel nanoseconds per operation
+
+//----------------------------------------------------------------------------------
+// Main Entry Point
+//----------------------------------------------------------------------------------
+int main(void)
+{
+    srand(BENCH_SEED);
+
+    for (int i = 0; i < BENCH_MATRICES; i++)
+    {
+        float *values = (float *)&matrices[i];
+        for (int k = 0; k < 16; k++) values[k] = RandomValue();
+
+        vectors[i] = (Vector4){ RandomValue(), RandomValue(), RandomValue(), 1.0f };
+    }
+
+    for (int i = 0; i < 4*BENCH_MATRICES; i++) lanes[i] = RandomValue();
+
+#if defined(FNODE_SIMD_SSE2)
+    printf("FNode matrix kernels (SSE2), %i matrices x %i passes\n", BENCH_MATRICES, BENCH_PASSES);
+#else
+    printf("FNode matrix kernels (scalar), %i matrices x %i passes\n", BENCH_MATRICES, BENCH_PASSES);
+#endif
+
+    PrintResult("FMatrixMultiply", BenchMultiply());
+    PrintResult("FMultiplyMatrixVector", BenchMultiplyVector());
+    PrintResult("FMatrixTranspose", BenchTranspose());
+    PrintResult("FLanesTransform", BenchLanesTransform());
+
+    return 0;
+}
+
+//----------------------------------------------------------------------------------
+// Functions Definition
+//----------------------------------------------------------------------------------
+// Returns a random value between -12.87 and 12.87
+static float RandomValue(void)
+{
+    return (rand()%20001 - 10000)/777.0f;
+}
+
+// Returns FMatrixMultiply() elapsed seconds
+static double BenchMultiply(void)
+{
+    clock_t start = clock();
+
+    for (int p = 0; p < BENCH_PASSES; p++)
+    {
+        for (int i = 0; i < BENCH_MATRICES; i++)
+        {
+            Matrix result;
+            FMatrixMultiply(&result, &matrices[i], &matrices[(i + 1) % BENCH_MATRICES]);
+            sink += result.m5;
+        }
+    }
+
+    return (double)(clock() - start)/CLOCKS_PER_SEC;
+}
+
+// Returns FMultiplyMatrixVector() elapsed seconds
+static double BenchMultiplyVector(void)
+{
+    clock_t start = clock();
+
+    for (int p = 0; p < BENCH_PASSES; p++)
+    {
+        for (int i = 0; i < BENCH_MATRICES; i++)
+        {
+            Vector4 vector = vectors[i];
+            FMultiplyMatrixVector(&vector, &matrices[i]);
+            sink += vector.y;
+        }
+    }
+
+    return (double)(clock() - start)/CLOCKS_PER_SEC;
+}
+
+// Returns FMatrixTranspose() elapsed seconds
+static double BenchTranspose(void)
+{
+    clock_t start = clock();
+
+    for (int p = 0; p < BENCH_PASSES; p++)
+    {
+        for (int i = 0; i < BENCH_MATRICES; i++) FMatrixTranspose(&matrices[i]);
+    }
+
+    sink += matrices[0].m1;
+
+    return (double)(clock() - start)/CLOCKS_PER_SEC;
+}
+
+// Returns FLanesTransform() elapsed seconds
+static double BenchLanesTransform(void)
+{
+    // Scales vectors by a half keeping them bounded across passes
+    Matrix mat = { 0.5f, 0.0f, 0.0f, 0.1f, 0.0f, 0.5f, 0.0f, 0.2f, 0.0f, 0.0f, 0.5f, 0.3f, 0.0f, 0.0f, 0.0f, 1.0f };
+    clock_t start = clock();
+
+    for (int p = 0; p < BENCH_PASSES; p++) FLanesTransform(lanes, BENCH_MATRICES, &mat, BENCH_MATRICES);
+
+    sink += lanes[1];
+
+    return (double)(clock() - start)/CLOCKS_PER_SEC;
+}
+
+// Prints a kernel nanoseconds per operation
+static void PrintResult(const char *name, double seconds)
+{
+    printf("%-24s %8.2f ns/op\n", name, seconds*1e9/((double)BENCH_PASSES*BENCH_MATRICES));
+}
@@ -50,6 +50,10 @@
 //----------------------------------------------------------------------------------
 #define     MAX_INPUTS                  4                       // Max number of inputs in every node
 #define     MAX_VALUES                  16                      // Max number of values in every output
+#define     HANDLE_INDEX_BITS           20                      // Handle bits used to store the entity id (remaining bits store its generation)
+#define     HANDLE_INDEX_MASK           ((1u << HANDLE_INDEX_BITS) - 1)
+#define     HANDLE_GENERATION_MASK      ((1u << (32 - HANDLE_INDEX_BITS)) - 1)
+#define     NULL_HANDLE                 0                       // Handle which never references an entity
 
 //----------------------------------------------------------------------------------
 // Enums Definition
@@ -117,29 +121,50 @@ typedef enum {
     GLSL_100
 } ShaderVersion;
 
+typedef enum {
+    FNODE_ACCURACY_EXACT,
+    FNODE_ACCURACY_FAST
+} FNodeAccuracy;
+
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
 typedef struct FNodeValue {
-    float value;                            // Output data value
     Rectangle shape;                        // Output data shape
     char *valueText;                        // Output data value as text
 } FNodeValue;
 
 typedef struct FNodeOutput {
-    FNodeValue data[MAX_VALUES];            // Output data array (float, Vector2, Vector3 or Vector4)
+    float data[MAX_VALUES];                 // Output data values array packed contiguously (float, Vector2, Vector3, Vector4 or Matrix)
     int dataCount;                          // Output data length to know which type of data represents
 } FNodeOutput;
 
+typedef struct FLineData *FLine;
+typedef unsigned int FHandle;               // Entity reference packing its id and generation (stale once the entity is destroyed)
+
 typedef struct FNodeData {
     unsigned int id;                        // Node unique identifier
     FNodeType type;                         // Node type (values, operations...)
     const char *name;                       // Displayed name of the node
     int inputs[MAX_INPUTS];                 // Inputs node ids array
+    FLine inputLines[MAX_INPUTS];           // Inputs lines array (incoming adjacency list, same order as inputs)
     unsigned int inputsCount;               // Inputs node ids array length
     unsigned int inputsLimit;               // Inputs node ids length limit
     bool property;                          // Node is property state
+    FLine outputLines;                      // First line linked to node output (outgoing adjacency list)
+    unsigned int outputsCount;              // Lines linked to node output count
     FNodeOutput output;                     // Value output (contains the value and its length)
+    FNodeValue *values;                     // Output data values shapes and texts (stored apart from evaluation data)
+    bool textDirty;                         // Output data values texts and shapes need to be updated again (values changed since last update)
+    int drawIndex;                          // Node position in nodes draw order list
+    int scheduleIndex;                      // Node position in nodes calculation order list
+    bool dirty;                             // Node values need to be calculated again (its values or inputs changed)
+    int usesCount;                          // Node uses count from output nodes reachable consumers, output nodes and pins (calculated only if greater than 0)
+    bool pinned;                            // Node values are calculated even if output nodes cannot reach it (node is being viewed)
+    int rank;                               // Node topological rank (always lower than the rank of the nodes linked to its output)
+    bool visited;                           // Node was already visited during current rank search
+    unsigned int hash;                      // Node structural hash (type, constant values and inputs hashes, 0 if node is not scheduled)
+    bool shared;                            // Node structure is shared with other scheduled nodes
     Rectangle shape;                        // Node rectangle data
     Rectangle inputShape;                   // Node input rectangle data (automatically calculated from shape)
     Rectangle outputShape;                  // Node input rectangle data (automatically calculated from shape)
@@ -147,9 +172,18 @@ typedef struct FNodeData {
 
 typedef struct FLineData {
     unsigned int id;                        // Line unique identifier
-    unsigned int from;                      // Id from line start node
-    unsigned int to;                        // Id from line end node
-} FLineData, *FLine;
+    FHandle from;                           // Handle of line start node
+    FHandle to;                             // Handle of line end node (NULL_HANDLE while it is not linked)
+    FLine prevOutput;                       // Previous line linked to start node output (outgoing adjacency list)
+    FLine nextOutput;                       // Next line linked to start node output (outgoing adjacency list)
+} FLineData;
+
+typedef struct FInstruction {
+    FNodeType type;                         // Instruction operation (calculated node type)
+    int inputsCount;                        // Instruction operands count
+    int inputs[MAX_INPUTS];                 // Instruction operands registers (inputs nodes calculation order positions)
+    int source;                             // Register copied instead of executing the instruction (first position with same structure, -1 if it is executed)
+} FInstruction;
 
 typedef struct FCommentData {
     unsigned int id;                        // Comment unique identifier
@@ -166,6 +200,96 @@ typedef struct FCommentData {
     Rectangle sizeBrShape;                  // Comment bottom-right size edit rectangle data
 } FCommentData, *FComment;
 
+// Id allocator (bitset of used ids, released ids are recycled from the lowest one)
+typedef struct FIdAllocator {
+    unsigned int *bits;                     // Used ids bitset (one bit per id)
+    int capacity;                           // Ids capacity
+    int firstFree;                          // Lowest bitset word that may contain a free id
+} FIdAllocator;
+
+// Arena memory chunk (its blocks are stored contiguously after the chunk header)
+typedef struct FArenaChunk {
+    struct FArenaChunk *next;               // Next allocated chunk
+    int used;                               // Number of chunk blocks already handed out
+} FArenaChunk;
+
+// Arena allocator (fixed size blocks from contiguous chunks, released blocks are recycled from a free list)
+typedef struct FArena {
+    FArenaChunk *chunks;                    // Allocated chunks list (first one is the current chunk)
+    int blockSize;                          // Size of every block
+    void *freeBlocks;                       // Released blocks list
+} FArena;
+
+// Nodes graph context (every graph entity, its memory and its edition state)
+typedef struct FNodeContext {
+    int usedMemory;                         // Total used RAM from memory allocation
+
+    int nodesCount;                         // Created nodes count
+    int nodesCapacity;                      // Nodes pool capacity
+    FNode *nodes;                           // Nodes pointers pool
+    int *nodesIndex;                        // Nodes pool index of every node id (-1 if id is not used)
+    unsigned short *nodesGenerations;       // Nodes handle generation of every node id (increased when id is released)
+    bool *nodesDeclared;                    // Nodes declared state of every node id in current shader stage during shader compilation
+    FNode *nodesOrder;                      // Nodes draw order list (creation order, destroyed nodes leave NULL holes until compacted)
+    int nodesOrderCount;                    // Nodes draw order list length (including holes)
+    FNode *nodesSchedule;                   // Nodes calculation order list (topological order, nodes inside cycles at the end)
+    int *nodesPendingInputs;                // Nodes inputs not scheduled yet during schedule build (same index as nodes pool)
+    FInstruction *nodesTape;                // Nodes calculation instructions (same order as nodes calculation order list)
+    FNodeOutput *registers;                 // Nodes calculation output registers (one per instruction, same order as nodes calculation order list)
+    int *nodesEquivalent;                   // First calculation order list position with same structure of every position (same values)
+    int *hashTable;                         // Nodes structural hash table of first positions of every structure (open addressing, -1 if empty, twice nodes capacity)
+    FNode *reachStack;                      // Nodes pending to update its inputs uses count when reachability changes
+    int nodesScheduleCount;                 // Nodes calculation order list length (only nodes reachable from output nodes or pinned)
+    FNode *rankRegion;                      // Nodes whose rank must change to link a line (nodes reached from end node, then nodes reaching start node)
+    int *rankRegionRanks;                   // Ranks shared by rank region nodes, sorted to be given again to them in their new order
+    int nextRank;                           // Rank of next created node (ranks are just compared, destroyed nodes leave gaps)
+    int *levelsPositions;                   // Nodes calculation order list positions grouped by dependency level (FNODE_PARALLEL only)
+    int *levelsEnd;                         // Levels positions list end of every dependency level (nodes of a level do not depend on each other)
+    int levelsCount;                        // Dependency levels count of nodes which do not depend on cycles
+    struct FWorkers *workers;               // Nodes calculation threads pool (FNODE_PARALLEL only, created by first parallel calculation)
+    struct FBatch *batch;                   // Vertices, pixels or time samples batch calculation in progress (NULL while there is none)
+    FNodeAccuracy accuracy;                 // Nodes values calculation math accuracy (exact by default, standard math library results)
+    FNodeAccuracy batchAccuracy;            // Vertices, pixels and time samples batches calculation math accuracy (fast by default)
+    int nodesScheduleAcyclicCount;          // Nodes calculation order list length which does not depend on cycles
+    bool scheduleDirty;                     // Nodes calculation order list needs to be built again due to graph structure changes
+    int scheduleDirtyStart;                 // Nodes calculation order list first position which can contain dirty nodes
+    FIdAllocator nodesIds;                  // Nodes ids allocator
+    FArena nodesArena;                      // Nodes evaluation data memory arena
+    FArena valuesArena;                     // Nodes values shapes and texts memory arena
+    FHandle selectedNode;                   // Current selected node to drag in canvas
+    FHandle editNode;                       // Current edited node data
+    int editNodeType;                       // Current edited node data index
+    char *editNodeText;                     // Current edited node data value text before any changes
+    bool graphDirty;                        // Nodes values need to be calculated again due to graph changes
+    int graphEditDepth;                     // Current nested graph edit transactions count
+
+    int linesCount;                         // Created lines count
+    int linesCapacity;                      // Lines pool capacity
+    FLine *lines;                           // Lines pointers pool
+    int *linesIndex;                        // Lines pool index of every line id (-1 if id is not used)
+    unsigned short *linesGenerations;       // Lines handle generation of every line id (increased when id is released)
+    FIdAllocator linesIds;                  // Lines ids allocator
+    FArena linesArena;                      // Lines memory arena
+    int lineState;                          // Current line linking state (0 = waiting for output to link, 1 = output selected, waiting for input to link)
+    FLine tempLine;                         // Temporally created line during line states
+
+    int commentsCount;                      // Created comments count
+    int commentsCapacity;                   // Comments pool capacity
+    FComment *comments;                     // Comments pointers pool
+    FIdAllocator commentsIds;               // Comments ids allocator
+    FArena commentsArena;                   // Comments and their value text memory arena
+    int commentState;                       // Current comment creation state (0 = waiting to create, 1 = waiting to finish creation)
+    int selectedComment;                    // Current selected comment to drag in canvas
+    int editSize;                           // Current edited comment
+    int editSizeType;                       // Current edited comment size (0 = top, 1 = bottom, 2 = left, 3 = right, 4 = top-left, 5 = top-right, 6 = bottom-left, 7 = bottom-right)
+    int editComment;                        // Current edited comment value
+    FHandle *selectedCommentNodes;          // Current selected comment nodes handles list to drag (sized as nodes pool)
+    int selectedCommentNodesCount;          // Current selected comment nodes handles list count
+    FComment tempComment;                   // Temporally created comment during comment states
+    Vector2 tempCommentPos;                 // Temporally created comment start position
+    Camera2D camera;                        // Node area 2d camera for panning
+} FNodeContext;
+
 #if defined(__cplusplus)
 extern "C" {                                    // Prevents name mangling of functions
 #endif
@@ -178,36 +302,56 @@ extern "C" {                                    // Prevents name mangling of fun
 //------------------------------------------------------------------------------------
 // Module Functions Declaration
 //------------------------------------------------------------------------------------
-FNODEDEF void InitFNode();                                                           // Initializes FNode global variables
+FNODEDEF FNodeContext *InitFNode();                                                  // Initializes FNode OpenGL states and returns its default context
+FNODEDEF FNodeContext *CreateFNodeContext();                                         // Creates an empty nodes graph context
 FNODEDEF void SetBackfaceCulling(bool state);                                        // Set backface culling state in openGL context
-FNODEDEF FNode CreateNodePI();                                                       // Creates a node which returns PI value
-FNODEDEF FNode CreateNodeE();                                                        // Creates a node which returns e value
-FNODEDEF FNode CreateNodeMatrix(Matrix mat);                                         // Creates a matrix 4x4 node (OpenGL style 4x4 - right handed, column major)
-FNODEDEF FNode CreateNodeValue(float value);                                         // Creates a value node (1 float)
-FNODEDEF FNode CreateNodeVector2(Vector2 vector);                                    // Creates a Vector2 node (2 float)
-FNODEDEF FNode CreateNodeVector3(Vector3 vector);                                    // Creates a Vector3 node (3 float)
-FNODEDEF FNode CreateNodeVector4(Vector4 vector);                                    // Creates a Vector4 node (4 float)
-FNODEDEF FNode CreateNodeOperator(FNodeType type, const char *name, int inputs);     // Creates an operator node with type name and inputs limit as parameters
-FNODEDEF FNode CreateNodeUniform(FNodeType type, const char *name, int dataCount);   // Creates an uniform node with type name and data count as parameters
-FNODEDEF FNode CreateNodeProperty(FNodeType type, const char *name, int dataCount, int inputs);  // Creates a property node with type name and data count as parameters
-FNODEDEF FNode CreateNodeMaterial(FNodeType type, const char *name, int dataCount);  // Creates the main node that contains final fragment color
-FNODEDEF FNode InitializeNode(bool isOperator);                                      // Initializes a new node with generic parameters
-FNODEDEF int GetNodeIndex(int id);                                                   // Returns the index of a node searching by its id
-FNODEDEF FLine CreateNodeLine();                                                     // Creates a line between two nodes
-FNODEDEF FComment CreateComment();                                                   // Creates a comment
+FNODEDEF FNode CreateNodePI(FNodeContext *ctx);                                      // Creates a node which returns PI value
+FNODEDEF FNode CreateNodeE(FNodeContext *ctx);                                       // Creates a node which returns e value
+FNODEDEF FNode CreateNodeMatrix(FNodeContext *ctx, Matrix mat);                      // Creates a matrix 4x4 node (OpenGL style 4x4 - right handed, column major)
+FNODEDEF FNode CreateNodeValue(FNodeContext *ctx, float value);                      // Creates a value node (1 float)
+FNODEDEF FNode CreateNodeVector2(FNodeContext *ctx, Vector2 vector);                 // Creates a Vector2 node (2 float)
+FNODEDEF FNode CreateNodeVector3(FNodeContext *ctx, Vector3 vector);                 // Creates a Vector3 node (3 float)
+FNODEDEF FNode CreateNodeVector4(FNodeContext *ctx, Vector4 vector);                 // Creates a Vector4 node (4 float)
+FNODEDEF FNode CreateNodeOperator(FNodeContext *ctx, FNodeType type, const char *name, int inputs);  // Creates an operator node with type name and inputs limit as parameters
+FNODEDEF FNode CreateNodeUniform(FNodeContext *ctx, FNodeType type, const char *name, int dataCount);  // Creates an uniform node with type name and data count as parameters
+FNODEDEF FNode CreateNodeProperty(FNodeContext *ctx, FNodeType type, const char *name, int dataCount, int inputs);  // Creates a property node with type name and data count as parameters
+FNODEDEF FNode CreateNodeMaterial(FNodeContext *ctx, FNodeType type, const char *name, int dataCount);  // Creates the main node that contains final fragment color
+FNODEDEF FNode InitializeNode(FNodeContext *ctx, bool isOperator);                   // Initializes a new node with generic parameters
+FNODEDEF int GetNodeIndex(FNodeContext *ctx, int id);                                // Returns the index of a node searching by its id
+FNODEDEF FHandle GetNodeHandle(FNodeContext *ctx, FNode node);                       // Returns a generation-tagged handle that references a node
+FNODEDEF FNode GetNodeFromHandle(FNodeContext *ctx, FHandle handle);                 // Returns the node referenced by a handle (NULL if it was destroyed)
+FNODEDEF FLine CreateNodeLine(FNodeContext *ctx, int from);                          // Creates a line between two nodes
+FNODEDEF bool LinkNodeLine(FNodeContext *ctx, FLine line, int to);                   // Links a line end to a node input updating nodes adjacency lists (returns false if node inputs are full or it would create a cycle)
+FNODEDEF FHandle GetLineHandle(FNodeContext *ctx, FLine line);                       // Returns a generation-tagged handle that references a line
+FNODEDEF FLine GetLineFromHandle(FNodeContext *ctx, FHandle handle);                 // Returns the line referenced by a handle (NULL if it was destroyed)
+FNODEDEF FComment CreateComment(FNodeContext *ctx);                                  // Creates a comment
 FNODEDEF void AlignNode(FNode node);                                                 // Aligns a node to the nearest grid intersection
 FNODEDEF void UpdateNodeShapes(FNode node);                                          // Updates a node shapes due to drag behaviour
-FNODEDEF void UpdateCommentShapes(FComment comment);                                 // Updates a comment shapes due to drag behaviour
+FNODEDEF void UpdateNodeText(FNode node);                                            // Formats a node values texts and updates its shapes if its values changed since last update
+FNODEDEF void UpdateCommentShapes(FNodeContext *ctx, FComment comment);              // Updates a comment shapes due to drag behaviour
 FNODEDEF Vector2 CameraToViewVector2(Vector2 vector, Camera2D camera);               // Converts Vector2 coordinates from world space to Camera2D space based on its offset
 FNODEDEF Rectangle CameraToViewRec(Rectangle rec, Camera2D camera);                  // Converts rectangle coordinates from world space to Camera2D space based on its offset
-FNODEDEF void CalculateValues();                                                     // Calculates nodes output values based on current inputs
-FNODEDEF void DrawNode(FNode node);                                                  // Draws a previously created node
-FNODEDEF void DrawNodeLine(FLine line);                                              // Draws a previously created node line
-FNODEDEF void DrawComment(FComment comment);                                         // Draws a previously created comment
-FNODEDEF void DestroyNode(FNode node);                                               // Destroys a node and its linked lines
-FNODEDEF void DestroyNodeLine(FLine line);                                           // Destroys a node line
-FNODEDEF void DestroyComment(FComment comment);                                      // Destroys a comment
-FNODEDEF void CloseFNode();                                                          // Unitializes FNode global variables
+FNODEDEF void CalculateValues(FNodeContext *ctx);                                    // Calculates nodes output values based on current inputs
+FNODEDEF void UpdateValues(FNodeContext *ctx);                                       // Calculates dirty nodes and the nodes downstream of them if graph changed
+FNODEDEF void MarkNodeDirty(FNodeContext *ctx, FNode node);                          // Marks a node values to be calculated again in next values update
+FNODEDEF void PinNode(FNodeContext *ctx, FNode node, bool pinned);                   // Sets if a node values are calculated even if output nodes cannot reach it
+FNODEDEF FNode GetEquivalentNode(FNodeContext *ctx, FNode node);                     // Returns first scheduled node with same structure as a node (itself if it is unique or not scheduled)
+FNODEDEF FNode FindNodeByHash(FNodeContext *ctx, unsigned int hash);                 // Returns first scheduled node of a structural hash (NULL if there is no node with that hash)
+FNODEDEF bool CalculateMeshVertices(FNodeContext *ctx, FNode output, Mesh mesh, float time, float *positions);  // Calculates a vertex output node values for every mesh vertex (3 floats per vertex in positions, returns false if not calculated)
+FNODEDEF bool RenderFragmentPixels(FNodeContext *ctx, FNode output, int width, int height, Image *textures, int texturesCount, float time, unsigned char *pixels);  // Renders a fragment output node values for every pixel of a sphere preview image (R8G8B8A8 pixels, discarded pixels are transparent, returns false if not rendered)
+FNODEDEF int CalculateTimeCurves(FNodeContext *ctx, FNode node, const float *times, int count, float *curves);  // Calculates a node values for every time sample and returns its data count (curves needs count*MAX_VALUES floats, one curve per component)
+FNODEDEF void SetCalculationAccuracy(FNodeContext *ctx, FNodeAccuracy values, FNodeAccuracy batches);  // Sets math accuracy of nodes values and of vertices, pixels and time samples batches calculations
+FNODEDEF void BeginGraphEdit(FNodeContext *ctx);                                     // Begins a graph edit transaction (values are not calculated until it ends)
+FNODEDEF void EndGraphEdit(FNodeContext *ctx);                                       // Ends a graph edit transaction and calculates values once if graph changed
+FNODEDEF void DrawNode(FNodeContext *ctx, FNode node);                               // Draws a previously created node
+FNODEDEF void DrawNodeLine(FNodeContext *ctx, FLine line);                           // Draws a previously created node line
+FNODEDEF void DrawComment(FNodeContext *ctx, FComment comment);                      // Draws a previously created comment
+FNODEDEF void DestroyNode(FNodeContext *ctx, FNode node);                            // Destroys a node and its linked lines
+FNODEDEF void DestroyNodeLine(FNodeContext *ctx, FLine line);                        // Destroys a node line
+FNODEDEF void DestroyComment(FNodeContext *ctx, FComment comment);                   // Destroys a comment
+FNODEDEF void ClearFNodeGraph(FNodeContext *ctx);                                    // Destroys all nodes, lines and comments releasing their memory at once
+FNODEDEF void DestroyFNodeContext(FNodeContext *ctx);                                // Destroys a nodes graph context releasing all its memory
+FNODEDEF void CloseFNode();                                                          // Unitializes FNode default context
 FNODEDEF void TraceLogFNode(bool error, const char *text, ...);                      // Outputs a trace log message
 FNODEDEF int FSearch(char *filename, char *string);                                  // Returns 1 if a specific string is found in a text file
 
@@ -233,9 +377,29 @@ FNODEDEF int FSearch(char *filename, char *string);
     #define     FNODE_FREE(ptr)         free(ptr)               // Memory deallocation function as define
 #endif
 
+// Check if float4 lanes kernels can use SSE2 instructions, if not, using scalar ones
+#if !defined(FNODE_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+    #include <emmintrin.h>  // Required for: __m128, _mm_loadu_ps(), _mm_storeu_ps(), _mm_add_ps(), _mm_cmplt_ps()...
+
+    #define     FNODE_SIMD_SSE2                                 // Float4 lanes kernels use SSE2 instructions
+#endif
+
+// Check if large graphs values can be calculated on a threads pool, if not, using caller thread only
+#if defined(FNODE_PARALLEL)
+    #include <pthread.h>    // Required for: pthread_t, pthread_create(), pthread_join(), pthread_mutex_t, pthread_cond_t...
+
+    #if !defined(FNODE_PARALLEL_THREADS)
+        #define FNODE_PARALLEL_THREADS  4                       // Threads which calculate nodes values (including caller thread)
+    #endif
+    #if (FNODE_PARALLEL_THREADS < 2)
+        #error "FNODE_PARALLEL_THREADS must be at least 2"
+    #endif
+#endif
+
 #include <stdio.h>              // Required for: FILE, fopen(), fprintf(), fclose(), fscanf(), stdout, vprintf(), sprintf(), fgets()
-#include <string.h>             // Required for: strcat(), strstr()
-#include <math.h>               // Required for: fabs(), sqrt(), sinf(), cosf(), cos(), sin(), tan(), pow(), floor()
+#include <string.h>             // Required for: strcat(), strstr(), memcpy()
+#include <math.h>               // Required for: fabs(), fabsf(), sqrt(), sinf(), cosf(), cos(), sin(), tan(), pow(), floor(), floorf(), rint(), signbit()
+#include <float.h>              // Required for: FLT_MIN, FLT_MAX
 #include <stdarg.h>             // Required for: va_list, va_start(), vfprintf(), va_end()
 
 #define GLAD_IMPLEMENTATION
@@ -244,12 +408,18 @@ FNODEDEF int FSearch(char *filename, char *string);
 //----------------------------------------------------------------------------------
 // Defines and Macros
 //----------------------------------------------------------------------------------
-#define     MAX_NODES                       128                     // Max number of nodes
+#define     INITIAL_NODES_CAPACITY          128                     // Initial nodes pool capacity (doubles when full)
 #define     MAX_NODE_LENGTH                 16                      // Max node output data value text length
-#define     MAX_LINES                       512                     // Max number of lines (8 lines for each node)
-#define     MAX_COMMENTS                    16                      // Max number of comments
+#define     INITIAL_LINES_CAPACITY          512                     // Initial lines pool capacity (doubles when full)
+#define     INITIAL_COMMENTS_CAPACITY       16                      // Initial comments pool capacity (doubles when full)
 #define     MAX_COMMENT_LENGTH              20                      // Max comment value text length
 #define     MIN_COMMENT_SIZE                75                      // Min comment width and height values
+#define     ARENA_CHUNK_BLOCKS              64                      // Number of blocks of every arena memory chunk
+#define     PARALLEL_MIN_NODES              1024                    // Min scheduled nodes count to calculate values on threads pool (FNODE_PARALLEL only)
+#define     PARALLEL_MIN_LEVEL              64                      // Min dependency level nodes count to share its calculation between threads
+#define     PARALLEL_MIN_ITEMS              4096                    // Min batch vertices, pixels or time samples count to share its calculation between threads (FNODE_PARALLEL only)
+#define     BATCH_LANES                     64                      // Batch vertices, pixels or time samples calculated together by every instruction (multiple of 4)
+#define     FAST_MAX_ANGLE                  8192.0f                 // Max absolute angle reduced by fast accuracy trigonometry (larger angles use exact accuracy)
 #define     NODE_LINE_DIVISIONS             20                      // Node curved line divisions
 #define     NODE_DATA_WIDTH                 30                      // Node data text width
 #define     NODE_DATA_HEIGHT                30                      // Node data text height
@@ -271,38 +441,63 @@ FNODEDEF int FSearch(char *filename, char *string);
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
-// ...
+#if defined(FNODE_PARALLEL)
+// Nodes calculation thread
+typedef struct FWorker {
+    struct FWorkers *pool;                  // Threads pool which owns the thread
+    int index;                              // Thread index to get its share of every job (caller thread is 0)
+    pthread_t thread;                       // Thread handle
+} FWorker;
+
+// Nodes calculation threads pool (caller thread calculates its share too)
+typedef struct FWorkers {
+    FNodeContext *ctx;                      // Context whose nodes values are calculated
+    void (*job)(FNodeContext *ctx, int index);  // Job which every thread runs each time caller thread starts them
+    FWorker threads[FNODE_PARALLEL_THREADS - 1];  // Pool threads
+    pthread_mutex_t mutex;                  // Barrier state mutex
+    pthread_cond_t condition;               // Barrier condition signaled once every thread arrives
+    int arrived;                            // Threads waiting in barrier
+    unsigned int generation;                // Barrier generation (increased every time every thread arrives)
+    bool quit;                              // Pool threads exit once they leave next barrier
+} FWorkers;
+#endif
+
+// Batch calculation items
+typedef enum {
+    BATCH_VERTICES,
+    BATCH_PIXELS,
+    BATCH_TIMES
+} FBatchType;
+
+// Batch calculation (every instruction is calculated for BATCH_LANES vertices, pixels or time samples at once)
+typedef struct FBatch {
+    FBatchType type;                        // Batch items (mesh vertices of a vertex output node, preview pixels of a fragment output node or time samples of any node)
+    int itemsCount;                         // Calculated vertices, pixels or time samples count
+    Mesh mesh;                              // Mesh whose vertices data is bound to vertex nodes (vertices batch)
+    float *positions;                       // Calculated vertices positions (vertices batch, 3 floats per vertex)
+    int width;                              // Preview image width (pixels batch)
+    int height;                             // Preview image height (pixels batch)
+    Image *textures;                        // Images sampled by sampler nodes of every texture unit (pixels batch, R8G8B8A8 format)
+    int texturesCount;                      // Images count
+    unsigned char *pixels;                  // Rendered preview pixels (pixels batch, R8G8B8A8 format)
+    float time;                             // Time value bound to time nodes (first time sample in time samples batch)
+    const float *times;                     // Time value of every time sample (time samples batch)
+    float *curves;                          // Calculated values of every time sample (time samples batch, one curve per component)
+    int outputPosition;                     // Calculation order list position of calculated output node
+    int outputCount;                        // Calculated output node data count (0 if batch could not be calculated)
+    int *offsets;                           // Lanes offset of every calculation order list position (-1 if output node does not depend on it)
+    FNodeOutput *shapes;                    // Output registers calculated for first item (their data counts are the same for every item)
+    int lanesSize;                          // Lanes floats count of every thread (components stored one after another, BATCH_LANES floats per component)
+    float *lanes;                           // Lanes of every thread (structure of arrays)
+    FNodeOutput *registers;                 // Output registers of every thread for instructions calculated one item at a time
+    int threadsCount;                       // Threads sharing batch calculation
+} FBatch;
 
 //------------------------------------------------------------------------------------
 // Global Variables Definition
 //------------------------------------------------------------------------------------
-int usedMemory = 0;                         // Total used RAM from memory allocation
-
-int nodesCount = 0;                         // Created nodes count
-FNode nodes[MAX_NODES];                     // Nodes pointers pool
-int selectedNode = -1;                      // Current selected node to drag in canvas
-int editNode = -1;                          // Current edited node data
-int editNodeType = -1;                      // Current edited node data index
-char *editNodeText = NULL;                  // Current edited node data value text before any changes
-
-int linesCount = 0;                         // Created lines count
-FLine lines[MAX_LINES];                     // Lines pointers pool
-int lineState = 0;                          // Current line linking state (0 = waiting for output to link, 1 = output selected, waiting for input to link)
-FLine tempLine = NULL;                      // Temporally created line during line states
-
-int commentsCount = 0;                      // Created comments count
-FComment comments[MAX_COMMENTS];            // Comments pointers pool
-int commentState = 0;                       // Current comment creation state (0 = waiting to create, 1 = waiting to finish creation)
-int selectedComment = -1;                   // Current selected comment to drag in canvas
-int editSize = -1;                          // Current edited comment
-int editSizeType = -1;                      // Current edited comment size (0 = top, 1 = bottom, 2 = left, 3 = right, 4 = top-left, 5 = top-right, 6 = bottom-left, 7 = bottom-right)
-int editComment = -1;                       // Current edited comment value
-int selectedCommentNodes[MAX_NODES];        // Current selected comment nodes ids list to drag
-int selectedCommentNodesCount;              // Current selected comment nodes ids list count
-FComment tempComment = NULL;                // Temporally created comment during comment states
-Vector2 tempCommentPos = { 0, 0 };          // Temporally created comment start position
+FNodeContext *defaultContext = NULL;        // Default context created by InitFNode()
 Vector2 screenSize = { 1280, 800 };         // Window screen width
-Camera2D camera;                            // Node area 2d camera for panning
 Camera camera3d;                            // Visor camera 3d for model and shader visualization
 bool debugMode = false;                     // Drawing debug information state
 int menuOffset = 0;                         // Interface elements position current offset
@@ -311,6 +506,45 @@ bool interact = true;                       // Buttons and text can interact sta
 //------------------------------------------------------------------------------------
 // Module Internal Functions Declaration
 //------------------------------------------------------------------------------------
+static void InitIdAllocator(FNodeContext *ctx, FIdAllocator *allocator, int capacity);  // Initializes an id allocator with an ids capacity
+static int AllocateId(FIdAllocator *allocator);                            // Returns the lowest free id of an id allocator (-1 if there is any available id)
+static void ReleaseId(FIdAllocator *allocator, int id);                    // Releases an id to be recycled by an id allocator
+static void GrowIdAllocator(FNodeContext *ctx, FIdAllocator *allocator, int capacity);  // Increases the ids capacity of an id allocator
+static void ResetIdAllocator(FIdAllocator *allocator);                     // Releases all the ids of an id allocator
+static void CloseIdAllocator(FNodeContext *ctx, FIdAllocator *allocator);  // Unitializes an id allocator
+static void *FResizeArray(FNodeContext *ctx, void *array, int size, int newSize);  // Returns a new allocated array with the content of an array, which is released
+static void GrowNodesPool(FNodeContext *ctx);                              // Doubles the nodes pool capacity
+static void CompactNodesOrder(FNodeContext *ctx);                          // Removes destroyed nodes holes from nodes draw order list
+static void AddNodeUse(FNodeContext *ctx, FNode node);                     // Increases a node uses count making its inputs reachable if it was unused
+static void ReleaseNodeUse(FNodeContext *ctx, FNode node);                 // Decreases a node uses count making its inputs unreachable if it becomes unused
+static bool RankNodesLink(FNodeContext *ctx, FNode fromNode, FNode toNode);  // Updates nodes ranks to link two nodes and returns false if the link creates a cycle
+static void SortNodesByRank(FNode *nodes, int count);                      // Sorts a nodes list by their ranks (heap sort)
+static void BuildNodesSchedule(FNodeContext *ctx);                         // Sorts nodes topologically into the nodes calculation order list and builds the nodes tape from it
+static void ShareNodeStructure(FNodeContext *ctx, int position);           // Hashes a scheduled node structure and links it to the first scheduled node with same structure
+static bool CompareNodesStructure(FNodeContext *ctx, int positionA, int positionB);  // Returns true if two scheduled nodes have same structure
+static bool CalculateNodeValues(FNodeContext *ctx, int position);          // Calculates a scheduled node output values and returns if they changed
+static bool ExecuteInstruction(FNodeContext *ctx, FNodeOutput *registers, int position);  // Executes a nodes tape instruction over a registers file and returns if its output register changed
+static bool CalculateBatch(FNodeContext *ctx, FBatch *batch, FNode output);  // Calculates an output node values for every batch vertex, pixel or time sample (returns false if not calculated)
+static void CalculateBatchShare(FNodeContext *ctx, int index);             // Calculates a thread share of current batch chunks
+static bool LoadBatchLanes(FNodeContext *ctx, float *lanes, int position, int first, int count, bool *discarded);  // Loads vertices, pixels or time samples data bound to a node into its lanes and returns false if node is not bound
+static bool ExecuteLanesInstruction(FNodeContext *ctx, float *lanes, int position);  // Executes a nodes tape instruction over every lane and returns false if it has no lanes kernel
+static bool CheckLanesTransform(FNodeContext *ctx, int position, int input);  // Returns true if a multiply instruction transforms its vector lanes by a constant matrix input
+static Vector4 FImageBilinear(Image image, float u, float v);              // Returns an image color at texture coordinates with bilinear filtering and repeat wrapping
+#if defined(FNODE_PARALLEL)
+static void BuildNodesLevels(FNodeContext *ctx);                           // Groups scheduled nodes which do not depend on cycles by dependency level
+static FWorkers *CreateWorkers(FNodeContext *ctx);                         // Creates a nodes calculation threads pool
+static void DestroyWorkers(FNodeContext *ctx, FWorkers *pool);             // Stops and destroys a nodes calculation threads pool
+static void WaitWorkers(FWorkers *pool);                                   // Waits until every threads pool thread (and caller thread) arrives
+static void CalculateLevels(FNodeContext *ctx, int index);                 // Calculates a thread share of every dependency level nodes values
+static void *WorkerThread(void *data);                                     // Threads pool thread loop, runs pool job every time caller thread starts
+#endif
+static void GrowLinesPool(FNodeContext *ctx);                              // Doubles the lines pool capacity
+static void GrowCommentsPool(FNodeContext *ctx);                           // Doubles the comments pool capacity
+static void *ArenaAlloc(FNodeContext *ctx, FArena *arena);                 // Returns a block from an arena allocator
+static void ArenaFree(FArena *arena, void *block);                         // Releases a block to be recycled by an arena allocator
+static void ResetArena(FNodeContext *ctx, FArena *arena);                  // Releases all the chunks of an arena allocator at once
+static void UnlinkNodeLine(FNodeContext *ctx, FLine line);                 // Removes a linked line from nodes adjacency lists
+static unsigned short NextHandleGeneration(unsigned short generation);     // Returns the generation of a released id handles (never 0)
 static float FVector2Length(Vector2 v);                                    // Returns length of a Vector2
 static float FVector3Length(Vector3 v);                                    // Returns length of a Vector3
 static float FVector4Length(Vector4 v);                                    // Returns length of a Vector4
@@ -328,17 +562,23 @@ static Vector3 FVector3Rejection(Vector3 a, Vector3 b);                    // Re
 static Vector4 FVector4Rejection(Vector4 a, Vector4 b);                    // Returns the rejection vector of two Vector4
 static Vector3 FCrossProduct(Vector3 a, Vector3 b);                        // Returns the cross product of two vectors
 static Matrix FMatrixIdentity();                                           // Returns identity matrix
-static Matrix FMatrixMultiply(Matrix left, Matrix right);                  // Returns the result of multiply two matrices
+static void FMatrixMultiply(Matrix *result, const Matrix *left, const Matrix *right);  // Sets result as the multiplication of two matrices
 static Matrix FMatrixTranslate(float x, float y, float z);                 // Returns translation matrix
 static Matrix FMatrixRotate(Vector3 axis, float angle);                    // Create rotation matrix from axis and angle provided in radians
 static Matrix FMatrixScale(float x, float y, float z);                     // Returns scaling matrix
 static void FMatrixTranspose(Matrix *mat);                                 // Transposes provided matrix
-static void FMultiplyMatrixVector(Vector4 *v, Matrix mat);                 // Transform a quaternion given a transformation matrix
+static void FMultiplyMatrixVector(Vector4 *v, const Matrix *mat);          // Transform a quaternion given a transformation matrix
 static float FCos(float value);                                            // Returns the cosine value of a radian angle
 static float FSin(float value);                                            // Returns the sine value of a radian angle
 static float FTan(float value);                                            // Returns the tangent value of a radian angle
 static float FPower(float value, float exp);                               // Returns a value to the power of an exponent
 static float FSquareRoot(float value);                                     // Returns the square root of the input value
+static float FReduceAngle(float value, int *quadrant);                     // Returns a radian angle reduced to [-PI/4, PI/4] and its PI/2 quadrant
+static float FFastSinCos(float value, int quadrant);                       // Returns the sine (quadrant 0) or cosine (quadrant 1) of a radian angle (fast accuracy)
+static float FFastTan(float value);                                        // Returns the tangent value of a radian angle (fast accuracy)
+static float FFastExp2(float value);                                       // Returns two to the power of a value (fast accuracy)
+static float FFastLog2(float value);                                       // Returns the base two logarithm of a positive normal value (fast accuracy)
+static float FFastPower(float value, float exp);                           // Returns a value to the power of an exponent (fast accuracy)
 static float FPosterize(float value, float samples);                       // Returns a value rounded based on the samples
 static float FClamp(float value, float min, float max);                    // Returns a value clamped by a min and max values
 static float FTrunc(float value);                                          // Returns a truncated value of a value
@@ -349,6 +589,31 @@ static Vector2 FVector2Lerp(Vector2 valueA, Vector2 valueB, float time);   // Re
 static Vector3 FVector3Lerp(Vector3 valueA, Vector3 valueB, float time);   // Returns the interpolation between two Vector3 values
 static Vector4 FVector4Lerp(Vector4 valueA, Vector4 valueB, float time);   // Returns the interpolation between two Vector4 values
 static float FSmoothStep(float min, float max, float value);               // Returns the interpolate of a value in a range
+static void FLanesAdd(float *a, const float *b, int count);               // Adds b values to a values (float4 lanes kernel)
+static void FLanesSubtract(float *a, const float *b, int count);          // Subtracts b values from a values (float4 lanes kernel)
+static void FLanesMultiply(float *a, const float *b, int count);          // Multiplies a values by b values (float4 lanes kernel)
+static void FLanesDivide(float *a, const float *b, int count);            // Divides a values by b values (float4 lanes kernel)
+static void FLanesScale(float *a, float value, int count);                // Multiplies a values by a value (float4 lanes kernel)
+static void FLanesDivideValue(float *a, float value, int count);          // Divides a values by a value (float4 lanes kernel)
+static void FLanesOneMinus(float *a, int count);                          // Subtracts a values from one (float4 lanes kernel)
+static void FLanesReciprocal(float *a, int count);                        // Divides one by a values (float4 lanes kernel)
+static void FLanesAbs(float *a, int count);                               // Negates negative a values (float4 lanes kernel)
+static void FLanesSquareRoot(float *a, int count);                        // Returns the square root of a values (float4 lanes kernel)
+static void FLanesClamp(float *a, float min, float max, int count);       // Clamps a values by a min and max values (float4 lanes kernel)
+static void FLanesMax(float *a, const float *b, int count);               // Replaces a values by greater b values (float4 lanes kernel)
+static void FLanesMin(float *a, const float *b, int count);               // Replaces a values by lower b values (float4 lanes kernel)
+static void FLanesLerp(float *output, const float *a, const float *b, float time, int count);  // Returns the interpolation between a and b values (float4 lanes kernel)
+static void FLanesSmoothStep(float *output, const float *min, const float *max, const float *value, int count);  // Returns the interpolate of values in ranges (float4 lanes kernel)
+static void FLanesTransform(float *lanes, int stride, const Matrix *mat, int count);  // Transforms components lanes vectors by a matrix (float4 lanes kernel)
+static void FLanesSinCos(float *a, int quadrant, int count);              // Returns the sine (quadrant 0) or cosine (quadrant 1) of a values (float4 lanes kernel, fast accuracy)
+static void FLanesTan(float *a, int count);                               // Returns the tangent of a values (float4 lanes kernel, fast accuracy)
+static void FLanesExp2(float *a, int count);                              // Returns two to the power of a values (float4 lanes kernel, fast accuracy)
+#if defined(FNODE_SIMD_SSE2)
+static void FLanesStore(float *lanes, __m128 values, int count);          // Stores the first count values of a float4 register keeping the rest lanes unchanged
+static __m128 FLanesSelect(__m128 mask, __m128 a, __m128 b);              // Returns a lanes where mask is set and b lanes elsewhere
+static __m128 FLanesFloor(__m128 values);                                 // Returns the largest integers not greater than values (absolute values lower than 2^31)
+static __m128 FLanesReduceAngle(__m128 values, __m128i *quadrant);        // Returns radian angles reduced to [-PI/4, PI/4] and their PI/2 quadrants
+#endif
 static float FEaseLinear(float t, float b, float c, float d);              // Returns an ease linear value between two parameters 
 static float FEaseInOutQuad(float t, float b, float c, float d);           // Returns an ease quadratic in-out value between two parameters
 
@@ -358,21 +623,48 @@ static void FFloatToString(char *buffer, float value);                     // Se
 //------------------------------------------------------------------------------------
 // Module Functions Definition
 //------------------------------------------------------------------------------------
-// Initializes FNode global variables
-FNODEDEF void InitFNode()
+// Initializes FNode OpenGL states and returns its default context
+FNODEDEF FNodeContext *InitFNode()
 {
-    nodesCount = 0;
-    linesCount = 0;
-    commentsCount = 0;
-    selectedCommentNodesCount = 0;
-    for (int i = 0; i < MAX_NODES; i++) selectedCommentNodes[i] = -1;
-
     gladLoadGLLoader((GLADloadproc)glfwGetProcAddress);
 
     // Initialize OpenGL states
     SetBackfaceCulling(false);
 
+    if (defaultContext == NULL) defaultContext = CreateFNodeContext();
+
     TraceLogFNode(false, "initialization complete");
+
+    return defaultContext;
+}
+
+// Creates an empty nodes graph context
+FNODEDEF FNodeContext *CreateFNodeContext()
+{
+    FNodeContext *ctx = (FNodeContext *)FNODE_MALLOC(sizeof(FNodeContext));
+    if (ctx == NULL) TraceLogFNode(true, "error trying to allocate a nodes graph context");
+
+    memset(ctx, 0, sizeof(FNodeContext));
+
+    ctx->nodesArena.blockSize = sizeof(FNodeData);
+    ctx->valuesArena.blockSize = MAX_VALUES*(sizeof(FNodeValue) + MAX_NODE_LENGTH);
+    ctx->linesArena.blockSize = sizeof(FLineData);
+    ctx->commentsArena.blockSize = sizeof(FCommentData) + MAX_COMMENT_LENGTH;
+    ctx->editNodeType = -1;
+    ctx->selectedComment = -1;
+    ctx->editSize = -1;
+    ctx->editSizeType = -1;
+    ctx->editComment = -1;
+    ctx->camera.zoom = 1.0f;
+    ctx->accuracy = FNODE_ACCURACY_EXACT;
+    ctx->batchAccuracy = FNODE_ACCURACY_FAST;
+
+    // Initialize entities pools with their initial capacity
+    GrowNodesPool(ctx);
+    GrowLinesPool(ctx);
+    GrowCommentsPool(ctx);
+
+    return ctx;
 }
 
 // Set backface culling state in openGL context
@@ -383,15 +675,15 @@ FNODEDEF void SetBackfaceCulling(bool state)
 }
 
 // Creates a node which returns PI value
-FNODEDEF FNode CreateNodePI()
+FNODEDEF FNode CreateNodePI(FNodeContext *ctx)
 {
-    FNode newNode = InitializeNode(false);
+    FNode newNode = InitializeNode(ctx, false);
 
     newNode->type = FNODE_PI;
     newNode->name = "PI";
     newNode->output.dataCount = 1;
-    newNode->output.data[0].value = PI;
-    FFloatToString(newNode->output.data[0].valueText, newNode->output.data[0].value);
+    newNode->output.data[0] = PI;
+    FFloatToString(newNode->values[0].valueText, newNode->output.data[0]);
     newNode->inputsLimit = 0;
 
     UpdateNodeShapes(newNode);
@@ -400,15 +692,15 @@ FNODEDEF FNode CreateNodePI()
 }
 
 // Creates a node which returns e value
-FNODEDEF FNode CreateNodeE()
+FNODEDEF FNode CreateNodeE(FNodeContext *ctx)
 {
-    FNode newNode = InitializeNode(false);
+    FNode newNode = InitializeNode(ctx, false);
 
     newNode->type = FNODE_E;
     newNode->name = "e";
     newNode->output.dataCount = 1;
-    newNode->output.data[0].value = 2.71828182845904523536;
-    FFloatToString(newNode->output.data[0].valueText, newNode->output.data[0].value);
+    newNode->output.data[0] = 2.71828182845904523536;
+    FFloatToString(newNode->values[0].valueText, newNode->output.data[0]);
     newNode->inputsLimit = 0;
 
     UpdateNodeShapes(newNode);
@@ -417,30 +709,30 @@ FNODEDEF FNode CreateNodeE()
 }
 
 // Creates a matrix 4x4 node (OpenGL style 4x4 - right handed, column major)
-FNODEDEF FNode CreateNodeMatrix(Matrix mat)
+FNODEDEF FNode CreateNodeMatrix(FNodeContext *ctx, Matrix mat)
 {
-    FNode newNode = InitializeNode(false);
+    FNode newNode = InitializeNode(ctx, false);
 
     newNode->type = FNODE_MATRIX;
     newNode->name = "Matrix (4x4)";
     newNode->output.dataCount = 16;
-    newNode->output.data[0].value = mat.m0;
-    newNode->output.data[1].value = mat.m1;
-    newNode->output.data[2].value = mat.m2;
-    newNode->output.data[3].value = mat.m3;
-    newNode->output.data[4].value = mat.m4;
-    newNode->output.data[5].value = mat.m5;
-    newNode->output.data[6].value = mat.m6;
-    newNode->output.data[7].value = mat.m7;
-    newNode->output.data[8].value = mat.m8;
-    newNode->output.data[9].value = mat.m9;
-    newNode->output.data[10].value = mat.m10;
-    newNode->output.data[11].value = mat.m11;
-    newNode->output.data[12].value = mat.m12;
-    newNode->output.data[13].value = mat.m13;
-    newNode->output.data[14].value = mat.m14;
-    newNode->output.data[15].value = mat.m15;
-    for (int i = 0; i < newNode->output.dataCount; i++) FFloatToString(newNode->output.data[i].valueText, newNode->output.data[i].value);
+    newNode->output.data[0] = mat.m0;
+    newNode->output.data[1] = mat.m1;
+    newNode->output.data[2] = mat.m2;
+    newNode->output.data[3] = mat.m3;
+    newNode->output.data[4] = mat.m4;
+    newNode->output.data[5] = mat.m5;
+    newNode->output.data[6] = mat.m6;
+    newNode->output.data[7] = mat.m7;
+    newNode->output.data[8] = mat.m8;
+    newNode->output.data[9] = mat.m9;
+    newNode->output.data[10] = mat.m10;
+    newNode->output.data[11] = mat.m11;
+    newNode->output.data[12] = mat.m12;
+    newNode->output.data[13] = mat.m13;
+    newNode->output.data[14] = mat.m14;
+    newNode->output.data[15] = mat.m15;
+    for (int i = 0; i < newNode->output.dataCount; i++) FFloatToString(newNode->values[i].valueText, newNode->output.data[i]);
     newNode->shape.height = (NODE_DATA_HEIGHT + 5)*newNode->output.dataCount + 5;
     newNode->inputsLimit = 0;
 
@@ -450,15 +742,15 @@ FNODEDEF FNode CreateNodeMatrix(Matrix mat)
 }
 
 // Creates a value node (1 float)
-FNODEDEF FNode CreateNodeValue(float value)
+FNODEDEF FNode CreateNodeValue(FNodeContext *ctx, float value)
 {
-    FNode newNode = InitializeNode(false);
+    FNode newNode = InitializeNode(ctx, false);
 
     newNode->type = FNODE_VALUE;
     newNode->name = "Value";
     newNode->output.dataCount = 1;
-    newNode->output.data[0].value = value;
-    FFloatToString(newNode->output.data[0].valueText, newNode->output.data[0].value);
+    newNode->output.data[0] = value;
+    FFloatToString(newNode->values[0].valueText, newNode->output.data[0]);
     newNode->inputsLimit = 0;
 
     UpdateNodeShapes(newNode);
@@ -467,16 +759,16 @@ FNODEDEF FNode CreateNodeValue(float value)
 }
 
 // Creates a Vector2 node (2 float)
-FNODEDEF FNode CreateNodeVector2(Vector2 vector)
+FNODEDEF FNode CreateNodeVector2(FNodeContext *ctx, Vector2 vector)
 {
-    FNode newNode = InitializeNode(false);
+    FNode newNode = InitializeNode(ctx, false);
 
     newNode->type = FNODE_VECTOR2;
     newNode->name = "Vector 2";
     newNode->output.dataCount = 2;
-    newNode->output.data[0].value = vector.x;
-    newNode->output.data[1].value = vector.y;
-    for (int i = 0; i < newNode->output.dataCount; i++) FFloatToString(newNode->output.data[i].valueText, newNode->output.data[i].value);
+    newNode->output.data[0] = vector.x;
+    newNode->output.data[1] = vector.y;
+    for (int i = 0; i < newNode->output.dataCount; i++) FFloatToString(newNode->values[i].valueText, newNode->output.data[i]);
     newNode->shape.height = (NODE_DATA_HEIGHT + 5)*newNode->output.dataCount + 5;
     newNode->inputsLimit = 0;
 
@@ -486,17 +778,17 @@ FNODEDEF FNode CreateNodeVector2(Vector2 vector)
 }
 
 // Creates a Vector3 node (3 float)
-FNODEDEF FNode CreateNodeVector3(Vector3 vector)
+FNODEDEF FNode CreateNodeVector3(FNodeContext *ctx, Vector3 vector)
 {
-    FNode newNode = InitializeNode(false);
+    FNode newNode = InitializeNode(ctx, false);
 
     newNode->type = FNODE_VECTOR3;
     newNode->name = "Vector 3";
     newNode->output.dataCount = 3;
-    newNode->output.data[0].value = vector.x;
-    newNode->output.data[1].value = vector.y;
-    newNode->output.data[2].value = vector.z;
-    for (int i = 0; i < newNode->output.dataCount; i++) FFloatToString(newNode->output.data[i].valueText, newNode->output.data[i].value);
+    newNode->output.data[0] = vector.x;
+    newNode->output.data[1] = vector.y;
+    newNode->output.data[2] = vector.z;
+    for (int i = 0; i < newNode->output.dataCount; i++) FFloatToString(newNode->values[i].valueText, newNode->output.data[i]);
     newNode->shape.height = (NODE_DATA_HEIGHT + 5)*newNode->output.dataCount + 5;
     newNode->inputsLimit = 0;
 
@@ -506,18 +798,18 @@ FNODEDEF FNode CreateNodeVector3(Vector3 vector)
 }
 
 // Creates a Vector4 node (4 float)
-FNODEDEF FNode CreateNodeVector4(Vector4 vector)
+FNODEDEF FNode CreateNodeVector4(FNodeContext *ctx, Vector4 vector)
 {
-    FNode newNode = InitializeNode(false);
+    FNode newNode = InitializeNode(ctx, false);
 
     newNode->type = FNODE_VECTOR4;
     newNode->name = "Vector 4";
     newNode->output.dataCount = 4;
-    newNode->output.data[0].value = vector.x;
-    newNode->output.data[1].value = vector.y;
-    newNode->output.data[2].value = vector.z;
-    newNode->output.data[3].value = vector.w;
-    for (int i = 0; i < newNode->output.dataCount; i++) FFloatToString(newNode->output.data[i].valueText, newNode->output.data[i].value);
+    newNode->output.data[0] = vector.x;
+    newNode->output.data[1] = vector.y;
+    newNode->output.data[2] = vector.z;
+    newNode->output.data[3] = vector.w;
+    for (int i = 0; i < newNode->output.dataCount; i++) FFloatToString(newNode->values[i].valueText, newNode->output.data[i]);
     newNode->shape.height = (NODE_DATA_HEIGHT + 5)*newNode->output.dataCount + 5;
     newNode->inputsLimit = 0;
 
@@ -527,9 +819,9 @@ FNODEDEF FNode CreateNodeVector4(Vector4 vector)
 }
 
 // Creates an operator node with type name and inputs limit as parameters
-FNODEDEF FNode CreateNodeOperator(FNodeType type, const char *name, int inputs)
+FNODEDEF FNode CreateNodeOperator(FNodeContext *ctx, FNodeType type, const char *name, int inputs)
 {
-    FNode newNode = InitializeNode(true);
+    FNode newNode = InitializeNode(ctx, true);
 
     newNode->type = type;
     newNode->name = name;
@@ -541,9 +833,9 @@ FNODEDEF FNode CreateNodeOperator(FNodeType type, const char *name, int inputs)
 }
 
 // Creates an uniform node with type name and data count as parameters
-FNODEDEF FNode CreateNodeUniform(FNodeType type, const char *name, int dataCount)
+FNODEDEF FNode CreateNodeUniform(FNodeContext *ctx, FNodeType type, const char *name, int dataCount)
 {
-    FNode newNode = InitializeNode(false);
+    FNode newNode = InitializeNode(ctx, false);
 
     newNode->type = type;
     newNode->name = name;
@@ -555,9 +847,9 @@ FNODEDEF FNode CreateNodeUniform(FNodeType type, const char *name, int dataCount
 }
 
 // Creates a property node with type name and data count as parameters
-FNODEDEF FNode CreateNodeProperty(FNodeType type, const char *name, int dataCount, int inputs)
+FNODEDEF FNode CreateNodeProperty(FNodeContext *ctx, FNodeType type, const char *name, int dataCount, int inputs)
 {
-    FNode newNode = InitializeNode((inputs > 0));
+    FNode newNode = InitializeNode(ctx, (inputs > 0));
 
     newNode->type = type;
     newNode->name = name;
@@ -571,9 +863,9 @@ FNODEDEF FNode CreateNodeProperty(FNodeType type, const char *name, int dataCoun
 }
 
 // Creates the main node that contains final material attributes
-FNODEDEF FNode CreateNodeMaterial(FNodeType type, const char *name, int dataCount)
+FNODEDEF FNode CreateNodeMaterial(FNodeContext *ctx, FNodeType type, const char *name, int dataCount)
 {
-    FNode newNode = InitializeNode(true);
+    FNode newNode = InitializeNode(ctx, true);
 
     newNode->type = type;
     newNode->name = name;
@@ -581,176 +873,241 @@ FNODEDEF FNode CreateNodeMaterial(FNodeType type, const char *name, int dataCoun
     newNode->outputShape.width = 0;
     newNode->outputShape.height = 0;
 
+    // Output nodes are always used, every node they can reach is calculated
+    AddNodeUse(ctx, newNode);
+
     UpdateNodeShapes(newNode);
 
     return newNode;
 }
 
 // Initializes a new node with generic parameters
-FNODEDEF FNode InitializeNode(bool isOperator)
+FNODEDEF FNode InitializeNode(FNodeContext *ctx, bool isOperator)
 {
-    FNode newNode = (FNode)FNODE_MALLOC(sizeof(FNodeData));
-    usedMemory += sizeof(FNodeData);
+    if (ctx->nodesCount == ctx->nodesCapacity) GrowNodesPool(ctx);
 
-    int id = -1;
-    for (int i = 0; i < MAX_NODES; i++)
-    {
-        int currentId = i;
-
-        // Check if current id already exist in other node
-        for (int k = 0; k < nodesCount; k++)
-        {
-            if (nodes[k]->id == currentId)
-            {
-                currentId++;
-                break;
-            }
-        }
+    FNode newNode = (FNode)ArenaAlloc(ctx, &ctx->nodesArena);
+    newNode->values = (FNodeValue *)ArenaAlloc(ctx, &ctx->valuesArena);
+    char *valuesText = (char *)(newNode->values + MAX_VALUES);
 
-        // If not exist, set it as new node id
-        if (currentId == i)
-        {
-            id = i;
-            break;
-        }
-    }
+    int id = AllocateId(&ctx->nodesIds);
 
     // Initialize node id
     if (id != -1) newNode->id = id;
     else TraceLogFNode(true, "node creation failed because there is any available id");
 
     // Initialize node inputs and inputs count
-    for (int i = 0; i < MAX_INPUTS; i++) newNode->inputs[i] = -1;
+    for (int i = 0; i < MAX_INPUTS; i++)
+    {
+        newNode->inputs[i] = -1;
+        newNode->inputLines[i] = NULL;
+    }
+
     newNode->inputsCount = 0;
     newNode->inputsLimit = MAX_INPUTS;
     newNode->property = false;
+    newNode->outputLines = NULL;
+    newNode->outputsCount = 0;
 
     // Initialize shapes
-    newNode->shape = (Rectangle){ GetRandomValue(-camera.offset.x + 0, -camera.offset.x + screenSize.x*0.85f - 50*4), GetRandomValue(-camera.offset.y + screenSize.y/2 - 20 - 100, camera.offset.y + screenSize.y/2 - 20 + 100), 10 + NODE_DATA_WIDTH, 40 };
+    newNode->shape = (Rectangle){ GetRandomValue(-ctx->camera.offset.x + 0, -ctx->camera.offset.x + screenSize.x*0.85f - 50*4), GetRandomValue(-ctx->camera.offset.y + screenSize.y/2 - 20 - 100, ctx->camera.offset.y + screenSize.y/2 - 20 + 100), 10 + NODE_DATA_WIDTH, 40 };
     if (isOperator) newNode->inputShape = (Rectangle){ 0, 0, 20, 20 };
     else newNode->inputShape = (Rectangle){ 0, 0, 0, 0 };
     newNode->outputShape = (Rectangle){ 0, 0, 20, 20 };
 
     // Initialize node output and output values count
     newNode->output.dataCount = 0;
+    newNode->scheduleIndex = -1;
+    newNode->dirty = false;
+    newNode->usesCount = 0;
+    newNode->pinned = false;
+    newNode->rank = ctx->nextRank++;
+    newNode->visited = false;
+    newNode->hash = 0;
+    newNode->shared = false;
+    newNode->textDirty = false;
 
     for (int i = 0; i < MAX_VALUES; i++)
     {
-        newNode->output.data[i].value = 0.0f;
-        newNode->output.data[i].shape = (Rectangle){ 0, 0, NODE_DATA_WIDTH, NODE_DATA_HEIGHT };
-        newNode->output.data[i].valueText = (char *)FNODE_MALLOC(MAX_NODE_LENGTH);
-        usedMemory += MAX_NODE_LENGTH;
-        for (int k = 0; k < MAX_NODE_LENGTH; k++) newNode->output.data[i].valueText[k] = '\0';
+        newNode->output.data[i] = 0.0f;
+        newNode->values[i].shape = (Rectangle){ 0, 0, NODE_DATA_WIDTH, NODE_DATA_HEIGHT };
+        newNode->values[i].valueText = valuesText + i*MAX_NODE_LENGTH;
+        for (int k = 0; k < MAX_NODE_LENGTH; k++) newNode->values[i].valueText[k] = '\0';
     }
 
-    nodes[nodesCount] = newNode;
-    nodesCount++;
+    ctx->nodes[ctx->nodesCount] = newNode;
+    ctx->nodesIndex[newNode->id] = ctx->nodesCount;
+    ctx->nodesCount++;
+
+    // Draw order list has room for twice the pool capacity, so holes are compacted at most once every capacity destroys
+    if (ctx->nodesOrderCount == 2*ctx->nodesCapacity) CompactNodesOrder(ctx);
+    newNode->drawIndex = ctx->nodesOrderCount;
+    ctx->nodesOrder[ctx->nodesOrderCount] = newNode;
+    ctx->nodesOrderCount++;
+    ctx->scheduleDirty = true;
+    MarkNodeDirty(ctx, newNode);
 
-    TraceLogFNode(false, "created new node id %i (index: %i) [USED RAM: %i bytes]", newNode->id, (nodesCount - 1), usedMemory);
+    TraceLogFNode(false, "created new node id %i (index: %i) [USED RAM: %i bytes]", newNode->id, (ctx->nodesCount - 1), ctx->usedMemory);
 
     return newNode;
 }
 
 // Returns the index of a node searching by its id
-FNODEDEF int GetNodeIndex(int id)
+FNODEDEF int GetNodeIndex(FNodeContext *ctx, int id)
 {
     int output = -1;
 
-    for (int i = 0; i < nodesCount; i++)
-    {
-        if (nodes[i]->id == id)
-        {
-            output = i;
-            break;
-        }
-    }
+    if ((id >= 0) && (id < ctx->nodesCapacity)) output = ctx->nodesIndex[id];
 
     if (output == -1) TraceLogFNode(true, "error when trying to find a node index by its id");
 
     return output;
 }
 
-// Creates a line between two nodes
-FNODEDEF FLine CreateNodeLine(int from)
+// Returns a generation-tagged handle that references a node
+FNODEDEF FHandle GetNodeHandle(FNodeContext *ctx, FNode node)
 {
-    FLine newLine = (FLine)FNODE_MALLOC(sizeof(FLineData));
-    usedMemory += sizeof(FLineData);
+    FHandle handle = NULL_HANDLE;
 
-    int id = -1;
-    for (int i = 0; i < MAX_LINES; i++)
-    {
-        int currentId = i;
+    if (node != NULL) handle = ((FHandle)ctx->nodesGenerations[node->id] << HANDLE_INDEX_BITS) | node->id;
 
-        // Check if current id already exist in other line
-        for (int k = 0; k < linesCount; k++)
-        {
-            if (lines[k]->id == currentId)
-            {
-                currentId++;
-                break;
-            }
-        }
+    return handle;
+}
 
-        // If not exist, set it as new line id
-        if (currentId == i)
-        {
-            id = i;
-            break;
-        }
+// Returns the node referenced by a handle (NULL if it was destroyed)
+FNODEDEF FNode GetNodeFromHandle(FNodeContext *ctx, FHandle handle)
+{
+    FNode node = NULL;
+    int id = (int)(handle & HANDLE_INDEX_MASK);
+
+    if ((handle != NULL_HANDLE) && (id < ctx->nodesCapacity) && (ctx->nodesGenerations[id] == (handle >> HANDLE_INDEX_BITS)) && (ctx->nodesIndex[id] != -1))
+    {
+        node = ctx->nodes[ctx->nodesIndex[id]];
     }
 
+    return node;
+}
+
+// Creates a line between two nodes
+FNODEDEF FLine CreateNodeLine(FNodeContext *ctx, int from)
+{
+    if (ctx->linesCount == ctx->linesCapacity) GrowLinesPool(ctx);
+
+    FLine newLine = (FLine)ArenaAlloc(ctx, &ctx->linesArena);
+
+    int id = AllocateId(&ctx->linesIds);
+
     // Initialize line id
     if (id != -1) newLine->id = id;
     else TraceLogFNode(true, "line creation failed because there is any available id");
 
     // Initialize line input
-    newLine->from = from;
-    newLine->to = -1;
+    int fromIndex = GetNodeIndex(ctx, from);
+    if (fromIndex == -1) TraceLogFNode(true, "line creation failed because start node id %i does not exist", from);
+
+    newLine->from = GetNodeHandle(ctx, ctx->nodes[fromIndex]);
+    newLine->to = NULL_HANDLE;
+    newLine->prevOutput = NULL;
+    newLine->nextOutput = NULL;
 
-    lines[linesCount] = newLine;
-    linesCount++;
+    ctx->lines[ctx->linesCount] = newLine;
+    ctx->linesIndex[newLine->id] = ctx->linesCount;
+    ctx->linesCount++;
 
-    TraceLogFNode(false, "created new line id %i (index: %i) [USED RAM: %i bytes]", newLine->id, (linesCount - 1), usedMemory);
+    TraceLogFNode(false, "created new line id %i (index: %i) [USED RAM: %i bytes]", newLine->id, (ctx->linesCount - 1), ctx->usedMemory);
 
     return newLine;
 }
 
-// Creates a comment
-FNODEDEF FComment CreateComment()
+// Links a line end to a node input updating nodes adjacency lists (returns false if node inputs are full or it would create a cycle)
+FNODEDEF bool LinkNodeLine(FNodeContext *ctx, FLine line, int to)
 {
-    FComment newComment = (FComment)FNODE_MALLOC(sizeof(FCommentData));
-    usedMemory += sizeof(FCommentData);
+    bool linked = false;
 
-    int id = -1;
-    for (int i = 0; i < MAX_COMMENTS; i++)
+    if (line != NULL)
     {
-        int currentId = i;
+        FNode fromNode = GetNodeFromHandle(ctx, line->from);
+        int toIndex = GetNodeIndex(ctx, to);
+        FNode toNode = ((toIndex != -1) ? ctx->nodes[toIndex] : NULL);
 
-        // Check if current id already exist in other comment
-        for (int k = 0; k < commentsCount; k++)
+        if ((fromNode == NULL) || (toNode == NULL)) TraceLogFNode(false, "error when trying to link line id %i because its nodes do not exist", line->id);
+        else if ((toNode->inputsCount < (int)toNode->inputsLimit) && (toNode->inputsCount < MAX_INPUTS))
         {
-            if (comments[k]->id == currentId)
+            if (line->to != NULL_HANDLE) UnlinkNodeLine(ctx, line);
+
+            // Nodes ranks are updated before linking, so a link which closes a cycle is rejected
+            if (!RankNodesLink(ctx, fromNode, toNode)) TraceLogFNode(false, "error when trying to link line id %i because node id %i output already reaches node id %i (it would create a cycle)", line->id, to, fromNode->id);
+            else
             {
-                currentId++;
-                break;
+                line->to = GetNodeHandle(ctx, toNode);
+
+                // Append line to end node inputs keeping inputs link order
+                toNode->inputs[toNode->inputsCount] = fromNode->id;
+                toNode->inputLines[toNode->inputsCount] = line;
+                toNode->inputsCount++;
+
+                // Insert line at start node outputs list head
+                line->prevOutput = NULL;
+                line->nextOutput = fromNode->outputLines;
+                if (fromNode->outputLines != NULL) fromNode->outputLines->prevOutput = line;
+                fromNode->outputLines = line;
+                fromNode->outputsCount++;
+
+                ctx->scheduleDirty = true;
+                MarkNodeDirty(ctx, toNode);
+
+                // Start node becomes reachable through end node if it is used
+                if (toNode->usesCount > 0) AddNodeUse(ctx, fromNode);
+
+                linked = true;
             }
         }
+        else TraceLogFNode(false, "error when trying to link line id %i because node id %i inputs are full", line->id, to);
+    }
+    else TraceLogFNode(true, "error trying to link a null referenced line");
 
-        // If not exist, set it as new comment id
-        if (currentId == i)
-        {
-            id = i;
-            break;
-        }
+    return linked;
+}
+
+// Returns a generation-tagged handle that references a line
+FNODEDEF FHandle GetLineHandle(FNodeContext *ctx, FLine line)
+{
+    FHandle handle = NULL_HANDLE;
+
+    if (line != NULL) handle = ((FHandle)ctx->linesGenerations[line->id] << HANDLE_INDEX_BITS) | line->id;
+
+    return handle;
+}
+
+// Returns the line referenced by a handle (NULL if it was destroyed)
+FNODEDEF FLine GetLineFromHandle(FNodeContext *ctx, FHandle handle)
+{
+    FLine line = NULL;
+    int id = (int)(handle & HANDLE_INDEX_MASK);
+
+    if ((handle != NULL_HANDLE) && (id < ctx->linesCapacity) && (ctx->linesGenerations[id] == (handle >> HANDLE_INDEX_BITS)) && (ctx->linesIndex[id] != -1))
+    {
+        line = ctx->lines[ctx->linesIndex[id]];
     }
 
+    return line;
+}
+
+// Creates a comment
+FNODEDEF FComment CreateComment(FNodeContext *ctx)
+{
+    if (ctx->commentsCount == ctx->commentsCapacity) GrowCommentsPool(ctx);
+
+    FComment newComment = (FComment)ArenaAlloc(ctx, &ctx->commentsArena);
+
+    int id = AllocateId(&ctx->commentsIds);
+
     // Initialize comment id
     if (id != -1) newComment->id = id;
     else TraceLogFNode(true, "comment creation failed because there is any available id");
 
     // Initialize comment input
-    newComment->value = (char *)FNODE_MALLOC(MAX_COMMENT_LENGTH);
-    usedMemory += MAX_COMMENT_LENGTH;
+    newComment->value = (char *)(newComment + 1);
     for (int i = 0; i < MAX_COMMENT_LENGTH; i++)
     {
         if (i == 0) newComment->value[i] = 'C';
@@ -776,10 +1133,10 @@ FNODEDEF FComment CreateComment()
     newComment->sizeBlShape = (Rectangle){ 0, 0, 10, 10 };
     newComment->sizeBrShape = (Rectangle){ 0, 0, 10, 10 };
 
-    comments[commentsCount] = newComment;
-    commentsCount++;
+    ctx->comments[ctx->commentsCount] = newComment;
+    ctx->commentsCount++;
 
-    TraceLogFNode(false, "created new comment id %i (index: %i) [USED RAM: %i bytes]", newComment->id, (commentsCount - 1), usedMemory);
+    TraceLogFNode(false, "created new comment id %i (index: %i) [USED RAM: %i bytes]", newComment->id, (ctx->commentsCount - 1), ctx->usedMemory);
 
     return newComment;
 }
@@ -836,14 +1193,14 @@ FNODEDEF void UpdateNodeShapes(FNode node)
         int currentLength = 0;
         for (int i = 0; i < node->output.dataCount; i++)
         {
-            node->output.data[i].shape.x = node->shape.x + 5;
-            node->output.data[i].shape.width = NODE_DATA_WIDTH;
-            node->output.data[i].shape.width += MeasureText(node->output.data[i].valueText, 20);
+            node->values[i].shape.x = node->shape.x + 5;
+            node->values[i].shape.width = NODE_DATA_WIDTH;
+            node->values[i].shape.width += MeasureText(node->values[i].valueText, 20);
 
-            if (i == 0) node->output.data[i].shape.y = node->shape.y + 5;
-            else node->output.data[i].shape.y = node->output.data[i - 1].shape.y + node->output.data[i - 1].shape.height + 5;
+            if (i == 0) node->values[i].shape.y = node->shape.y + 5;
+            else node->values[i].shape.y = node->values[i - 1].shape.y + node->values[i - 1].shape.height + 5;
 
-            int length = MeasureText(node->output.data[i].valueText, 20);
+            int length = MeasureText(node->values[i].valueText, 20);
             if (length > currentLength)
             {
                 index = i;
@@ -853,14 +1210,14 @@ FNODEDEF void UpdateNodeShapes(FNode node)
 
         node->shape.width = 10 + NODE_DATA_WIDTH;
 
-        if (index != -1) node->shape.width += MeasureText(node->output.data[index].valueText, 20);
+        if (index != -1) node->shape.width += MeasureText(node->values[index].valueText, 20);
         else if (node->output.dataCount > 0)
         {
             bool isError = false;
 
             for (int i = 0; i < node->output.dataCount; i++)
             {
-                if (node->output.data[i].valueText[0] != '\0') isError = true;
+                if (node->values[i].valueText[0] != '\0') isError = true;
             }
 
             if (isError) TraceLogFNode(true, "error trying to calculate node data longest value");
@@ -881,12 +1238,32 @@ FNODEDEF void UpdateNodeShapes(FNode node)
     else TraceLogFNode(true, "error trying to calculate values for a null referenced node");
 }
 
+// Formats a node values texts and updates its shapes if its values changed since last update
+FNODEDEF void UpdateNodeText(FNode node)
+{
+    if (node != NULL)
+    {
+        if (node->textDirty)
+        {
+            // Constant nodes values texts are written by their edition, so just their shapes are updated
+            if (node->type > FNODE_VECTOR4)
+            {
+                for (int k = 0; k < node->output.dataCount; k++) FFloatToString(node->values[k].valueText, node->output.data[k]);
+            }
+
+            UpdateNodeShapes(node);
+            node->textDirty = false;
+        }
+    }
+    else TraceLogFNode(true, "error trying to update values texts for a null referenced node");
+}
+
 // Updates a comment shapes due to drag behaviour
-FNODEDEF void UpdateCommentShapes(FComment comment)
+FNODEDEF void UpdateCommentShapes(FNodeContext *ctx, FComment comment)
 {
     if (comment != NULL)
     {
-        if (commentState == 0)
+        if (ctx->commentState == 0)
         {
             if (comment->shape.width < MIN_COMMENT_SIZE) comment->shape.width = MIN_COMMENT_SIZE;
             if (comment->shape.height < MIN_COMMENT_SIZE) comment->shape.height = MIN_COMMENT_SIZE;
@@ -927,797 +1304,267 @@ FNODEDEF Rectangle CameraToViewRec(Rectangle rec, Camera2D camera)
 }
 
 // Calculates nodes output values based on current inputs
-FNODEDEF void CalculateValues()
+FNODEDEF void CalculateValues(FNodeContext *ctx)
 {
-    for (int i = 0; i < nodesCount; i++)
+    if (ctx->scheduleDirty) BuildNodesSchedule(ctx);
+
+    ctx->graphDirty = false;
+
+    int start = 0;
+
+#if defined(FNODE_PARALLEL)
+    // Large graphs calculate nodes which do not depend on cycles level by level on threads pool
+    if (ctx->nodesScheduleAcyclicCount >= PARALLEL_MIN_NODES)
     {
-        if (nodes[i] != NULL)
-        {
-            // Reset node inputs values and inputs count
-            for (int k = 0; k < MAX_INPUTS; k++) nodes[i]->inputs[k] = -1;
-            nodes[i]->inputsCount = 0;
+        if (ctx->workers == NULL) ctx->workers = CreateWorkers(ctx);
 
-            // Search for node inputs and calculate inputs count
-            for (int k = 0; k < linesCount; k++)
-            {
-                if (lines[k] != NULL)
-                {
-                    // Check if line output (to) is the node input id
-                    if (lines[k]->to == nodes[i]->id)
-                    {
-                        nodes[i]->inputs[nodes[i]->inputsCount] = lines[k]->from;
-                        nodes[i]->inputsCount++;
-                    }
-                }
-            }
+        ctx->workers->job = CalculateLevels;
+        WaitWorkers(ctx->workers);
+        CalculateLevels(ctx, 0);
+        start = ctx->nodesScheduleAcyclicCount;
+    }
+#endif
 
-            // Check if current node is an operator
-            if (nodes[i]->type > FNODE_VECTOR4 && nodes[i]->type < FNODE_APPEND)
-            {
-                // Calculate output values count based on first input node value count
-                if (nodes[i]->inputsCount > 0) 
-                {
-                    // Get which index has the first input node id from current nude
-                    int index = GetNodeIndex(nodes[i]->inputs[0]);
+    // Nodes are calculated in topological order, so their inputs values are always calculated before them
+    for (int s = start; s < ctx->nodesScheduleCount; s++)
+    {
+        bool changed = CalculateNodeValues(ctx, s);
 
-                    nodes[i]->output.dataCount = nodes[index]->output.dataCount;
-                    for (int k = 0; k < nodes[i]->output.dataCount; k++) nodes[i]->output.data[k].value = nodes[index]->output.data[k].value;
+        // Values texts are formatted once the node is drawn or edited
+        if (changed) ctx->nodesSchedule[s]->textDirty = true;
+        ctx->nodesSchedule[s]->dirty = false;
 
-                    for (int k = 1; k < nodes[i]->inputsCount; k++)
-                    {
-                        int inputIndex = GetNodeIndex(nodes[i]->inputs[k]);
+        // Values changed inside cycles during this pass still need to reach nodes scheduled before current one
+        if ((s >= ctx->nodesScheduleAcyclicCount) && changed) ctx->graphDirty = true;
+    }
+}
 
-                        // Apply inputs values to output based on node operation type
-                        switch (nodes[i]->type)
-                        {
-                            case FNODE_ADD:
-                            {
-                                for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value += nodes[inputIndex]->output.data[j].value;
-                            } break;
-                            case FNODE_SUBTRACT:
-                            {
-                                for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value -= nodes[inputIndex]->output.data[j].value;
-                            } break;
-                            case FNODE_MULTIPLY:
-                            {
-                                if (nodes[inputIndex]->output.dataCount == 1)
-                                {
-                                    for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value *= nodes[inputIndex]->output.data[0].value;
-                                }
-                                else
-                                {
-                                    for (int j = 0; j < nodes[i]->output.dataCount; j++)
-                                    {
-                                        if (nodes[inputIndex]->output.dataCount == 16 && nodes[i]->output.dataCount == 4)
-                                        {
-                                            Vector4 vector = { nodes[i]->output.data[0].value, nodes[i]->output.data[1].value, nodes[i]->output.data[2].value, nodes[i]->output.data[3].value };
-                                            Matrix matrix = { nodes[inputIndex]->output.data[4].value, nodes[inputIndex]->output.data[5].value, nodes[inputIndex]->output.data[6].value, nodes[inputIndex]->output.data[7].value,
-                                            nodes[inputIndex]->output.data[8].value, nodes[inputIndex]->output.data[9].value, nodes[inputIndex]->output.data[10].value, nodes[inputIndex]->output.data[11].value,
-                                            nodes[inputIndex]->output.data[12].value, nodes[inputIndex]->output.data[13].value, nodes[inputIndex]->output.data[14].value, nodes[inputIndex]->output.data[15].value };
-                                            FMultiplyMatrixVector(&vector, matrix);
-
-                                            for (int k = 0; k < MAX_VALUES; k++) nodes[i]->output.data[k].value = 0.0f;
-                                            nodes[i]->output.data[0].value = vector.x;
-                                            nodes[i]->output.data[1].value = vector.y;
-                                            nodes[i]->output.data[2].value = vector.z;
-                                            nodes[i]->output.data[3].value = vector.w;
-                                            nodes[i]->output.dataCount = 4;
-                                        }
-                                        else if (nodes[inputIndex]->output.dataCount == 4 && nodes[i]->output.dataCount == 16)
-                                        {
-                                            Vector4 vector = { nodes[inputIndex]->output.data[0].value, nodes[inputIndex]->output.data[1].value, nodes[inputIndex]->output.data[2].value, nodes[inputIndex]->output.data[3].value };
-                                            Matrix matrix = { nodes[i]->output.data[4].value, nodes[i]->output.data[5].value, nodes[i]->output.data[6].value, nodes[i]->output.data[7].value,
-                                            nodes[i]->output.data[8].value, nodes[i]->output.data[9].value, nodes[i]->output.data[10].value, nodes[i]->output.data[11].value,
-                                            nodes[i]->output.data[12].value, nodes[i]->output.data[13].value, nodes[i]->output.data[14].value, nodes[i]->output.data[15].value };
-                                            FMultiplyMatrixVector(&vector, matrix);
-
-                                            for (int k = 0; k < MAX_VALUES; k++) nodes[i]->output.data[k].value = 0.0f;
-                                            nodes[i]->output.data[0].value = vector.x;
-                                            nodes[i]->output.data[1].value = vector.y;
-                                            nodes[i]->output.data[2].value = vector.z;
-                                            nodes[i]->output.data[3].value = vector.w;
-                                            nodes[i]->output.dataCount = 4;
-                                        }
-                                        else nodes[i]->output.data[j].value *= nodes[inputIndex]->output.data[j].value;
-                                    }
-                                }
-                            } break;
-                            case FNODE_DIVIDE:
-                            {
-                                if (nodes[inputIndex]->output.dataCount == 1)
-                                {
-                                    for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value /= nodes[inputIndex]->output.data[0].value;
-                                }
-                                else
-                                {
-                                    for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value /= nodes[inputIndex]->output.data[j].value;
-                                }
-                            } break;
-                            default: break;
-                        }
-                    }
-                }
-                else
-                {
-                    for (int k = 0; k < MAX_VALUES; k++) nodes[i]->output.data[k].value = 0.0f;
-                    nodes[i]->output.dataCount = 0;
-                }
-            }
-            else if (nodes[i]->type == FNODE_APPEND)
-            {
-                if (nodes[i]->inputsCount > 0)
-                {
-                    int valuesCount = 0;
-                    for (int k = 0; k < nodes[i]->inputsCount; k++)
-                    {
-                        int inputIndex = GetNodeIndex(nodes[i]->inputs[k]);
+// Calculates nodes output values if graph changed since last calculation
+FNODEDEF void UpdateValues(FNodeContext *ctx)
+{
+    if ((ctx->graphEditDepth > 0) || !ctx->graphDirty) return;
 
-                        for (int j = 0; j < nodes[inputIndex]->output.dataCount; j++)
-                        {
-                            nodes[i]->output.data[valuesCount].value = nodes[inputIndex]->output.data[j].value;
-                            valuesCount++;
-                        }
-                    }
+    if (ctx->scheduleDirty) BuildNodesSchedule(ctx);
 
-                    nodes[i]->output.dataCount = valuesCount;
-                }
-                else
-                {
-                    for (int k = 0; k < MAX_VALUES; k++) nodes[i]->output.data[k].value = 0.0f;
-                    nodes[i]->output.dataCount = 0;
-                }
+    bool cycleDirty = false;
+
+    // Dirty nodes are calculated in schedule order, so every dirty node inputs are already up to date
+    for (int s = ctx->scheduleDirtyStart; s < ctx->nodesScheduleCount; s++)
+    {
+        FNode node = ctx->nodesSchedule[s];
+
+        if (node->dirty)
+        {
+            if (s >= ctx->nodesScheduleAcyclicCount)
+            {
+                cycleDirty = true;
+                break;
             }
-            else if (nodes[i]->type > FNODE_APPEND)
+
+            // Schedule builds load registers from nodes values, so dirty constants always reach their outputs
+            if (CalculateNodeValues(ctx, s) || (node->type <= FNODE_VECTOR4))
             {
-                if (nodes[i]->inputsCount > 0)
+                for (FLine line = node->outputLines; line != NULL; line = line->nextOutput)
                 {
-                    int index = GetNodeIndex(nodes[i]->inputs[0]);
+                    FNode toNode = GetNodeFromHandle(ctx, line->to);
+                    if (toNode != NULL) toNode->dirty = true;
+                }
 
-                    nodes[i]->output.dataCount = nodes[index]->output.dataCount;
-                    for (int k = 0; k < nodes[i]->output.dataCount; k++) nodes[i]->output.data[k].value = nodes[index]->output.data[k].value;
+                node->textDirty = true;
+            }
 
-                    switch (nodes[i]->type)
-                    {
-                        case FNODE_ONEMINUS:
-                        {
-                            for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value = 1 - nodes[i]->output.data[j].value;
-                        } break;
-                        case FNODE_ABS:
-                        {
-                            for (int j = 0; j < nodes[i]->output.dataCount; j++)
-                            {
-                                if (nodes[i]->output.data[j].value < 0) nodes[i]->output.data[j].value *= -1;
-                            }
-                        } break;
-                        case FNODE_COS:
-                        {
-                            for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value = (float)FCos(nodes[i]->output.data[j].value);
-                        } break;
-                        case FNODE_SIN:
-                        {
-                            for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value = (float)FSin(nodes[i]->output.data[j].value);
-                        } break;
-                        case FNODE_TAN:
-                        {
-                            for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value = (float)FTan(nodes[i]->output.data[j].value);
-                        } break;
-                        case FNODE_DEG2RAD:
-                        {
-                            for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value *= DEG2RAD;
-                        } break;
-                        case FNODE_RAD2DEG:
-                        {
-                            for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value *= RAD2DEG;
-                        } break;
-                        case FNODE_NORMALIZE:
-                        {
-                            switch (nodes[i]->output.dataCount)
-                            {
-                                case 2:
-                                {
-                                    Vector2 temp = { nodes[i]->output.data[0].value, nodes[i]->output.data[1].value };
-                                    temp = FVector2Normalize(temp);
-                                    nodes[i]->output.data[0].value = temp.x;
-                                    nodes[i]->output.data[1].value = temp.y;
-                                } break;
-                                case 3:
-                                {
-                                    Vector3 temp = { nodes[i]->output.data[0].value, nodes[i]->output.data[1].value, nodes[i]->output.data[2].value };
-                                    temp = FVector3Normalize(temp);
-                                    nodes[i]->output.data[0].value = temp.x;
-                                    nodes[i]->output.data[1].value = temp.y;
-                                    nodes[i]->output.data[2].value = temp.z;
-                                } break;
-                                case 4:
-                                {
-                                    Vector4 temp = { nodes[i]->output.data[0].value, nodes[i]->output.data[1].value, nodes[i]->output.data[2].value, nodes[i]->output.data[3].value };
-                                    temp = FVector4Normalize(temp);
-                                    nodes[i]->output.data[0].value = temp.x;
-                                    nodes[i]->output.data[1].value = temp.y;
-                                    nodes[i]->output.data[2].value = temp.z;
-                                    nodes[i]->output.data[3].value = temp.w;
-                                } break;
-                                default: break;
-                            }
-                        } break;
-                        case FNODE_NEGATE:
-                        {
-                            for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value *= -1;
-                        } break;
-                        case FNODE_RECIPROCAL:
-                        {
-                            for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value = 1/nodes[i]->output.data[j].value;
-                        } break;
-                        case FNODE_SQRT:
-                        {
-                            for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value = FSquareRoot(nodes[i]->output.data[j].value);
-                        } break;
-                        case FNODE_TRUNC:
-                        {
-                            for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value = FTrunc(nodes[i]->output.data[j].value);
-                        } break;
-                        case FNODE_ROUND:
-                        {
-                            for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value = FRound(nodes[i]->output.data[j].value);
-                        } break;
-                        case FNODE_VERTEXCOLOR:
-                        {
-                            if (nodes[i]->inputsCount == 1)
-                            {
-                                int index = GetNodeIndex(nodes[i]->inputs[0]);
-                                switch ((int)nodes[index]->output.data[0].value)
-                                {
-                                    case 0: nodes[i]->output.dataCount = 4; break;
-                                    case 1: nodes[i]->output.dataCount = 3; break;
-                                    default: nodes[i]->output.dataCount = 1; break;
-                                }
-                            }
-                            else
-                            {
-                                nodes[i]->output.dataCount = 0;
-                                for (int j = 0; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                            }
-                        }
-                        case FNODE_CEIL:
-                        {
-                            for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value = FCeil(nodes[i]->output.data[j].value);
-                        } break;
-                        case FNODE_CLAMP01:
-                        {
-                            for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value = FClamp(nodes[i]->output.data[j].value, 0.0f, 1.0f);
-                        } break;
-                        case FNODE_EXP2:
-                        {
-                            for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value = FPower(2.0f, nodes[i]->output.data[j].value);
-                        } break;
-                        case FNODE_POWER:
-                        {
-                            if (nodes[i]->inputsCount == 2)
-                            {
-                                int expIndex = GetNodeIndex(nodes[i]->inputs[1]);
+            node->dirty = false;
+        }
+    }
 
-                                if (nodes[expIndex]->output.dataCount == 1)
-                                {
-                                    for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value = FPower(nodes[i]->output.data[j].value, nodes[expIndex]->output.data[0].value);
-                                }
-                                else TraceLogFNode(false, "values count of node %i should be 1 because it is an exponent (currently count: %i)", nodes[expIndex]->id, nodes[expIndex]->output.dataCount);
-                            }
-                            else
-                            {
-                                nodes[i]->output.dataCount = 0;
-                                for (int j = 0; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                            }
-                        } break;
-                        case FNODE_STEP:
-                        {
-                            if (nodes[i]->inputsCount == 2)
-                            {
-                                int indexB = GetNodeIndex(nodes[i]->inputs[1]);
+    ctx->scheduleDirtyStart = ctx->nodesScheduleCount;
+    ctx->graphDirty = false;
 
-                                if (nodes[indexB]->output.dataCount == 1) nodes[i]->output.data[0].value = ((nodes[i]->output.data[0].value <= nodes[indexB]->output.data[0].value) ? 1.0f : 0.0f);
-                                else TraceLogFNode(false, "values count of node %i should be 1 because it is an exponent (currently count: %i)", nodes[indexB]->id, nodes[indexB]->output.dataCount);
-                            }
-                            else
-                            {
-                                nodes[i]->output.dataCount = 0;
-                                for (int j = 0; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                            }
-                        } break;
-                        case FNODE_POSTERIZE:
-                        {
-                            if (nodes[i]->inputsCount == 2)
-                            {
-                                int expIndex = GetNodeIndex(nodes[i]->inputs[1]);
+    // Nodes inside cycles are calculated in whole passes until their values stop changing
+    if (cycleDirty)
+    {
+        ctx->graphDirty = true;
+        for (int i = 0; ctx->graphDirty && (i <= ctx->nodesScheduleCount); i++) CalculateValues(ctx);
+    }
+}
 
-                                if (nodes[expIndex]->output.dataCount == 1)
-                                {
-                                    for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value = FPosterize(nodes[i]->output.data[j].value, nodes[expIndex]->output.data[0].value);
-                                }
-                            }
-                            else
-                            {
-                                nodes[i]->output.dataCount = 0;
-                                for (int j = 0; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                            }
-                        } break;
-                        case FNODE_MAX:
-                        case FNODE_MIN:
-                        {
-                            for (int j = 1; j < nodes[i]->inputsCount; j++)
-                            {
-                                int inputIndex = GetNodeIndex(nodes[i]->inputs[j]);
+// Marks a node values to be calculated again in next values update
+FNODEDEF void MarkNodeDirty(FNodeContext *ctx, FNode node)
+{
+    if (node != NULL)
+    {
+        node->dirty = true;
+        ctx->graphDirty = true;
 
-                                for (int k = 0; k < nodes[i]->output.dataCount; k++)
-                                {
-                                    if ((nodes[inputIndex]->output.data[k].value > nodes[i]->output.data[k].value) && (nodes[i]->type == FNODE_MAX)) nodes[i]->output.data[k].value = nodes[inputIndex]->output.data[k].value;
-                                    else if ((nodes[inputIndex]->output.data[k].value < nodes[i]->output.data[k].value) && (nodes[i]->type == FNODE_MIN)) nodes[i]->output.data[k].value = nodes[inputIndex]->output.data[k].value;
-                                }
-                            }
-                        } break;
-                        case FNODE_LERP:
-                        {                                
-                            if (nodes[i]->inputsCount == 3)
-                            {
-                                int indexA = GetNodeIndex(nodes[i]->inputs[0]);
-                                int indexB = GetNodeIndex(nodes[i]->inputs[1]);
-                                int indexC = GetNodeIndex(nodes[i]->inputs[2]);
+        // Shared constants can stop sharing values with other nodes, so structures need to be hashed again
+        if ((node->type <= FNODE_VECTOR4) && node->shared) ctx->scheduleDirty = true;
 
-                                switch (nodes[i]->output.dataCount)
-                                {
-                                    case 1:
-                                    {
-                                        for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value = FLerp(nodes[indexA]->output.data[j].value, nodes[indexB]->output.data[j].value, nodes[indexC]->output.data[j].value);
-                                    } break;
-                                    case 2:
-                                    {
-                                        Vector2 vectorA = { nodes[indexA]->output.data[0].value, nodes[indexA]->output.data[1].value };
-                                        Vector2 vectorB = { nodes[indexB]->output.data[0].value, nodes[indexB]->output.data[1].value };
-                                        Vector2 lerp = FVector2Lerp(vectorA, vectorB, nodes[indexC]->output.data[0].value);
-
-                                        nodes[i]->output.dataCount = 2;
-                                        nodes[i]->output.data[0].value = lerp.x;
-                                        nodes[i]->output.data[1].value = lerp.y;
-                                    } break;
-                                    case 3:
-                                    {
-                                        Vector3 vectorA = { nodes[indexA]->output.data[0].value, nodes[indexA]->output.data[1].value, nodes[indexA]->output.data[2].value };
-                                        Vector3 vectorB = { nodes[indexB]->output.data[0].value, nodes[indexB]->output.data[1].value, nodes[indexA]->output.data[2].value };
-                                        Vector3 lerp = FVector3Lerp(vectorA, vectorB, nodes[indexC]->output.data[0].value);
-
-                                        nodes[i]->output.dataCount = 3;
-                                        nodes[i]->output.data[0].value = lerp.x;
-                                        nodes[i]->output.data[1].value = lerp.y;
-                                        nodes[i]->output.data[2].value = lerp.z;
-                                    } break;
-                                    case 4:
-                                    {
-                                        Vector4 vectorA = { nodes[indexA]->output.data[0].value, nodes[indexA]->output.data[1].value, nodes[indexA]->output.data[2].value, nodes[indexA]->output.data[3].value };
-                                        Vector4 vectorB = { nodes[indexB]->output.data[0].value, nodes[indexB]->output.data[1].value, nodes[indexA]->output.data[2].value, nodes[indexA]->output.data[3].value };
-                                        Vector4 lerp = FVector4Lerp(vectorA, vectorB, nodes[indexC]->output.data[0].value);
-
-                                        nodes[i]->output.dataCount = 4;
-                                        nodes[i]->output.data[0].value = lerp.x;
-                                        nodes[i]->output.data[1].value = lerp.y;
-                                        nodes[i]->output.data[2].value = lerp.z;
-                                        nodes[i]->output.data[3].value = lerp.w;
-                                    } break;
-                                    default: break;
-                                }
-                            }
-                            else
-                            {
-                                nodes[i]->output.dataCount = 0;
-                                for (int j = 0; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                            }
-                        } break;
-                        case FNODE_SMOOTHSTEP:
-                        {                                
-                            if (nodes[i]->inputsCount == 3)
-                            {
-                                int indexA = GetNodeIndex(nodes[i]->inputs[0]);
-                                int indexB = GetNodeIndex(nodes[i]->inputs[1]);
-                                int indexC = GetNodeIndex(nodes[i]->inputs[2]);
+        // Unreachable nodes are not scheduled, they keep dirty state until they become reachable
+        if (!ctx->scheduleDirty && (node->scheduleIndex != -1) && (node->scheduleIndex < ctx->scheduleDirtyStart)) ctx->scheduleDirtyStart = node->scheduleIndex;
+    }
+    else TraceLogFNode(true, "error trying to mark a null referenced node");
+}
 
-                                for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value = FSmoothStep(nodes[indexA]->output.data[j].value, nodes[indexB]->output.data[j].value, nodes[indexC]->output.data[j].value);
-                            }
-                            else
-                            {
-                                nodes[i]->output.dataCount = 0;
-                                for (int j = 0; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                            }
-                        } break;
-                        case FNODE_CROSSPRODUCT:
-                        {
-                            if (nodes[i]->inputsCount == 2)
-                            {
-                                int indexA = GetNodeIndex(nodes[i]->inputs[0]);
-                                int indexB = GetNodeIndex(nodes[i]->inputs[1]);
+// Sets if a node values are calculated even if output nodes cannot reach it
+FNODEDEF void PinNode(FNodeContext *ctx, FNode node, bool pinned)
+{
+    if (node != NULL)
+    {
+        if (pinned != node->pinned)
+        {
+            node->pinned = pinned;
 
-                                for (int j = 0; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
+            if (pinned) AddNodeUse(ctx, node);
+            else ReleaseNodeUse(ctx, node);
+        }
+    }
+    else TraceLogFNode(true, "error trying to pin a null referenced node");
+}
 
-                                Vector3 vectorA = { nodes[indexA]->output.data[0].value, nodes[indexA]->output.data[1].value, nodes[indexA]->output.data[2].value };
-                                Vector3 vectorB = { nodes[indexB]->output.data[0].value, nodes[indexB]->output.data[1].value, nodes[indexB]->output.data[2].value };
-                                Vector3 cross = FCrossProduct(vectorA, vectorB);
+// Returns first scheduled node with same structure as a node (itself if it is unique or not scheduled)
+FNODEDEF FNode GetEquivalentNode(FNodeContext *ctx, FNode node)
+{
+    FNode equivalent = node;
 
-                                nodes[i]->output.dataCount = 3;
-                                nodes[i]->output.data[0].value = cross.x;
-                                nodes[i]->output.data[1].value = cross.y;
-                                nodes[i]->output.data[2].value = cross.z;
-                            }
-                            else
-                            {
-                                nodes[i]->output.dataCount = 0;
-                                for (int j = 0; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                            }
-                        } break;
-                        case FNODE_DESATURATE:
-                        {
-                            if (nodes[i]->inputsCount == 2)
-                            {
-                                int index = GetNodeIndex(nodes[i]->inputs[0]);
-                                int index1 = GetNodeIndex(nodes[i]->inputs[1]);
+    if (node != NULL)
+    {
+        if (ctx->scheduleDirty) BuildNodesSchedule(ctx);
+        if (node->scheduleIndex != -1) equivalent = ctx->nodesSchedule[ctx->nodesEquivalent[node->scheduleIndex]];
+    }
+    else TraceLogFNode(true, "error trying to get equivalent node of a null referenced node");
 
-                                for (int j = 0; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = nodes[index]->output.data[j].value;
-                                nodes[i]->output.dataCount = nodes[index]->output.dataCount;
+    return equivalent;
+}
 
-                                float amount = FClamp(nodes[index1]->output.data[0].value, 0.0f, 1.0f);
-                                float luminance = 0.3f*nodes[i]->output.data[0].value + 0.6f*nodes[i]->output.data[1].value + 0.1f*nodes[i]->output.data[2].value;
+// Returns first scheduled node of a structural hash (NULL if there is no node with that hash)
+FNODEDEF FNode FindNodeByHash(FNodeContext *ctx, unsigned int hash)
+{
+    if (ctx->scheduleDirty) BuildNodesSchedule(ctx);
 
-                                nodes[i]->output.data[0].value = nodes[i]->output.data[0].value + amount*(luminance - nodes[i]->output.data[0].value);
-                                nodes[i]->output.data[1].value = nodes[i]->output.data[1].value + amount*(luminance - nodes[i]->output.data[1].value);
-                                nodes[i]->output.data[2].value = nodes[i]->output.data[2].value + amount*(luminance - nodes[i]->output.data[2].value);
-                            }
-                            else
-                            {
-                                nodes[i]->output.dataCount = 0;
-                                for (int j = 0; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                            }
-                        } break;
-                        case FNODE_DISTANCE:
-                        {
-                            if (nodes[i]->inputsCount == 2)
-                            {
-                                int indexA = GetNodeIndex(nodes[i]->inputs[0]);
-                                int indexB = GetNodeIndex(nodes[i]->inputs[1]);
+    int mask = 2*ctx->nodesCapacity - 1;
 
-                                switch (nodes[i]->output.dataCount)
-                                {
-                                    case 1: nodes[i]->output.data[0].value = nodes[indexB]->output.data[0].value - nodes[indexA]->output.data[0].value; break;
-                                    case 2:
-                                    {
-                                        Vector2 direction = { 0, 0 };
-                                        direction.x = nodes[indexB]->output.data[0].value - nodes[indexA]->output.data[0].value;
-                                        direction.y = nodes[indexB]->output.data[1].value - nodes[indexA]->output.data[1].value;
-
-                                        nodes[i]->output.data[0].value = FVector2Length(direction);
-                                    } break;
-                                    case 3:
-                                    {
-                                        Vector3 direction = { 0, 0, 0 };
-                                        direction.x = nodes[indexB]->output.data[0].value - nodes[indexA]->output.data[0].value;
-                                        direction.y = nodes[indexB]->output.data[1].value - nodes[indexA]->output.data[1].value;
-                                        direction.z = nodes[indexB]->output.data[2].value - nodes[indexA]->output.data[2].value;
-
-                                        nodes[i]->output.data[0].value = FVector3Length(direction);
-                                    } break;
-                                    case 4:
-                                    {
-                                        Vector4 direction = { 0, 0, 0, 0 };
-                                        direction.x = nodes[indexB]->output.data[0].value - nodes[indexA]->output.data[0].value;
-                                        direction.y = nodes[indexB]->output.data[1].value - nodes[indexA]->output.data[1].value;
-                                        direction.z = nodes[indexB]->output.data[2].value - nodes[indexA]->output.data[2].value;
-                                        direction.w = nodes[indexB]->output.data[3].value - nodes[indexA]->output.data[3].value;
-
-                                        nodes[i]->output.data[0].value = FVector4Length(direction);
-                                    } break;
-                                    default: break;
-                                }
+    for (int slot = (hash & mask); ctx->hashTable[slot] != -1; slot = ((slot + 1) & mask))
+    {
+        if (ctx->nodesSchedule[ctx->hashTable[slot]]->hash == hash) return ctx->nodesSchedule[ctx->hashTable[slot]];
+    }
 
-                                for (int j = 1; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                                nodes[i]->output.dataCount = 1;
-                            }
-                            else
-                            {
-                                for (int j = 0; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                                nodes[i]->output.dataCount = 0;
-                            }
-                        } break;
-                        case FNODE_DOTPRODUCT:
-                        {
-                            if (nodes[i]->inputsCount == 2)
-                            {
-                                int indexA = GetNodeIndex(nodes[i]->inputs[0]);
-                                int indexB = GetNodeIndex(nodes[i]->inputs[1]);
+    return NULL;
+}
 
-                                switch (nodes[i]->output.dataCount)
-                                {
-                                    case 2:
-                                    {
-                                        Vector2 vectorA = { nodes[indexA]->output.data[0].value, nodes[indexA]->output.data[1].value };
-                                        Vector2 vectorB = { nodes[indexB]->output.data[0].value, nodes[indexB]->output.data[1].value };
-                                        nodes[i]->output.data[0].value = FVector2Dot(vectorA, vectorB);
-                                    } break;
-                                    case 3:
-                                    {
-                                        Vector3 vectorA = { nodes[indexA]->output.data[0].value, nodes[indexA]->output.data[1].value, nodes[indexA]->output.data[2].value };
-                                        Vector3 vectorB = { nodes[indexB]->output.data[0].value, nodes[indexB]->output.data[1].value, nodes[indexB]->output.data[2].value };
-                                        nodes[i]->output.data[0].value = FVector3Dot(vectorA, vectorB);
-                                    } break;
-                                    case 4:
-                                    {
-                                        Vector4 vectorA = { nodes[indexA]->output.data[0].value, nodes[indexA]->output.data[1].value, nodes[indexA]->output.data[2].value, nodes[indexA]->output.data[3].value };
-                                        Vector4 vectorB = { nodes[indexB]->output.data[0].value, nodes[indexB]->output.data[1].value, nodes[indexB]->output.data[2].value, nodes[indexB]->output.data[3].value };
-                                        nodes[i]->output.data[0].value = FVector4Dot(vectorA, vectorB);
-                                    } break;
-                                    default: break;
-                                }
+// Calculates a vertex output node values for every mesh vertex (3 floats per vertex in positions, returns false if not calculated)
+FNODEDEF bool CalculateMeshVertices(FNodeContext *ctx, FNode output, Mesh mesh, float time, float *positions)
+{
+    if ((mesh.vertexCount <= 0) || (mesh.vertices == NULL)) return false;
 
-                                for (int j = 1; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                                nodes[i]->output.dataCount = 1;
-                            }
-                            else
-                            {
-                                for (int j = 0; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                                nodes[i]->output.dataCount = 0;
-                            }
-                        } break;
-                        case FNODE_LENGTH:
-                        {
-                            switch (nodes[i]->output.dataCount)
-                            {
-                                case 2: nodes[i]->output.data[0].value = FVector2Length((Vector2){ nodes[i]->output.data[0].value, nodes[i]->output.data[1].value }); break;
-                                case 3: nodes[i]->output.data[0].value = FVector3Length((Vector3){ nodes[i]->output.data[0].value, nodes[i]->output.data[1].value, nodes[i]->output.data[2].value }); break;
-                                case 4: nodes[i]->output.data[0].value = FVector4Length((Vector4){ nodes[i]->output.data[0].value, nodes[i]->output.data[1].value, nodes[i]->output.data[2].value, nodes[i]->output.data[3].value }); break;
-                                default: break;
-                            }
+    FBatch batch = { 0 };
+    batch.itemsCount = mesh.vertexCount;
+    batch.mesh = mesh;
+    batch.positions = positions;
+    batch.time = time;
 
-                            for (int j = 1; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                            nodes[i]->output.dataCount = 1;
-                        } break;
-                        case FNODE_MULTIPLYMATRIX:
-                        {
-                            if (nodes[i]->inputsCount == 2)
-                            {
-                                int index = GetNodeIndex(nodes[i]->inputs[1]);
-
-                                Matrix matrixA = { nodes[i]->output.data[0].value, nodes[i]->output.data[1].value, nodes[i]->output.data[2].value, nodes[i]->output.data[3].value, 
-                                nodes[i]->output.data[4].value, nodes[i]->output.data[5].value, nodes[i]->output.data[6].value, nodes[i]->output.data[7].value, 
-                                nodes[i]->output.data[8].value, nodes[i]->output.data[9].value, nodes[i]->output.data[10].value, nodes[i]->output.data[11].value, 
-                                nodes[i]->output.data[12].value, nodes[i]->output.data[13].value, nodes[i]->output.data[14].value, nodes[i]->output.data[15].value, };
-                                Matrix matrixB = { nodes[index]->output.data[0].value, nodes[index]->output.data[1].value, nodes[index]->output.data[2].value, nodes[index]->output.data[3].value, 
-                                nodes[index]->output.data[4].value, nodes[index]->output.data[5].value, nodes[index]->output.data[6].value, nodes[index]->output.data[7].value, 
-                                nodes[index]->output.data[8].value, nodes[index]->output.data[9].value, nodes[index]->output.data[10].value, nodes[index]->output.data[11].value, 
-                                nodes[index]->output.data[12].value, nodes[index]->output.data[13].value, nodes[index]->output.data[14].value, nodes[index]->output.data[15].value, };
-                                Matrix matrixAB = FMatrixMultiply(matrixA, matrixB);
-
-                                nodes[i]->output.data[0].value = matrixAB.m0;
-                                nodes[i]->output.data[1].value = matrixAB.m1;
-                                nodes[i]->output.data[2].value = matrixAB.m2;
-                                nodes[i]->output.data[3].value = matrixAB.m3;
-                                nodes[i]->output.data[4].value = matrixAB.m4;
-                                nodes[i]->output.data[5].value = matrixAB.m5;
-                                nodes[i]->output.data[6].value = matrixAB.m6;
-                                nodes[i]->output.data[7].value = matrixAB.m7;
-                                nodes[i]->output.data[8].value = matrixAB.m8;
-                                nodes[i]->output.data[9].value = matrixAB.m9;
-                                nodes[i]->output.data[10].value = matrixAB.m10;
-                                nodes[i]->output.data[11].value = matrixAB.m11;
-                                nodes[i]->output.data[12].value = matrixAB.m12;
-                                nodes[i]->output.data[13].value = matrixAB.m13;
-                                nodes[i]->output.data[14].value = matrixAB.m14;
-                                nodes[i]->output.data[15].value = matrixAB.m15;
-                            }
-                        } break;
-                        case FNODE_TRANSPOSE:
-                        {
-                            Matrix matrix = { nodes[i]->output.data[0].value, nodes[i]->output.data[1].value, nodes[i]->output.data[2].value, nodes[i]->output.data[3].value, 
-                            nodes[i]->output.data[4].value, nodes[i]->output.data[5].value, nodes[i]->output.data[6].value, nodes[i]->output.data[7].value, 
-                            nodes[i]->output.data[8].value, nodes[i]->output.data[9].value, nodes[i]->output.data[10].value, nodes[i]->output.data[11].value, 
-                            nodes[i]->output.data[12].value, nodes[i]->output.data[13].value, nodes[i]->output.data[14].value, nodes[i]->output.data[15].value, };
-                            FMatrixTranspose(&matrix);
-
-                            nodes[i]->output.data[0].value = matrix.m0;
-                            nodes[i]->output.data[1].value = matrix.m1;
-                            nodes[i]->output.data[2].value = matrix.m2;
-                            nodes[i]->output.data[3].value = matrix.m3;
-                            nodes[i]->output.data[4].value = matrix.m4;
-                            nodes[i]->output.data[5].value = matrix.m5;
-                            nodes[i]->output.data[6].value = matrix.m6;
-                            nodes[i]->output.data[7].value = matrix.m7;
-                            nodes[i]->output.data[8].value = matrix.m8;
-                            nodes[i]->output.data[9].value = matrix.m9;
-                            nodes[i]->output.data[10].value = matrix.m10;
-                            nodes[i]->output.data[11].value = matrix.m11;
-                            nodes[i]->output.data[12].value = matrix.m12;
-                            nodes[i]->output.data[13].value = matrix.m13;
-                            nodes[i]->output.data[14].value = matrix.m14;
-                            nodes[i]->output.data[15].value = matrix.m15;
-                        } break;
-                        case FNODE_PROJECTION:
-                        case FNODE_REJECTION:
-                        {
-                            if (nodes[i]->inputsCount == 2)
-                            {
-                                int indexA = GetNodeIndex(nodes[i]->inputs[0]);
-                                int indexB = GetNodeIndex(nodes[i]->inputs[1]);
+    return CalculateBatch(ctx, &batch, output);
+}
 
-                                switch (nodes[i]->output.dataCount)
-                                {
-                                    case 2:
-                                    {
-                                        Vector2 vectorA = { nodes[indexA]->output.data[0].value, nodes[indexA]->output.data[1].value };
-                                        Vector2 vectorB = { nodes[indexB]->output.data[0].value, nodes[indexB]->output.data[1].value };
-                                        Vector2 newVector = ((nodes[i]->type == FNODE_PROJECTION) ? FVector2Projection(vectorA, vectorB) : FVector2Rejection(vectorA, vectorB));
-
-                                        nodes[i]->output.data[0].value = newVector.x;
-                                        nodes[i]->output.data[1].value = newVector.y;
-
-                                        for (int j = 2; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                                        nodes[i]->output.dataCount = 2;
-                                    } break;
-                                    case 3:
-                                    {
-                                        Vector3 vectorA = { nodes[indexA]->output.data[0].value, nodes[indexA]->output.data[1].value, nodes[indexA]->output.data[2].value };
-                                        Vector3 vectorB = { nodes[indexB]->output.data[0].value, nodes[indexB]->output.data[1].value, nodes[indexB]->output.data[2].value };
-                                        Vector3 newVector = ((nodes[i]->type == FNODE_PROJECTION) ? FVector3Projection(vectorA, vectorB) : FVector3Rejection(vectorA, vectorB));
-
-                                        nodes[i]->output.data[0].value = newVector.x;
-                                        nodes[i]->output.data[1].value = newVector.y;
-                                        nodes[i]->output.data[2].value = newVector.z;
-
-                                        for (int j = 3; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                                        nodes[i]->output.dataCount = 3;
-                                    } break;
-                                    case 4:
-                                    {
-                                        Vector4 vectorA = { nodes[indexA]->output.data[0].value, nodes[indexA]->output.data[1].value, nodes[indexA]->output.data[2].value, nodes[indexA]->output.data[3].value };
-                                        Vector4 vectorB = { nodes[indexB]->output.data[0].value, nodes[indexB]->output.data[1].value, nodes[indexB]->output.data[2].value, nodes[indexB]->output.data[3].value };
-                                        Vector4 newVector = ((nodes[i]->type == FNODE_PROJECTION) ? FVector4Projection(vectorA, vectorB) : FVector4Rejection(vectorA, vectorB));
-
-                                        nodes[i]->output.data[0].value = newVector.x;
-                                        nodes[i]->output.data[1].value = newVector.y;
-                                        nodes[i]->output.data[2].value = newVector.z;
-                                        nodes[i]->output.data[3].value = newVector.w;
-
-                                        for (int j = 4; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                                        nodes[i]->output.dataCount = 4;
-                                    } break;
-                                    default: break;
-                                }
-                            }
-                            else
-                            {
-                                for (int j = 0; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                                nodes[i]->output.dataCount = 0;
-                            }
-                        } break;
-                        case FNODE_HALFDIRECTION:
-                        {
-                            if (nodes[i]->inputsCount == 2)
-                            {
-                                int indexA = GetNodeIndex(nodes[i]->inputs[0]);
-                                int indexB = GetNodeIndex(nodes[i]->inputs[1]);
+// Renders a fragment output node values for every pixel of a sphere preview image (R8G8B8A8 pixels, discarded pixels are transparent, returns false if not rendered)
+FNODEDEF bool RenderFragmentPixels(FNodeContext *ctx, FNode output, int width, int height, Image *textures, int texturesCount, float time, unsigned char *pixels)
+{
+    if ((width <= 0) || (height <= 0)) return false;
+
+    FBatch batch = { 0 };
+    batch.type = BATCH_PIXELS;
+    batch.itemsCount = width*height;
+    batch.width = width;
+    batch.height = height;
+    batch.textures = textures;
+    batch.texturesCount = texturesCount;
+    batch.pixels = pixels;
+    batch.time = time;
+
+    return CalculateBatch(ctx, &batch, output);
+}
 
-                                bool check = true;
-                                check = ((nodes[indexA]->type <= FNODE_E) || (nodes[indexA]->type >= FNODE_MATRIX));
-                                if (check) check = ((nodes[indexB]->type <= FNODE_E) || (nodes[indexB]->type >= FNODE_MATRIX));
+// Calculates a node values for every time sample and returns its data count (curves needs count*MAX_VALUES floats, one curve per component)
+FNODEDEF int CalculateTimeCurves(FNodeContext *ctx, FNode node, const float *times, int count, float *curves)
+{
+    if (count <= 0) return 0;
 
-                                if (check)
-                                {
-                                    switch (nodes[i]->output.dataCount)
-                                    {
-                                        case 2:
-                                        {
-                                            Vector2 a = { nodes[indexA]->output.data[0].value, nodes[indexA]->output.data[1].value };
-                                            Vector2 b = { nodes[indexB]->output.data[0].value, nodes[indexB]->output.data[1].value };
-                                            Vector2 vectorA = FVector2Normalize(a);
-                                            Vector2 vectorB = FVector2Normalize(b);
-                                            Vector2 output = { vectorA.x + vectorB.x, vectorA.y + vectorB.y };
-
-                                            nodes[i]->output.data[0].value = output.x;
-                                            nodes[i]->output.data[1].value = output.y;
-
-                                            for (int j = 2; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                                            nodes[i]->output.dataCount = 2;
-                                        } break;
-                                        case 3:
-                                        {
-                                            Vector3 a = { nodes[indexA]->output.data[0].value, nodes[indexA]->output.data[1].value, nodes[indexA]->output.data[2].value };
-                                            Vector3 b = { nodes[indexB]->output.data[0].value, nodes[indexB]->output.data[1].value, nodes[indexB]->output.data[2].value };
-                                            Vector3 vectorA = FVector3Normalize(a);
-                                            Vector3 vectorB = FVector3Normalize(b);
-                                            Vector3 output = { vectorA.x + vectorB.x, vectorA.y + vectorB.y, vectorA.z + vectorB.z };
-
-                                            nodes[i]->output.data[0].value = output.x;
-                                            nodes[i]->output.data[1].value = output.y;
-                                            nodes[i]->output.data[2].value = output.z;
-
-                                            for (int j = 3; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                                            nodes[i]->output.dataCount = 3;
-                                        } break;
-                                        case 4:
-                                        {
-                                            Vector4 a = { nodes[indexA]->output.data[0].value, nodes[indexA]->output.data[1].value, nodes[indexA]->output.data[2].value, nodes[indexA]->output.data[3].value };
-                                            Vector4 b = { nodes[indexB]->output.data[0].value, nodes[indexB]->output.data[1].value, nodes[indexB]->output.data[2].value, nodes[indexB]->output.data[3].value };
-                                            Vector4 vectorA = FVector4Normalize(a);
-                                            Vector4 vectorB = FVector4Normalize(b);
-                                            Vector4 output = { vectorA.x + vectorB.x, vectorA.y + vectorB.y, vectorA.z + vectorB.z, vectorA.w + vectorB.w };
-
-                                            nodes[i]->output.data[0].value = output.x;
-                                            nodes[i]->output.data[1].value = output.y;
-                                            nodes[i]->output.data[2].value = output.z;
-                                            nodes[i]->output.data[3].value = output.w;
-
-                                            for (int j = 4; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                                            nodes[i]->output.dataCount = 4;
-                                        } break;
-                                        default: break;
-                                    }
-                                }
-                                else
-                                {
-                                    for (int j = 0; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                                }
-                            }
-                            else
-                            {
-                                for (int j = 0; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                                nodes[i]->output.dataCount = 0;
-                            }
-                        }
-                        case FNODE_SAMPLER2D:
-                        {
-                            if (nodes[i]->inputsCount == 2)
-                            {
-                                int indexA = GetNodeIndex(nodes[i]->inputs[1]);
-                                switch ((int)nodes[indexA]->output.data[0].value)
-                                {
-                                    case 0: nodes[i]->output.dataCount = 4; break;
-                                    case 1: nodes[i]->output.dataCount = 3; break;
-                                    default: nodes[i]->output.dataCount = 1; break;
-                                }
-                            }
-                            else
-                            {
-                                for (int j = 0; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                                nodes[i]->output.dataCount = 0;
-                            }
-                        } break;
-                        default: break;
-                    }
-                }
-                else
-                {
-                    for (int k = 0; k < MAX_VALUES; k++) nodes[i]->output.data[k].value = 0.0f;
-                    nodes[i]->output.dataCount = 0;
-                }
-            }
+    if (node == NULL)
+    {
+        TraceLogFNode(true, "error trying to calculate time curves of a null referenced node");
+        return 0;
+    }
 
-            if (nodes[i]->type > FNODE_VECTOR4)
-            {
-                for (int k = 0; k < nodes[i]->output.dataCount; k++) FFloatToString(nodes[i]->output.data[k].valueText, nodes[i]->output.data[k].value);
-            }
+    FBatch batch = { 0 };
+    batch.type = BATCH_TIMES;
+    batch.itemsCount = count;
+    batch.time = times[0];
+    batch.times = times;
+    batch.curves = curves;
 
-            UpdateNodeShapes(nodes[i]);
-        }
-        else TraceLogFNode(true, "error trying to calculate values for a null referenced node");
+    // Nodes which are not calculated are pinned meanwhile, so any node can be sampled
+    bool pinned = node->pinned;
+    if (!pinned) PinNode(ctx, node, true);
+
+    CalculateBatch(ctx, &batch, node);
+
+    if (!pinned) PinNode(ctx, node, false);
+
+    return batch.outputCount;
+}
+
+// Sets math accuracy of nodes values and of vertices, pixels and time samples batches calculations
+FNODEDEF void SetCalculationAccuracy(FNodeContext *ctx, FNodeAccuracy values, FNodeAccuracy batches)
+{
+    ctx->batchAccuracy = batches;
+
+    if (ctx->accuracy != values)
+    {
+        ctx->accuracy = values;
+
+        // Every node value could change, so all nodes are calculated again
+        for (int i = 0; i < ctx->nodesCount; i++) MarkNodeDirty(ctx, ctx->nodes[i]);
+
+        if (ctx->graphEditDepth == 0) UpdateValues(ctx);
+    }
+}
+
+// Begins a graph edit transaction (values are not calculated until it ends)
+FNODEDEF void BeginGraphEdit(FNodeContext *ctx)
+{
+    ctx->graphEditDepth++;
+}
+
+// Ends a graph edit transaction and calculates values once if graph changed
+FNODEDEF void EndGraphEdit(FNodeContext *ctx)
+{
+    if (ctx->graphEditDepth > 0)
+    {
+        ctx->graphEditDepth--;
+
+        if (ctx->graphEditDepth == 0) UpdateValues(ctx);
     }
+    else TraceLogFNode(false, "error trying to end a graph edit without beginning it");
 }
 
 // Draws a previously created node
-FNODEDEF void DrawNode(FNode node)
+FNODEDEF void DrawNode(FNodeContext *ctx, FNode node)
 {
     if (node != NULL)
     {
-        if (node->property) DrawRectangleRec(node->shape, ((node->id == selectedNode) ? (Color){ 128, 204, 139, 255 } : (Color){ 173, 225, 181, 255 }));
-        else DrawRectangleRec(node->shape, ((node->id == selectedNode) ? GRAY : LIGHTGRAY));
+        FHandle handle = GetNodeHandle(ctx, node);
+
+        // Values texts are only formatted for nodes inside screen or being edited
+        if (node->textDirty && ((handle == ctx->editNode) || CheckCollisionRecs(CameraToViewRec(node->shape, ctx->camera), (Rectangle){ 0, 0, GetScreenWidth(), GetScreenHeight() }))) UpdateNodeText(node);
+
+        if (node->property) DrawRectangleRec(node->shape, ((handle == ctx->selectedNode) ? (Color){ 128, 204, 139, 255 } : (Color){ 173, 225, 181, 255 }));
+        else DrawRectangleRec(node->shape, ((handle == ctx->selectedNode) ? GRAY : LIGHTGRAY));
 
         DrawRectangleLines(node->shape.x, node->shape.y, node->shape.width, node->shape.height, BLACK);
         DrawText(FormatText("%s [ID: %i]", node->name, node->id), node->shape.x + node->shape.width/2 - MeasureText(node->name, 10)/2, node->shape.y - 15, 10, BLACK);
 
         if ((node->type >= FNODE_MATRIX) && (node->type <= FNODE_VECTOR4))
         {
-            if ((node->id == editNode) && interact)
+            if ((handle == ctx->editNode) && interact)
             {
                 int charac = -1;
                 charac = GetKeyPressed();
@@ -1728,40 +1575,40 @@ FNODEDEF void DrawNode(FNode node)
                     {
                         for (int i = 0; i < MAX_NODE_LENGTH; i++)
                         {
-                            if ((node->output.data[editNodeType].valueText[i] == '\0'))
+                            if ((node->values[ctx->editNodeType].valueText[i] == '\0'))
                             {
-                                node->output.data[editNodeType].valueText[i - 1] = '\0';
+                                node->values[ctx->editNodeType].valueText[i - 1] = '\0';
                                 break;
                             }
                         }
 
-                        node->output.data[editNodeType].valueText[MAX_NODE_LENGTH - 1] = '\0';
+                        node->values[ctx->editNodeType].valueText[MAX_NODE_LENGTH - 1] = '\0';
 
                         UpdateNodeShapes(node);
                     }
                     else if (charac == KEY_ENTER)
                     {
                         // Check new node value requeriments (cannot be empty, ...)
-                        bool valuesCheck = (node->output.data[editNodeType].valueText[0] != '\0');
+                        bool valuesCheck = (node->values[ctx->editNodeType].valueText[0] != '\0');
                         if (valuesCheck)
                         {
-                            FStringToFloat(&node->output.data[editNodeType].value, (const char*)node->output.data[editNodeType].valueText);
-                            FFloatToString(node->output.data[editNodeType].valueText, node->output.data[editNodeType].value);
+                            FStringToFloat(&node->output.data[ctx->editNodeType], (const char*)node->values[ctx->editNodeType].valueText);
+                            FFloatToString(node->values[ctx->editNodeType].valueText, node->output.data[ctx->editNodeType]);
 
-                            CalculateValues();
+                            MarkNodeDirty(ctx, node);
                         }
                         else
                         {
-                            TraceLogFNode(false, "error when trying to change node id %i value due to invalid characters (%s)", node->id, node->output.data[editNodeType].valueText);
-                            for (int i = 0; i < MAX_NODE_LENGTH; i++) node->output.data[editNodeType].valueText[i] = editNodeText[i];
+                            TraceLogFNode(false, "error when trying to change node id %i value due to invalid characters (%s)", node->id, node->values[ctx->editNodeType].valueText);
+                            for (int i = 0; i < MAX_NODE_LENGTH; i++) node->values[ctx->editNodeType].valueText[i] = ctx->editNodeText[i];
                         }
 
                         UpdateNodeShapes(node);
-                        editNode = -1;
-                        editNodeType = -1;
-                        FNODE_FREE(editNodeText);
-                        usedMemory -= MAX_NODE_LENGTH;
-                        editNodeText = NULL;
+                        ctx->editNode = NULL_HANDLE;
+                        ctx->editNodeType = -1;
+                        FNODE_FREE(ctx->editNodeText);
+                        ctx->usedMemory -= MAX_NODE_LENGTH;
+                        ctx->editNodeText = NULL;
                     }
                     else
                     {
@@ -1770,9 +1617,9 @@ FNODEDEF void DrawNode(FNode node)
                         {
                             for (int i = 0; i < MAX_NODE_LENGTH; i++)
                             {
-                                if (node->output.data[editNodeType].valueText[i] == '\0')
+                                if (node->values[ctx->editNodeType].valueText[i] == '\0')
                                 {
-                                    node->output.data[editNodeType].valueText[i] = (char)charac;
+                                    node->values[ctx->editNodeType].valueText[i] = (char)charac;
                                     UpdateNodeShapes(node);
                                     break;
                                 }
@@ -1787,10 +1634,10 @@ FNODEDEF void DrawNode(FNode node)
         {
             for (int i = 0; i < node->output.dataCount; i++)
             {
-                if ((node->type >= FNODE_MATRIX) && (node->type <= FNODE_VECTOR4)) DrawRectangleLines(node->output.data[i].shape.x,node->output.data[i].shape.y, node->output.data[i].shape.width, node->output.data[i].shape.height, (((editNode == node->id) && (editNodeType == i)) ? BLACK : GRAY));
-                DrawText(node->output.data[i].valueText, node->output.data[i].shape.x + (node->output.data[i].shape.width - 
-                         MeasureText(node->output.data[i].valueText, 20))/2, node->output.data[i].shape.y + 
-                         node->output.data[i].shape.height/2 - 9, 20, DARKGRAY);
+                if ((node->type >= FNODE_MATRIX) && (node->type <= FNODE_VECTOR4)) DrawRectangleLines(node->values[i].shape.x,node->values[i].shape.y, node->values[i].shape.width, node->values[i].shape.height, (((ctx->editNode == handle) && (ctx->editNodeType == i)) ? BLACK : GRAY));
+                DrawText(node->values[i].valueText, node->values[i].shape.x + (node->values[i].shape.width - 
+                         MeasureText(node->values[i].valueText, 20))/2, node->values[i].shape.y + 
+                         node->values[i].shape.height/2 - 9, 20, DARKGRAY);
             }
         }
 
@@ -1807,13 +1654,13 @@ FNODEDEF void DrawNode(FNode node)
                 DrawRectangleLines(node->inputShape.x, node->inputShape.y, node->inputShape.width, node->inputShape.height, COLOR_INPUT_DISABLED_BORDER);
             }
             
-            if(CheckCollisionPointRec(GetMousePosition(), CameraToViewRec(node->inputShape, camera)))
+            if(CheckCollisionPointRec(GetMousePosition(), CameraToViewRec(node->inputShape, ctx->camera)))
                 DrawRectangleRec(node->inputShape, COLOR_INPUT_ADDITIVE);
         }
 
         if (node->outputShape.width > 0)
         {
-            DrawRectangleRec(node->outputShape, ((CheckCollisionPointRec(GetMousePosition(), CameraToViewRec(node->outputShape, camera)) ? LIGHTGRAY : GRAY)));
+            DrawRectangleRec(node->outputShape, ((CheckCollisionPointRec(GetMousePosition(), CameraToViewRec(node->outputShape, ctx->camera)) ? LIGHTGRAY : GRAY)));
             DrawRectangleLines(node->outputShape.x, node->outputShape.y, node->outputShape.width, node->outputShape.height, BLACK);
         }
 
@@ -1826,37 +1673,37 @@ FNODEDEF void DrawNode(FNode node)
             "output(%i): %.02f, %.02f, %.02f, %.02f";
 
             DrawText(FormatText(string, node->id, node->name, node->inputsCount, node->inputsLimit, node->inputs[0], node->inputs[1], node->inputs[2], 
-            node->inputs[3], node->output.dataCount, node->output.data[0].value, node->output.data[1].value, node->output.data[2].value, node->output.data[3].value), node->shape.x, node->shape.y + node->shape.height + 5, 10, BLACK);
+            node->inputs[3], node->output.dataCount, node->output.data[0], node->output.data[1], node->output.data[2], node->output.data[3]), node->shape.x, node->shape.y + node->shape.height + 5, 10, BLACK);
         }
     }
     else TraceLogFNode(true, "error trying to draw a null referenced node");
 }
 
 // Draws a previously created node line
-FNODEDEF void DrawNodeLine(FLine line)
+FNODEDEF void DrawNodeLine(FNodeContext *ctx, FLine line)
 {
     if (line != NULL)
     {
         Vector2 from = { 0, 0 };
         Vector2 to = { 0, 0 };
 
-        int indexTo = -1;        
-        if (line->to != -1)
+        FNode toNode = NULL;
+        if (line->to != NULL_HANDLE)
         {
-            indexTo = GetNodeIndex(line->to);
-            
-            to.x = nodes[indexTo]->inputShape.x + nodes[indexTo]->inputShape.width/2;
-            to.y = nodes[indexTo]->inputShape.y + nodes[indexTo]->inputShape.height/2;
+            toNode = GetNodeFromHandle(ctx, line->to);
+
+            to.x = toNode->inputShape.x + toNode->inputShape.width/2;
+            to.y = toNode->inputShape.y + toNode->inputShape.height/2;
         }
-        else to = CameraToViewVector2(GetMousePosition(), camera);
+        else to = CameraToViewVector2(GetMousePosition(), ctx->camera);
 
-        int indexFrom = GetNodeIndex(line->from);
+        FNode fromNode = GetNodeFromHandle(ctx, line->from);
 
-        from.x = nodes[indexFrom]->outputShape.x + nodes[indexFrom]->outputShape.width/2;
-        from.y = nodes[indexFrom]->outputShape.y + nodes[indexFrom]->outputShape.height/2;
+        from.x = fromNode->outputShape.x + fromNode->outputShape.width/2;
+        from.y = fromNode->outputShape.y + fromNode->outputShape.height/2;
 
-        DrawCircle(from.x, from.y, 5, ((tempLine->id == line->id && tempLine->to == -1) ? DARKGRAY : BLACK));
-        DrawCircle(to.x, to.y, 5, ((tempLine->id == line->id && tempLine->to == -1) ? DARKGRAY : BLACK));
+        DrawCircle(from.x, from.y, 5, (((line == ctx->tempLine) && (line->to == NULL_HANDLE)) ? DARKGRAY : BLACK));
+        DrawCircle(to.x, to.y, 5, (((line == ctx->tempLine) && (line->to == NULL_HANDLE)) ? DARKGRAY : BLACK));
 
         if (from.x <= to.x)
         {
@@ -1872,7 +1719,7 @@ FNODEDEF void DrawNodeLine(FLine line)
                 toCurve.x = FEaseLinear(current, from.x, to.x - from.x, NODE_LINE_DIVISIONS);
                 toCurve.y = FEaseInOutQuad(current, from.y, to.y - from.y, NODE_LINE_DIVISIONS);
 
-                DrawLine(fromCurve.x, fromCurve.y, toCurve.x, toCurve.y, ((tempLine->id == line->id && tempLine->to == -1) ? DARKGRAY : BLACK));
+                DrawLine(fromCurve.x, fromCurve.y, toCurve.x, toCurve.y, (((line == ctx->tempLine) && (line->to == NULL_HANDLE)) ? DARKGRAY : BLACK));
             }
         }
         else
@@ -1882,73 +1729,73 @@ FNODEDEF void DrawNodeLine(FLine line)
             float radius = (fabs(to.y - from.y)/4 + 0.02f)*multiplier;
             float distance = FClamp(fabs(to.x - from.x)/100, 0.0f, 1.0f);
 
-            DrawLine(from.x, from.y, from.x, from.y, ((tempLine->id == line->id && tempLine->to == -1) ? DARKGRAY : BLACK));
+            DrawLine(from.x, from.y, from.x, from.y, (((line == ctx->tempLine) && (line->to == NULL_HANDLE)) ? DARKGRAY : BLACK));
 
             while (angle < 90)
             {
-                DrawLine(from.x + FCos(angle*DEG2RAD)*radius*multiplier*distance, from.y + radius + FSin(angle*DEG2RAD)*radius, from.x + FCos((angle + 10)*DEG2RAD)*radius*multiplier*distance, from.y + radius + FSin((angle + 10)*DEG2RAD)*radius, ((tempLine->id == line->id && tempLine->to == -1) ? DARKGRAY : BLACK));
+                DrawLine(from.x + FCos(angle*DEG2RAD)*radius*multiplier*distance, from.y + radius + FSin(angle*DEG2RAD)*radius, from.x + FCos((angle + 10)*DEG2RAD)*radius*multiplier*distance, from.y + radius + FSin((angle + 10)*DEG2RAD)*radius, (((line == ctx->tempLine) && (line->to == NULL_HANDLE)) ? DARKGRAY : BLACK));
                 angle += 10;
             }
 
             Vector2 lastPosition = { from.x, from.y + radius*2 };
-            DrawLine(lastPosition.x, lastPosition.y, to.x + FCos(270*DEG2RAD)*radius*multiplier, to.y - radius + FSin(270*DEG2RAD)*radius, ((tempLine->id == line->id && tempLine->to == -1) ? DARKGRAY : BLACK));
+            DrawLine(lastPosition.x, lastPosition.y, to.x + FCos(270*DEG2RAD)*radius*multiplier, to.y - radius + FSin(270*DEG2RAD)*radius, (((line == ctx->tempLine) && (line->to == NULL_HANDLE)) ? DARKGRAY : BLACK));
             lastPosition.x = to.x;
 
             while (angle < 270)
             {
-                DrawLine(to.x + FCos(angle*DEG2RAD)*radius*multiplier*distance, to.y - radius + FSin(angle*DEG2RAD)*radius, to.x + FCos((angle + 10)*DEG2RAD)*radius*multiplier*distance, to.y - radius + FSin((angle + 10)*DEG2RAD)*radius, ((tempLine->id == line->id && tempLine->to == -1) ? DARKGRAY : BLACK));
+                DrawLine(to.x + FCos(angle*DEG2RAD)*radius*multiplier*distance, to.y - radius + FSin(angle*DEG2RAD)*radius, to.x + FCos((angle + 10)*DEG2RAD)*radius*multiplier*distance, to.y - radius + FSin((angle + 10)*DEG2RAD)*radius, (((line == ctx->tempLine) && (line->to == NULL_HANDLE)) ? DARKGRAY : BLACK));
                 angle += 10;
             }
 
             lastPosition.y = lastPosition.y + radius*2;
-            DrawLine(to.x, to.y, to.x, to.y, ((tempLine->id == line->id && tempLine->to == -1) ? DARKGRAY : BLACK));
+            DrawLine(to.x, to.y, to.x, to.y, (((line == ctx->tempLine) && (line->to == NULL_HANDLE)) ? DARKGRAY : BLACK));
         }
 
-        if (indexFrom != -1 && indexTo != -1)
+        if ((fromNode != NULL) && (toNode != NULL))
         {
-            switch (nodes[indexTo]->type)
+            switch (toNode->type)
             {
                 case FNODE_POWER:
                 {
-                    if ((nodes[indexTo]->inputsCount > 0) && (nodes[indexTo]->inputs[0] == nodes[indexFrom]->id)) DrawText("Input", from.x + 5, from.y - 30, 10, BLACK);
-                    else if ((nodes[indexTo]->inputsCount > 1) && (nodes[indexTo]->inputs[1] == nodes[indexFrom]->id)) DrawText("Exponent", from.x + 5, from.y - 30, 10, BLACK);
+                    if ((toNode->inputsCount > 0) && (toNode->inputs[0] == fromNode->id)) DrawText("Input", from.x + 5, from.y - 30, 10, BLACK);
+                    else if ((toNode->inputsCount > 1) && (toNode->inputs[1] == fromNode->id)) DrawText("Exponent", from.x + 5, from.y - 30, 10, BLACK);
                 } break;
                 case FNODE_STEP:
                 {
-                    if ((nodes[indexTo]->inputsCount > 0) && (nodes[indexTo]->inputs[0] == nodes[indexFrom]->id)) DrawText("Value A", from.x + 5, from.y - 30, 10, BLACK);
-                    else if ((nodes[indexTo]->inputsCount > 1) && (nodes[indexTo]->inputs[1] == nodes[indexFrom]->id)) DrawText("Value B", from.x + 5, from.y - 30, 10, BLACK);
+                    if ((toNode->inputsCount > 0) && (toNode->inputs[0] == fromNode->id)) DrawText("Value A", from.x + 5, from.y - 30, 10, BLACK);
+                    else if ((toNode->inputsCount > 1) && (toNode->inputs[1] == fromNode->id)) DrawText("Value B", from.x + 5, from.y - 30, 10, BLACK);
                 } break;
                 case FNODE_POSTERIZE:
                 {
-                    if ((nodes[indexTo]->inputsCount > 0) && (nodes[indexTo]->inputs[0] == nodes[indexFrom]->id)) DrawText("Input", from.x + 5, from.y - 30, 10, BLACK);
-                    else if ((nodes[indexTo]->inputsCount > 1) && (nodes[indexTo]->inputs[1] == nodes[indexFrom]->id)) DrawText("Samples", from.x + 5, from.y - 30, 10, BLACK);
+                    if ((toNode->inputsCount > 0) && (toNode->inputs[0] == fromNode->id)) DrawText("Input", from.x + 5, from.y - 30, 10, BLACK);
+                    else if ((toNode->inputsCount > 1) && (toNode->inputs[1] == fromNode->id)) DrawText("Samples", from.x + 5, from.y - 30, 10, BLACK);
                 } break;
                 case FNODE_LERP:
                 {
-                    if ((nodes[indexTo]->inputsCount > 0) && (nodes[indexTo]->inputs[0] == nodes[indexFrom]->id)) DrawText("Value A", from.x + 5, from.y - 30, 10, BLACK);
-                    else if ((nodes[indexTo]->inputsCount > 1) && (nodes[indexTo]->inputs[1] == nodes[indexFrom]->id)) DrawText("Value B", from.x + 5, from.y - 30, 10, BLACK);
-                    else if ((nodes[indexTo]->inputsCount > 2) && (nodes[indexTo]->inputs[2] == nodes[indexFrom]->id)) DrawText("Time", from.x + 5, from.y - 30, 10, BLACK);
+                    if ((toNode->inputsCount > 0) && (toNode->inputs[0] == fromNode->id)) DrawText("Value A", from.x + 5, from.y - 30, 10, BLACK);
+                    else if ((toNode->inputsCount > 1) && (toNode->inputs[1] == fromNode->id)) DrawText("Value B", from.x + 5, from.y - 30, 10, BLACK);
+                    else if ((toNode->inputsCount > 2) && (toNode->inputs[2] == fromNode->id)) DrawText("Time", from.x + 5, from.y - 30, 10, BLACK);
                 } break;
                 case FNODE_SMOOTHSTEP:
                 {
-                    if ((nodes[indexTo]->inputsCount > 0) && (nodes[indexTo]->inputs[0] == nodes[indexFrom]->id)) DrawText("Min", from.x + 5, from.y - 30, 10, BLACK);
-                    else if ((nodes[indexTo]->inputsCount > 1) && (nodes[indexTo]->inputs[1] == nodes[indexFrom]->id)) DrawText("Max", from.x + 5, from.y - 30, 10, BLACK);
-                    else if ((nodes[indexTo]->inputsCount > 2) && (nodes[indexTo]->inputs[2] == nodes[indexFrom]->id)) DrawText("Value", from.x + 5, from.y - 30, 10, BLACK);
+                    if ((toNode->inputsCount > 0) && (toNode->inputs[0] == fromNode->id)) DrawText("Min", from.x + 5, from.y - 30, 10, BLACK);
+                    else if ((toNode->inputsCount > 1) && (toNode->inputs[1] == fromNode->id)) DrawText("Max", from.x + 5, from.y - 30, 10, BLACK);
+                    else if ((toNode->inputsCount > 2) && (toNode->inputs[2] == fromNode->id)) DrawText("Value", from.x + 5, from.y - 30, 10, BLACK);
                 } break;
                 case FNODE_DESATURATE:
                 {
-                    if ((nodes[indexTo]->inputsCount > 0) && (nodes[indexTo]->inputs[0] == nodes[indexFrom]->id)) DrawText("Value", from.x + 5, from.y - 30, 10, BLACK);
-                    else if ((nodes[indexTo]->inputsCount > 1) && (nodes[indexTo]->inputs[1] == nodes[indexFrom]->id)) DrawText("Amount (0-1)", from.x + 5, from.y - 30, 10, BLACK);
+                    if ((toNode->inputsCount > 0) && (toNode->inputs[0] == fromNode->id)) DrawText("Value", from.x + 5, from.y - 30, 10, BLACK);
+                    else if ((toNode->inputsCount > 1) && (toNode->inputs[1] == fromNode->id)) DrawText("Amount (0-1)", from.x + 5, from.y - 30, 10, BLACK);
                 } break;
                 case FNODE_MULTIPLYMATRIX:
                 {
-                    if ((nodes[indexTo]->inputsCount > 0) && (nodes[indexTo]->inputs[0] == nodes[indexFrom]->id)) DrawText("Left", from.x + 5, from.y - 30, 10, BLACK);
-                    else if ((nodes[indexTo]->inputsCount > 1) && (nodes[indexTo]->inputs[1] == nodes[indexFrom]->id)) DrawText("Right", from.x + 5, from.y - 30, 10, BLACK);
+                    if ((toNode->inputsCount > 0) && (toNode->inputs[0] == fromNode->id)) DrawText("Left", from.x + 5, from.y - 30, 10, BLACK);
+                    else if ((toNode->inputsCount > 1) && (toNode->inputs[1] == fromNode->id)) DrawText("Right", from.x + 5, from.y - 30, 10, BLACK);
                 } break;
                 case FNODE_SAMPLER2D:
                 {
-                    if ((nodes[indexTo]->inputsCount > 0) && (nodes[indexTo]->inputs[0] == nodes[indexFrom]->id)) DrawText("Unit", from.x + 5, from.y - 30, 10, BLACK);
-                    else if ((nodes[indexTo]->inputsCount > 1) && (nodes[indexTo]->inputs[1] == nodes[indexFrom]->id)) DrawText("Type", from.x + 5, from.y - 30, 10, BLACK);
+                    if ((toNode->inputsCount > 0) && (toNode->inputs[0] == fromNode->id)) DrawText("Unit", from.x + 5, from.y - 30, 10, BLACK);
+                    else if ((toNode->inputsCount > 1) && (toNode->inputs[1] == fromNode->id)) DrawText("Type", from.x + 5, from.y - 30, 10, BLACK);
                 } break;
                 default: break;
             }
@@ -1958,35 +1805,35 @@ FNODEDEF void DrawNodeLine(FLine line)
 }
 
 // Draws a previously created comment
-FNODEDEF void DrawComment(FComment comment)
+FNODEDEF void DrawComment(FNodeContext *ctx, FComment comment)
 {
     if (comment != NULL)
     {
-        if ((commentState == 0) || ((commentState == 1) && (tempComment->id != comment->id)) || ((commentState == 1) && editSize != -1)) DrawRectangleRec(comment->shape, Fade(YELLOW, 0.2f));
+        if ((ctx->commentState == 0) || ((ctx->commentState == 1) && (ctx->tempComment->id != comment->id)) || ((ctx->commentState == 1) && ctx->editSize != -1)) DrawRectangleRec(comment->shape, Fade(YELLOW, 0.2f));
 
         DrawRectangleLines(comment->shape.x, comment->shape.y, comment->shape.width, comment->shape.height, BLACK);
 
-        if ((commentState == 0) || ((commentState == 1) && (tempComment->id != comment->id)) || ((commentState == 1) && editSize != -1))
+        if ((ctx->commentState == 0) || ((ctx->commentState == 1) && (ctx->tempComment->id != comment->id)) || ((ctx->commentState == 1) && ctx->editSize != -1))
         {
-            DrawRectangleRec(comment->sizeTShape, ((CheckCollisionPointRec(GetMousePosition(), CameraToViewRec(comment->sizeTShape, camera))) ? LIGHTGRAY : GRAY));
+            DrawRectangleRec(comment->sizeTShape, ((CheckCollisionPointRec(GetMousePosition(), CameraToViewRec(comment->sizeTShape, ctx->camera))) ? LIGHTGRAY : GRAY));
             DrawRectangleLines(comment->sizeTShape.x, comment->sizeTShape.y, comment->sizeTShape.width, comment->sizeTShape.height, BLACK);
-            DrawRectangleRec(comment->sizeBShape, ((CheckCollisionPointRec(GetMousePosition(), CameraToViewRec(comment->sizeBShape, camera))) ? LIGHTGRAY : GRAY));
+            DrawRectangleRec(comment->sizeBShape, ((CheckCollisionPointRec(GetMousePosition(), CameraToViewRec(comment->sizeBShape, ctx->camera))) ? LIGHTGRAY : GRAY));
             DrawRectangleLines(comment->sizeBShape.x, comment->sizeBShape.y, comment->sizeBShape.width, comment->sizeBShape.height, BLACK);
-            DrawRectangleRec(comment->sizeLShape, ((CheckCollisionPointRec(GetMousePosition(), CameraToViewRec(comment->sizeLShape, camera))) ? LIGHTGRAY : GRAY));
+            DrawRectangleRec(comment->sizeLShape, ((CheckCollisionPointRec(GetMousePosition(), CameraToViewRec(comment->sizeLShape, ctx->camera))) ? LIGHTGRAY : GRAY));
             DrawRectangleLines(comment->sizeLShape.x, comment->sizeLShape.y, comment->sizeLShape.width, comment->sizeLShape.height, BLACK);
-            DrawRectangleRec(comment->sizeRShape, ((CheckCollisionPointRec(GetMousePosition(), CameraToViewRec(comment->sizeRShape, camera))) ? LIGHTGRAY : GRAY));
+            DrawRectangleRec(comment->sizeRShape, ((CheckCollisionPointRec(GetMousePosition(), CameraToViewRec(comment->sizeRShape, ctx->camera))) ? LIGHTGRAY : GRAY));
             DrawRectangleLines(comment->sizeRShape.x, comment->sizeRShape.y, comment->sizeRShape.width, comment->sizeRShape.height, BLACK);
-            DrawRectangleRec(comment->sizeTlShape, ((CheckCollisionPointRec(GetMousePosition(), CameraToViewRec(comment->sizeTlShape, camera))) ? LIGHTGRAY : GRAY));
+            DrawRectangleRec(comment->sizeTlShape, ((CheckCollisionPointRec(GetMousePosition(), CameraToViewRec(comment->sizeTlShape, ctx->camera))) ? LIGHTGRAY : GRAY));
             DrawRectangleLines(comment->sizeTlShape.x, comment->sizeTlShape.y, comment->sizeTlShape.width, comment->sizeTlShape.height, BLACK);
-            DrawRectangleRec(comment->sizeTrShape, ((CheckCollisionPointRec(GetMousePosition(), CameraToViewRec(comment->sizeTrShape, camera))) ? LIGHTGRAY : GRAY));
+            DrawRectangleRec(comment->sizeTrShape, ((CheckCollisionPointRec(GetMousePosition(), CameraToViewRec(comment->sizeTrShape, ctx->camera))) ? LIGHTGRAY : GRAY));
             DrawRectangleLines(comment->sizeTrShape.x, comment->sizeTrShape.y, comment->sizeTrShape.width, comment->sizeTrShape.height, BLACK);
-            DrawRectangleRec(comment->sizeBlShape, ((CheckCollisionPointRec(GetMousePosition(), CameraToViewRec(comment->sizeBlShape, camera))) ? LIGHTGRAY : GRAY));
+            DrawRectangleRec(comment->sizeBlShape, ((CheckCollisionPointRec(GetMousePosition(), CameraToViewRec(comment->sizeBlShape, ctx->camera))) ? LIGHTGRAY : GRAY));
             DrawRectangleLines(comment->sizeBlShape.x, comment->sizeBlShape.y, comment->sizeBlShape.width, comment->sizeBlShape.height, BLACK);
-            DrawRectangleRec(comment->sizeBrShape, ((CheckCollisionPointRec(GetMousePosition(), CameraToViewRec(comment->sizeBrShape, camera))) ? LIGHTGRAY : GRAY));
+            DrawRectangleRec(comment->sizeBrShape, ((CheckCollisionPointRec(GetMousePosition(), CameraToViewRec(comment->sizeBrShape, ctx->camera))) ? LIGHTGRAY : GRAY));
             DrawRectangleLines(comment->sizeBrShape.x, comment->sizeBrShape.y, comment->sizeBrShape.width, comment->sizeBrShape.height, BLACK);
         }
 
-        if ((comment->id == editComment) && interact)
+        if ((comment->id == ctx->editComment) && interact)
         {
             int letter = -1;
             letter = GetKeyPressed();
@@ -2006,7 +1853,7 @@ FNODEDEF void DrawComment(FComment comment)
 
                     comment->value[MAX_COMMENT_LENGTH - 1] = '\0';
                 }
-                else if (letter == KEY_ENTER) editComment = -1;
+                else if (letter == KEY_ENTER) ctx->editComment = -1;
                 else
                 {
                     if ((letter >= 32) && (letter < 127))
@@ -2024,7 +1871,7 @@ FNODEDEF void DrawComment(FComment comment)
             }
         }
 
-        DrawRectangleLines(comment->valueShape.x, comment->valueShape.y, comment->valueShape.width, comment->valueShape.height, ((editComment == comment->id) ? BLACK : LIGHTGRAY));
+        DrawRectangleLines(comment->valueShape.x, comment->valueShape.y, comment->valueShape.width, comment->valueShape.height, ((ctx->editComment == comment->id) ? BLACK : LIGHTGRAY));
 
         int initPos = comment->shape.x + 14;
         for (int i = 0; i < MAX_COMMENT_LENGTH; i++)
@@ -2039,72 +1886,64 @@ FNODEDEF void DrawComment(FComment comment)
 }
 
 // Destroys a node and its linked lines
-FNODEDEF void DestroyNode(FNode node)
+FNODEDEF void DestroyNode(FNodeContext *ctx, FNode node)
 {
     if (node != NULL)
     {
         int id = node->id;
-        int index = GetNodeIndex(id);
-
-        for (int i = linesCount - 1; i >= 0; i--)
-        {
-            if (lines[i]->from == node->id || lines[i]->to == node->id) DestroyNodeLine(lines[i]);
-        }
-
-        for (int i = 0; i < MAX_VALUES; i++)
-        {
-           FNODE_FREE(nodes[index]->output.data[i].valueText);
-           usedMemory -= MAX_NODE_LENGTH;
-           nodes[index]->output.data[i].valueText = NULL;
-        }
-
-        FNODE_FREE(nodes[index]);
-        usedMemory -= sizeof(FNodeData);
-        nodes[index] = NULL;
-
-        for (int i = index; i < nodesCount; i++)
-        {
-            if ((i + 1) < nodesCount) nodes[i] = nodes[i + 1];
-        }
-
-        nodesCount--;
-        TraceLogFNode(false, "destroyed node id %i (index: %i) [USED RAM: %i bytes]", id, index, usedMemory);
-        CalculateValues();
+        int index = GetNodeIndex(ctx, id);
+
+        // Destroy linked lines from node adjacency lists
+        while (node->inputsCount > 0) DestroyNodeLine(ctx, node->inputLines[node->inputsCount - 1]);
+        while (node->outputLines != NULL) DestroyNodeLine(ctx, node->outputLines);
+
+        ctx->nodesOrder[node->drawIndex] = NULL;
+        ArenaFree(&ctx->valuesArena, node->values);
+        ArenaFree(&ctx->nodesArena, node);
+        ctx->nodesIndex[id] = -1;
+        ctx->nodesGenerations[id] = NextHandleGeneration(ctx->nodesGenerations[id]);
+        ReleaseId(&ctx->nodesIds, id);
+
+        // Move last pool node to the destroyed node index
+        ctx->nodesCount--;
+        ctx->nodes[index] = ctx->nodes[ctx->nodesCount];
+        ctx->nodes[ctx->nodesCount] = NULL;
+        if (index < ctx->nodesCount) ctx->nodesIndex[ctx->nodes[index]->id] = index;
+
+        ctx->graphDirty = true;
+        ctx->scheduleDirty = true;
+        TraceLogFNode(false, "destroyed node id %i (index: %i) [USED RAM: %i bytes]", id, index, ctx->usedMemory);
     }
     else TraceLogFNode(true, "error trying to destroy a null referenced node");
 }
 
 // Destroys a node line
-FNODEDEF void DestroyNodeLine(FLine line)
+FNODEDEF void DestroyNodeLine(FNodeContext *ctx, FLine line)
 {
     if (line != NULL)
     {
         int id = line->id;
-        int index = -1;
-
-        for (int i = 0; i < linesCount; i++)
-        {
-            if (lines[i]->id == id)
-            {
-                index = i;
-                break;
-            }
-        }
+        int index = (((id >= 0) && (id < ctx->linesCapacity)) ? ctx->linesIndex[id] : -1);
 
         if (index != -1)
-        {        
-            FNODE_FREE(lines[index]);
-            usedMemory -= sizeof(FLineData);
-            lines[index] = NULL;
-
-            for (int i = index; i < linesCount; i++)
-            {
-                if ((i + 1) < linesCount) lines[i] = lines[i + 1];
-            }
-
-            linesCount--;
-            TraceLogFNode(false, "destroyed line id %i (index: %i) [USED RAM: %i bytes]", id, index, usedMemory);
-            CalculateValues();
+        {
+            if (line->to != NULL_HANDLE) UnlinkNodeLine(ctx, line);
+            if (line == ctx->tempLine) ctx->tempLine = NULL;
+
+            ArenaFree(&ctx->linesArena, line);
+            ctx->linesIndex[id] = -1;
+            ctx->linesGenerations[id] = NextHandleGeneration(ctx->linesGenerations[id]);
+            ReleaseId(&ctx->linesIds, id);
+
+            // Move last pool line to the destroyed line index
+            ctx->linesCount--;
+            ctx->lines[index] = ctx->lines[ctx->linesCount];
+            ctx->lines[ctx->linesCount] = NULL;
+            if (index < ctx->linesCount) ctx->linesIndex[ctx->lines[index]->id] = index;
+
+            ctx->graphDirty = true;
+            ctx->scheduleDirty = true;
+            TraceLogFNode(false, "destroyed line id %i (index: %i) [USED RAM: %i bytes]", id, index, ctx->usedMemory);
         }
         else TraceLogFNode(true, "error when trying to destroy line id %i due to index is out of bounds %i", id, index);
     }
@@ -2112,16 +1951,16 @@ FNODEDEF void DestroyNodeLine(FLine line)
 }
 
 // Destroys a comment
-FNODEDEF void DestroyComment(FComment comment)
+FNODEDEF void DestroyComment(FNodeContext *ctx, FComment comment)
 {
     if (comment != NULL)
     {
         int id = comment->id;
         int index = -1;
 
-        for (int i = 0; i < commentsCount; i++)
+        for (int i = 0; i < ctx->commentsCount; i++)
         {
-            if (comments[i]->id == id)
+            if (ctx->comments[i]->id == id)
             {
                 index = i;
                 break;
@@ -2130,90 +1969,135 @@ FNODEDEF void DestroyComment(FComment comment)
 
         if (index != -1)
         {
-            FNODE_FREE(comments[index]->value);
-            usedMemory -= MAX_COMMENT_LENGTH;
-            comments[index]->value = NULL;
+            ArenaFree(&ctx->commentsArena, ctx->comments[index]);
+            ctx->comments[index] = NULL;
+            ReleaseId(&ctx->commentsIds, id);
 
-            FNODE_FREE(comments[index]);
-            usedMemory -= sizeof(FCommentData);
-            comments[index] = NULL;
-
-            for (int i = index; i < commentsCount; i++)
+            for (int i = index; i < ctx->commentsCount; i++)
             {
-                if ((i + 1) < commentsCount) comments[i] = comments[i + 1];
+                if ((i + 1) < ctx->commentsCount) ctx->comments[i] = ctx->comments[i + 1];
             }
 
-            commentsCount--;
+            ctx->commentsCount--;
 
-            TraceLogFNode(false, "destroyed comment id %i (index: %i) [USED RAM: %i bytes]", id, index, usedMemory);
+            TraceLogFNode(false, "destroyed comment id %i (index: %i) [USED RAM: %i bytes]", id, index, ctx->usedMemory);
         }
         else TraceLogFNode(true, "error when trying to destroy comment id %i due to index is out of bounds %i", id, index);
     }
     else TraceLogFNode(true, "error trying to destroy a null referenced comment");
 }
 
-// Unitializes FNode global variables
-FNODEDEF void CloseFNode()
+// Destroys all nodes, lines and comments releasing their memory at once
+FNODEDEF void ClearFNodeGraph(FNodeContext *ctx)
 {
-    for (int i = 0; i < nodesCount; i++)
+    for (int i = 0; i < ctx->nodesCount; i++)
     {
-        if (nodes[i] != NULL)
-        {
-            for (int k = 0; k < MAX_VALUES; k++)
-            {
-                if (nodes[i]->output.data[k].valueText != NULL)
-                {
-                    FNODE_FREE(nodes[i]->output.data[k].valueText);
-                    usedMemory -= MAX_NODE_LENGTH;
-                    nodes[i]->output.data[k].valueText = NULL;
-                }
-            }
-
-            FNODE_FREE(nodes[i]);
-            usedMemory -= sizeof(FNodeData);
-            nodes[i] = NULL;
-        }
+        ctx->nodesIndex[ctx->nodes[i]->id] = -1;
+        ctx->nodesGenerations[ctx->nodes[i]->id] = NextHandleGeneration(ctx->nodesGenerations[ctx->nodes[i]->id]);
+        ctx->nodes[i] = NULL;
     }
 
-    for (int i = 0; i < linesCount; i++)
+    for (int i = 0; i < ctx->linesCount; i++)
     {
-        if (lines[i] != NULL)
-        {
-            FNODE_FREE(lines[i]);
-            usedMemory -= sizeof(FLineData);
-            lines[i] = NULL;
-        }
+        ctx->linesIndex[ctx->lines[i]->id] = -1;
+        ctx->linesGenerations[ctx->lines[i]->id] = NextHandleGeneration(ctx->linesGenerations[ctx->lines[i]->id]);
+        ctx->lines[i] = NULL;
     }
 
-    for (int i = 0; i < commentsCount; i++)
+    for (int i = 0; i < ctx->commentsCount; i++) ctx->comments[i] = NULL;
+    for (int i = 0; i < ctx->selectedCommentNodesCount; i++) ctx->selectedCommentNodes[i] = NULL_HANDLE;
+
+    ctx->nodesCount = 0;
+    ctx->nodesOrderCount = 0;
+    ctx->nodesScheduleCount = 0;
+    ctx->nodesScheduleAcyclicCount = 0;
+    ctx->levelsCount = 0;
+    ctx->nextRank = 0;
+    ctx->scheduleDirty = true;
+    ctx->linesCount = 0;
+    ctx->commentsCount = 0;
+    ctx->selectedCommentNodesCount = 0;
+    ctx->selectedNode = NULL_HANDLE;
+    ctx->selectedComment = -1;
+    ctx->tempLine = NULL;
+    ctx->tempComment = NULL;
+    ctx->lineState = 0;
+    ctx->commentState = 0;
+
+    if (ctx->editNodeText != NULL)
     {
-        if ((comments[i] != NULL) && (comments[i]->value != NULL))
-        {
-            FNODE_FREE(comments[i]->value);
-            usedMemory -= MAX_COMMENT_LENGTH;
-            comments[i]->value = NULL;
-
-            FNODE_FREE(comments[i]);
-            usedMemory -= sizeof(FCommentData);
-            comments[i] = NULL;
-        }
+        FNODE_FREE(ctx->editNodeText);
+        ctx->usedMemory -= MAX_NODE_LENGTH;
+        ctx->editNodeText = NULL;
     }
 
-    if (editNodeText != NULL)
-    {
-        FNODE_FREE(editNodeText);
-        usedMemory -= MAX_NODE_LENGTH;
-        editNodeText = NULL;
-    }
+    ctx->editNode = NULL_HANDLE;
+    ctx->editNodeType = -1;
 
-    nodesCount = 0;
-    linesCount = 0;
-    commentsCount = 0;
-    selectedCommentNodesCount = 0;
+    // Recycle all ids and release all entities memory chunks
+    ResetIdAllocator(&ctx->nodesIds);
+    ResetIdAllocator(&ctx->linesIds);
+    ResetIdAllocator(&ctx->commentsIds);
 
-    for (int i = 0; i < MAX_NODES; i++) selectedCommentNodes[i] = -1;
+    ResetArena(ctx, &ctx->nodesArena);
+    ResetArena(ctx, &ctx->valuesArena);
+    ResetArena(ctx, &ctx->linesArena);
+    ResetArena(ctx, &ctx->commentsArena);
+
+    TraceLogFNode(false, "graph cleared [USED RAM: %i bytes]", ctx->usedMemory);
+}
+
+// Destroys a nodes graph context releasing all its memory
+FNODEDEF void DestroyFNodeContext(FNodeContext *ctx)
+{
+    ClearFNodeGraph(ctx);
+
+    // Release entities pools
+    ctx->nodes = (FNode *)FResizeArray(ctx, ctx->nodes, ctx->nodesCapacity*sizeof(FNode), 0);
+    ctx->nodesIndex = (int *)FResizeArray(ctx, ctx->nodesIndex, ctx->nodesCapacity*sizeof(int), 0);
+    ctx->nodesGenerations = (unsigned short *)FResizeArray(ctx, ctx->nodesGenerations, ctx->nodesCapacity*sizeof(unsigned short), 0);
+    ctx->nodesDeclared = (bool *)FResizeArray(ctx, ctx->nodesDeclared, ctx->nodesCapacity*sizeof(bool), 0);
+    ctx->selectedCommentNodes = (FHandle *)FResizeArray(ctx, ctx->selectedCommentNodes, ctx->nodesCapacity*sizeof(FHandle), 0);
+    ctx->nodesOrder = (FNode *)FResizeArray(ctx, ctx->nodesOrder, 2*ctx->nodesCapacity*sizeof(FNode), 0);
+    ctx->nodesSchedule = (FNode *)FResizeArray(ctx, ctx->nodesSchedule, ctx->nodesCapacity*sizeof(FNode), 0);
+    ctx->nodesPendingInputs = (int *)FResizeArray(ctx, ctx->nodesPendingInputs, ctx->nodesCapacity*sizeof(int), 0);
+    ctx->reachStack = (FNode *)FResizeArray(ctx, ctx->reachStack, ctx->nodesCapacity*sizeof(FNode), 0);
+    ctx->rankRegion = (FNode *)FResizeArray(ctx, ctx->rankRegion, ctx->nodesCapacity*sizeof(FNode), 0);
+    ctx->rankRegionRanks = (int *)FResizeArray(ctx, ctx->rankRegionRanks, ctx->nodesCapacity*sizeof(int), 0);
+#if defined(FNODE_PARALLEL)
+    ctx->levelsPositions = (int *)FResizeArray(ctx, ctx->levelsPositions, ctx->nodesCapacity*sizeof(int), 0);
+    ctx->levelsEnd = (int *)FResizeArray(ctx, ctx->levelsEnd, ctx->nodesCapacity*sizeof(int), 0);
+
+    if (ctx->workers != NULL) DestroyWorkers(ctx, ctx->workers);
+#endif
+    ctx->nodesTape = (FInstruction *)FResizeArray(ctx, ctx->nodesTape, ctx->nodesCapacity*sizeof(FInstruction), 0);
+    ctx->registers = (FNodeOutput *)FResizeArray(ctx, ctx->registers, ctx->nodesCapacity*sizeof(FNodeOutput), 0);
+    ctx->nodesEquivalent = (int *)FResizeArray(ctx, ctx->nodesEquivalent, ctx->nodesCapacity*sizeof(int), 0);
+    ctx->hashTable = (int *)FResizeArray(ctx, ctx->hashTable, 2*ctx->nodesCapacity*sizeof(int), 0);
+    ctx->lines = (FLine *)FResizeArray(ctx, ctx->lines, ctx->linesCapacity*sizeof(FLine), 0);
+    ctx->linesIndex = (int *)FResizeArray(ctx, ctx->linesIndex, ctx->linesCapacity*sizeof(int), 0);
+    ctx->linesGenerations = (unsigned short *)FResizeArray(ctx, ctx->linesGenerations, ctx->linesCapacity*sizeof(unsigned short), 0);
+    ctx->comments = (FComment *)FResizeArray(ctx, ctx->comments, ctx->commentsCapacity*sizeof(FComment), 0);
+
+    CloseIdAllocator(ctx, &ctx->nodesIds);
+    CloseIdAllocator(ctx, &ctx->linesIds);
+    CloseIdAllocator(ctx, &ctx->commentsIds);
+
+    TraceLogFNode(false, "nodes graph context destroyed [USED RAM: %i bytes]", ctx->usedMemory);
+
+    FNODE_FREE(ctx);
+}
+
+// Unitializes FNode default context
+FNODEDEF void CloseFNode()
+{
+    if (defaultContext != NULL)
+    {
+        DestroyFNodeContext(defaultContext);
+        defaultContext = NULL;
+    }
 
-    TraceLogFNode(false, "unitialization complete [USED RAM: %i bytes]", usedMemory);
+    TraceLogFNode(false, "unitialization complete");
 }
 
 // Outputs a trace log message
@@ -2260,67 +2144,2091 @@ FNODEDEF int FSearch(char *filename, char *string)
 //----------------------------------------------------------------------------------
 // Module Internal Functions Definition
 //----------------------------------------------------------------------------------
-// Returns length of a Vector2
-static float FVector2Length(Vector2 v)
+// Initializes an id allocator with an ids capacity
+static void InitIdAllocator(FNodeContext *ctx, FIdAllocator *allocator, int capacity)
 {
-    return (float)sqrt(v.x*v.x + v.y*v.y);
+    int wordsCount = (capacity + 31)/32;
+
+    allocator->bits = (unsigned int *)FNODE_MALLOC(wordsCount*sizeof(unsigned int));
+    if (allocator->bits == NULL) TraceLogFNode(true, "id allocator initialization failed when trying to allocate %i bytes", (int)(wordsCount*sizeof(unsigned int)));
+    ctx->usedMemory += wordsCount*sizeof(unsigned int);
+    for (int i = 0; i < wordsCount; i++) allocator->bits[i] = 0;
+
+    allocator->capacity = capacity;
+    allocator->firstFree = 0;
 }
 
-// Returns length of a Vector3
-static float FVector3Length(Vector3 v)
+// Returns the lowest free id of an id allocator (-1 if there is any available id)
+static int AllocateId(FIdAllocator *allocator)
 {
-    return (float)sqrt(v.x*v.x + v.y*v.y + v.z*v.z);
+    int id = -1;
+    int wordsCount = (allocator->capacity + 31)/32;
+
+    // Skip full words, all words below first free one are known to be full
+    while ((allocator->firstFree < wordsCount) && (allocator->bits[allocator->firstFree] == 0xffffffff)) allocator->firstFree++;
+
+    if (allocator->firstFree < wordsCount)
+    {
+        unsigned int word = allocator->bits[allocator->firstFree];
+        int bit = 0;
+
+#if defined(__GNUC__)
+        bit = __builtin_ctz(~word);
+#else
+        while (word & (1u << bit)) bit++;
+#endif
+
+        if ((allocator->firstFree*32 + bit) < allocator->capacity)
+        {
+            id = allocator->firstFree*32 + bit;
+            allocator->bits[allocator->firstFree] |= (1u << bit);
+        }
+    }
+
+    return id;
 }
 
-// Returns length of a Vector4
-static float FVector4Length(Vector4 v)
+// Releases an id to be recycled by an id allocator
+static void ReleaseId(FIdAllocator *allocator, int id)
 {
-    return (float)sqrt(v.x*v.x + v.y*v.y + v.z*v.z + v.w*v.w);
+    if ((id >= 0) && (id < allocator->capacity))
+    {
+        allocator->bits[id/32] &= ~(1u << (id%32));
+        if ((id/32) < allocator->firstFree) allocator->firstFree = id/32;
+    }
 }
 
-// Returns a normalized Vector2
-static Vector2 FVector2Normalize(Vector2 v)
+// Increases the ids capacity of an id allocator
+static void GrowIdAllocator(FNodeContext *ctx, FIdAllocator *allocator, int capacity)
 {
-    float length = FVector2Length(v);
-    return (Vector2){ v.x/length, v.y/length };
+    int wordsCount = (allocator->capacity + 31)/32;
+    int newWordsCount = (capacity + 31)/32;
+
+    allocator->bits = (unsigned int *)FResizeArray(ctx, allocator->bits, wordsCount*sizeof(unsigned int), newWordsCount*sizeof(unsigned int));
+    for (int i = wordsCount; i < newWordsCount; i++) allocator->bits[i] = 0;
+
+    allocator->capacity = capacity;
 }
 
-// Returns a normalized Vector3
-static Vector3 FVector3Normalize(Vector3 v)
+// Releases all the ids of an id allocator
+static void ResetIdAllocator(FIdAllocator *allocator)
 {
-    float length = FVector3Length(v);
-    return (Vector3){ v.x/length, v.y/length, v.z/length };
+    for (int i = 0; i < (allocator->capacity + 31)/32; i++) allocator->bits[i] = 0;
+    allocator->firstFree = 0;
 }
 
-// Returns a normalized Vector4
-static Vector4 FVector4Normalize(Vector4 v)
+// Unitializes an id allocator
+static void CloseIdAllocator(FNodeContext *ctx, FIdAllocator *allocator)
 {
-    float length = FVector4Length(v);
-    return (Vector4){ v.x/length, v.y/length, v.z/length, v.w/length };
+    if (allocator->bits != NULL)
+    {
+        FNODE_FREE(allocator->bits);
+        ctx->usedMemory -= ((allocator->capacity + 31)/32)*sizeof(unsigned int);
+        allocator->bits = NULL;
+    }
+
+    allocator->capacity = 0;
+    allocator->firstFree = 0;
 }
 
-// Returns the projection vector of two Vector2
-static Vector2 FVector2Projection(Vector2 a, Vector2 b)
+// Returns a new allocated array with the content of an array, which is released
+static void *FResizeArray(FNodeContext *ctx, void *array, int size, int newSize)
 {
-    Vector2 output = { 0, 0 };
+    void *newArray = NULL;
 
-    float dotAB = FVector2Dot(a, b);
-    float dotBB = FVector2Dot(b, b);
-    output.x = dotAB/dotBB*b.x;
-    output.y = dotAB/dotBB*b.y;
+    if (newSize > 0)
+    {
+        newArray = FNODE_MALLOC(newSize);
+        if (newArray == NULL) TraceLogFNode(true, "array resize failed when trying to allocate %i bytes", newSize);
+        if (array != NULL) memcpy(newArray, array, (size < newSize) ? size : newSize);
+    }
 
-    return output;
+    if (array != NULL) FNODE_FREE(array);
+    ctx->usedMemory += newSize - size;
+
+    return newArray;
 }
 
-// Returns the projection vector of two Vector3
-static Vector3 FVector3Projection(Vector3 a, Vector3 b)
+// Doubles the nodes pool capacity
+static void GrowNodesPool(FNodeContext *ctx)
 {
-    Vector3 output = { 0, 0, 0 };
+    int capacity = ((ctx->nodesCapacity > 0) ? ctx->nodesCapacity*2 : INITIAL_NODES_CAPACITY);
+    if (capacity > (HANDLE_INDEX_MASK + 1)) TraceLogFNode(true, "nodes pool capacity cannot be increased over handles ids limit (%i)", (HANDLE_INDEX_MASK + 1));
+
+    ctx->nodes = (FNode *)FResizeArray(ctx, ctx->nodes, ctx->nodesCapacity*sizeof(FNode), capacity*sizeof(FNode));
+    ctx->nodesIndex = (int *)FResizeArray(ctx, ctx->nodesIndex, ctx->nodesCapacity*sizeof(int), capacity*sizeof(int));
+    ctx->nodesGenerations = (unsigned short *)FResizeArray(ctx, ctx->nodesGenerations, ctx->nodesCapacity*sizeof(unsigned short), capacity*sizeof(unsigned short));
+    ctx->nodesDeclared = (bool *)FResizeArray(ctx, ctx->nodesDeclared, ctx->nodesCapacity*sizeof(bool), capacity*sizeof(bool));
+    ctx->selectedCommentNodes = (FHandle *)FResizeArray(ctx, ctx->selectedCommentNodes, ctx->nodesCapacity*sizeof(FHandle), capacity*sizeof(FHandle));
+    ctx->nodesOrder = (FNode *)FResizeArray(ctx, ctx->nodesOrder, 2*ctx->nodesCapacity*sizeof(FNode), 2*capacity*sizeof(FNode));
+    ctx->nodesSchedule = (FNode *)FResizeArray(ctx, ctx->nodesSchedule, ctx->nodesCapacity*sizeof(FNode), capacity*sizeof(FNode));
+    ctx->nodesPendingInputs = (int *)FResizeArray(ctx, ctx->nodesPendingInputs, ctx->nodesCapacity*sizeof(int), capacity*sizeof(int));
+    ctx->reachStack = (FNode *)FResizeArray(ctx, ctx->reachStack, ctx->nodesCapacity*sizeof(FNode), capacity*sizeof(FNode));
+    ctx->rankRegion = (FNode *)FResizeArray(ctx, ctx->rankRegion, ctx->nodesCapacity*sizeof(FNode), capacity*sizeof(FNode));
+    ctx->rankRegionRanks = (int *)FResizeArray(ctx, ctx->rankRegionRanks, ctx->nodesCapacity*sizeof(int), capacity*sizeof(int));
+#if defined(FNODE_PARALLEL)
+    ctx->levelsPositions = (int *)FResizeArray(ctx, ctx->levelsPositions, ctx->nodesCapacity*sizeof(int), capacity*sizeof(int));
+    ctx->levelsEnd = (int *)FResizeArray(ctx, ctx->levelsEnd, ctx->nodesCapacity*sizeof(int), capacity*sizeof(int));
+#endif
+    ctx->nodesTape = (FInstruction *)FResizeArray(ctx, ctx->nodesTape, ctx->nodesCapacity*sizeof(FInstruction), capacity*sizeof(FInstruction));
+    ctx->registers = (FNodeOutput *)FResizeArray(ctx, ctx->registers, ctx->nodesCapacity*sizeof(FNodeOutput), capacity*sizeof(FNodeOutput));
+    ctx->nodesEquivalent = (int *)FResizeArray(ctx, ctx->nodesEquivalent, ctx->nodesCapacity*sizeof(int), capacity*sizeof(int));
+    ctx->hashTable = (int *)FResizeArray(ctx, ctx->hashTable, 2*ctx->nodesCapacity*sizeof(int), 2*capacity*sizeof(int));
 
-    float dotAB = FVector3Dot(a, b);
-    float dotBB = FVector3Dot(b, b);
-    output.x = dotAB/dotBB*b.x;
-    output.y = dotAB/dotBB*b.y;
+    for (int i = ctx->nodesCapacity; i < capacity; i++)
+    {
+        ctx->nodes[i] = NULL;
+        ctx->nodesIndex[i] = -1;
+        ctx->nodesGenerations[i] = 1;
+        ctx->selectedCommentNodes[i] = NULL_HANDLE;
+    }
+
+    if (ctx->nodesIds.bits == NULL) InitIdAllocator(ctx, &ctx->nodesIds, capacity);
+    else GrowIdAllocator(ctx, &ctx->nodesIds, capacity);
+
+    ctx->nodesCapacity = capacity;
+
+    TraceLogFNode(false, "nodes pool capacity increased to %i [USED RAM: %i bytes]", ctx->nodesCapacity, ctx->usedMemory);
+}
+
+// Removes destroyed nodes holes from nodes draw order list
+static void CompactNodesOrder(FNodeContext *ctx)
+{
+    int count = 0;
+
+    for (int i = 0; i < ctx->nodesOrderCount; i++)
+    {
+        if (ctx->nodesOrder[i] != NULL)
+        {
+            ctx->nodesOrder[count] = ctx->nodesOrder[i];
+            ctx->nodesOrder[count]->drawIndex = count;
+            count++;
+        }
+    }
+
+    ctx->nodesOrderCount = count;
+}
+
+// Increases a node uses count making its inputs reachable if it was unused
+static void AddNodeUse(FNodeContext *ctx, FNode node)
+{
+    int count = 0;
+
+    node->usesCount++;
+    if (node->usesCount == 1) ctx->reachStack[count++] = node;
+
+    // Every node which becomes used adds one use to each of its inputs nodes (explicit stack avoids recursion in long chains)
+    while (count > 0)
+    {
+        FNode usedNode = ctx->reachStack[--count];
+
+        usedNode->dirty = true;
+        ctx->graphDirty = true;
+        ctx->scheduleDirty = true;
+
+        for (int i = 0; i < usedNode->inputsCount; i++)
+        {
+            FNode inputNode = ctx->nodes[ctx->nodesIndex[usedNode->inputs[i]]];
+
+            inputNode->usesCount++;
+            if (inputNode->usesCount == 1) ctx->reachStack[count++] = inputNode;
+        }
+    }
+}
+
+// Decreases a node uses count making its inputs unreachable if it becomes unused
+static void ReleaseNodeUse(FNodeContext *ctx, FNode node)
+{
+    int count = 0;
+
+    node->usesCount--;
+    if (node->usesCount == 0) ctx->reachStack[count++] = node;
+
+    // Every node which becomes unused releases its use of each of its inputs nodes
+    while (count > 0)
+    {
+        FNode unusedNode = ctx->reachStack[--count];
+
+        ctx->scheduleDirty = true;
+
+        for (int i = 0; i < unusedNode->inputsCount; i++)
+        {
+            FNode inputNode = ctx->nodes[ctx->nodesIndex[unusedNode->inputs[i]]];
+
+            inputNode->usesCount--;
+            if (inputNode->usesCount == 0) ctx->reachStack[count++] = inputNode;
+        }
+    }
+}
+
+// Updates nodes ranks to link two nodes and returns false if the link creates a cycle
+static bool RankNodesLink(FNodeContext *ctx, FNode fromNode, FNode toNode)
+{
+    if (fromNode == toNode) return false;
+
+    // Ranks are already in order, nothing reached from end node can reach start node
+    if (fromNode->rank < toNode->rank) return true;
+
+    int lowerRank = toNode->rank;
+    int upperRank = fromNode->rank;
+    int count = 0;
+    bool cycle = false;
+
+    // Search nodes reached from end node ranked before start node (only them can be affected by the link, Pearce-Kelly algorithm)
+    toNode->visited = true;
+    ctx->rankRegion[count++] = toNode;
+
+    for (int k = 0; (k < count) && !cycle; k++)
+    {
+        for (FLine line = ctx->rankRegion[k]->outputLines; line != NULL; line = line->nextOutput)
+        {
+            FNode node = GetNodeFromHandle(ctx, line->to);
+
+            if (node == fromNode)
+            {
+                cycle = true;
+                break;
+            }
+            else if ((node != NULL) && !node->visited && (node->rank < upperRank))
+            {
+                node->visited = true;
+                ctx->rankRegion[count++] = node;
+            }
+        }
+    }
+
+    int forwardCount = count;
+
+    if (!cycle)
+    {
+        // Search nodes which reach start node ranked after end node
+        fromNode->visited = true;
+        ctx->rankRegion[count++] = fromNode;
+
+        for (int k = forwardCount; k < count; k++)
+        {
+            for (int i = 0; i < ctx->rankRegion[k]->inputsCount; i++)
+            {
+                FNode node = ctx->nodes[ctx->nodesIndex[ctx->rankRegion[k]->inputs[i]]];
+
+                if (!node->visited && (node->rank > lowerRank))
+                {
+                    node->visited = true;
+                    ctx->rankRegion[count++] = node;
+                }
+            }
+        }
+
+        // Keep every search relative order and merge their ranks
+        SortNodesByRank(ctx->rankRegion, forwardCount);
+        SortNodesByRank(ctx->rankRegion + forwardCount, count - forwardCount);
+
+        for (int r = 0, f = 0, b = forwardCount; r < count; r++)
+        {
+            if ((b == count) || ((f < forwardCount) && (ctx->rankRegion[f]->rank < ctx->rankRegion[b]->rank))) ctx->rankRegionRanks[r] = ctx->rankRegion[f++]->rank;
+            else ctx->rankRegionRanks[r] = ctx->rankRegion[b++]->rank;
+        }
+
+        // Nodes reaching start node take the lowest ranks, nodes reached from end node take the rest
+        int backwardCount = count - forwardCount;
+
+        for (int k = 0; k < backwardCount; k++) ctx->rankRegion[forwardCount + k]->rank = ctx->rankRegionRanks[k];
+        for (int k = 0; k < forwardCount; k++) ctx->rankRegion[k]->rank = ctx->rankRegionRanks[backwardCount + k];
+    }
+
+    for (int k = 0; k < count; k++) ctx->rankRegion[k]->visited = false;
+
+    return !cycle;
+}
+
+// Sorts a nodes list by their ranks (heap sort)
+static void SortNodesByRank(FNode *nodes, int count)
+{
+    // First steps build the heap sifting down every parent node, next steps move heap root to the end of the list
+    for (int step = count + count/2 - 1; step > 0; step--)
+    {
+        int root = ((step >= count) ? (step - count) : 0);
+        int end = ((step >= count) ? count : step);
+
+        if (step < count)
+        {
+            FNode temp = nodes[0];
+            nodes[0] = nodes[step];
+            nodes[step] = temp;
+        }
+
+        while ((2*root + 1) < end)
+        {
+            int child = 2*root + 1;
+            if (((child + 1) < end) && (nodes[child + 1]->rank > nodes[child]->rank)) child++;
+            if (nodes[root]->rank >= nodes[child]->rank) break;
+
+            FNode temp = nodes[root];
+            nodes[root] = nodes[child];
+            nodes[child] = temp;
+            root = child;
+        }
+    }
+}
+
+// Sorts nodes topologically into the nodes calculation order list and builds the nodes tape from it
+static void BuildNodesSchedule(FNodeContext *ctx)
+{
+    int count = 0;
+    int usedCount = 0;
+
+    // Schedule used nodes without inputs first, unused nodes are left out of the calculation order list
+    for (int i = 0; i < ctx->nodesCount; i++)
+    {
+        ctx->nodes[i]->scheduleIndex = -1;
+        ctx->nodes[i]->hash = 0;
+        ctx->nodes[i]->shared = false;
+        ctx->nodesPendingInputs[i] = 0;
+
+        if (ctx->nodes[i]->usesCount > 0)
+        {
+            ctx->nodesPendingInputs[i] = ctx->nodes[i]->inputsCount;
+            usedCount++;
+
+            if (ctx->nodesPendingInputs[i] == 0)
+            {
+                ctx->nodesSchedule[count] = ctx->nodes[i];
+                count++;
+            }
+        }
+    }
+
+    // Schedule every node once all its inputs nodes are scheduled (scheduled list is used as queue)
+    for (int k = 0; k < count; k++)
+    {
+        for (FLine line = ctx->nodesSchedule[k]->outputLines; line != NULL; line = line->nextOutput)
+        {
+            FNode toNode = GetNodeFromHandle(ctx, line->to);
+
+            if ((toNode != NULL) && (toNode->usesCount > 0))
+            {
+                int index = ctx->nodesIndex[toNode->id];
+                ctx->nodesPendingInputs[index]--;
+
+                if (ctx->nodesPendingInputs[index] == 0)
+                {
+                    ctx->nodesSchedule[count] = toNode;
+                    count++;
+                }
+            }
+        }
+    }
+
+    ctx->nodesScheduleAcyclicCount = count;
+
+    // Nodes inside cycles (and nodes depending on them) never run out of pending inputs, so they are appended in pool order
+    if (count < usedCount)
+    {
+        for (int i = 0; i < ctx->nodesCount; i++)
+        {
+            if (ctx->nodesPendingInputs[i] > 0)
+            {
+                ctx->nodesSchedule[count] = ctx->nodes[i];
+                count++;
+            }
+        }
+
+        TraceLogFNode(false, "nodes graph contains cycles, %i nodes values are calculated until they are stable", (usedCount - ctx->nodesScheduleAcyclicCount));
+    }
+
+    ctx->nodesScheduleCount = count;
+
+    for (int i = 0; i < ctx->nodesScheduleCount; i++) ctx->nodesSchedule[i]->scheduleIndex = i;
+
+    for (int i = 0; i < 2*ctx->nodesCapacity; i++) ctx->hashTable[i] = -1;
+
+    // Lower scheduled nodes into the nodes tape, their inputs ids are translated to registers once per structural change
+    for (int i = 0; i < ctx->nodesScheduleCount; i++)
+    {
+        FNode node = ctx->nodesSchedule[i];
+
+        ctx->nodesTape[i].type = node->type;
+        ctx->nodesTape[i].inputsCount = node->inputsCount;
+        for (int k = 0; k < node->inputsCount; k++) ctx->nodesTape[i].inputs[k] = ctx->nodes[ctx->nodesIndex[node->inputs[k]]]->scheduleIndex;
+        for (int k = node->inputsCount; k < MAX_INPUTS; k++) ctx->nodesTape[i].inputs[k] = -1;
+
+        ctx->registers[i] = node->output;
+        ShareNodeStructure(ctx, i);
+    }
+
+#if defined(FNODE_PARALLEL)
+    BuildNodesLevels(ctx);
+#endif
+
+    // Dirty nodes positions changed, so next values update needs to look for them in the whole list
+    ctx->scheduleDirtyStart = 0;
+    ctx->scheduleDirty = false;
+}
+
+// Hashes a scheduled node structure and links it to the first scheduled node with same structure
+static void ShareNodeStructure(FNodeContext *ctx, int position)
+{
+    FNode node = ctx->nodesSchedule[position];
+    FInstruction *instruction = &ctx->nodesTape[position];
+
+    ctx->nodesEquivalent[position] = position;
+    instruction->source = -1;
+
+    // Nodes inside cycles depend on nodes scheduled after them and output nodes are never shared
+    if ((position >= ctx->nodesScheduleAcyclicCount) || (node->type >= FNODE_VERTEX)) return;
+
+    // Operators without inputs keep their previous values, so they are never shared
+    if ((node->type > FNODE_VECTOR4) && (instruction->inputsCount == 0)) return;
+
+    // Structural hash is built from node type and its constant values or its inputs hashes (FNV-1a)
+    unsigned int hash = 2166136261u;
+    hash = (hash ^ (unsigned int)node->type)*16777619u;
+
+    if (node->type <= FNODE_VECTOR4)
+    {
+        const unsigned char *bytes = (const unsigned char *)node->output.data;
+
+        hash = (hash ^ (unsigned int)node->output.dataCount)*16777619u;
+        for (int i = 0; i < node->output.dataCount*(int)sizeof(float); i++) hash = (hash ^ bytes[i])*16777619u;
+    }
+    else
+    {
+        for (int k = 0; k < instruction->inputsCount; k++) hash = (hash ^ ctx->nodesSchedule[instruction->inputs[k]]->hash)*16777619u;
+    }
+
+    if (hash == 0) hash = 1;
+    node->hash = hash;
+
+    // Look for a previous node with same structure, hash collisions are solved comparing nodes structures
+    int mask = 2*ctx->nodesCapacity - 1;
+    int slot = (hash & mask);
+
+    while (ctx->hashTable[slot] != -1)
+    {
+        int equivalent = ctx->hashTable[slot];
+
+        if ((ctx->nodesSchedule[equivalent]->hash == hash) && CompareNodesStructure(ctx, equivalent, position))
+        {
+            ctx->nodesEquivalent[position] = equivalent;
+            ctx->nodesSchedule[equivalent]->shared = true;
+            node->shared = true;
+
+            // Constants are never executed, only operators copy their equivalent register
+            if (node->type > FNODE_VECTOR4) instruction->source = equivalent;
+            return;
+        }
+
+        slot = ((slot + 1) & mask);
+    }
+
+    ctx->hashTable[slot] = position;
+}
+
+// Returns true if two scheduled nodes have same structure
+static bool CompareNodesStructure(FNodeContext *ctx, int positionA, int positionB)
+{
+    FNode nodeA = ctx->nodesSchedule[positionA];
+    FNode nodeB = ctx->nodesSchedule[positionB];
+    FInstruction *instructionA = &ctx->nodesTape[positionA];
+    FInstruction *instructionB = &ctx->nodesTape[positionB];
+
+    if (nodeA->type != nodeB->type) return false;
+
+    if (nodeA->type <= FNODE_VECTOR4) return ((nodeA->output.dataCount == nodeB->output.dataCount) && (memcmp(nodeA->output.data, nodeB->output.data, nodeA->output.dataCount*sizeof(float)) == 0));
+
+    if (instructionA->inputsCount != instructionB->inputsCount) return false;
+
+    for (int k = 0; k < instructionA->inputsCount; k++)
+    {
+        if (ctx->nodesEquivalent[instructionA->inputs[k]] != ctx->nodesEquivalent[instructionB->inputs[k]]) return false;
+    }
+
+    return true;
+}
+
+// Calculates a scheduled node output values and returns if they changed
+static bool CalculateNodeValues(FNodeContext *ctx, int position)
+{
+    FNode node = ctx->nodesSchedule[position];
+    bool changed = false;
+
+    // Constant nodes values are edited out of the tape, so their registers are just patched
+    if (ctx->nodesTape[position].type <= FNODE_VECTOR4)
+    {
+        changed = (memcmp(&ctx->registers[position], &node->output, sizeof(FNodeOutput)) != 0);
+        ctx->registers[position] = node->output;
+    }
+    else if (ctx->nodesTape[position].source != -1)
+    {
+        // Nodes with same structure as a previous node just copy its values
+        int source = ctx->nodesTape[position].source;
+
+        changed = (memcmp(&ctx->registers[position], &ctx->registers[source], sizeof(FNodeOutput)) != 0);
+        if (changed)
+        {
+            ctx->registers[position] = ctx->registers[source];
+            node->output = ctx->registers[position];
+        }
+    }
+    else
+    {
+        changed = ExecuteInstruction(ctx, ctx->registers, position);
+        if (changed) node->output = ctx->registers[position];
+    }
+
+    return changed;
+}
+
+// Executes a nodes tape instruction over a registers file and returns if its output register changed
+static bool ExecuteInstruction(FNodeContext *ctx, FNodeOutput *registers, int position)
+{
+    FInstruction *instruction = &ctx->nodesTape[position];
+    FNodeOutput *output = &registers[position];
+    FNodeOutput previous = *output;
+
+    // Check if current node is an operator
+    if (instruction->type > FNODE_VECTOR4 && instruction->type < FNODE_APPEND)
+    {
+        // Calculate output values count based on first input node value count
+        if (instruction->inputsCount > 0) 
+        {
+            // Get which index has the first input node id from current nude
+            int index = instruction->inputs[0];
+
+            output->dataCount = registers[index].dataCount;
+            for (int k = 0; k < output->dataCount; k++) output->data[k] = registers[index].data[k];
+
+            for (int k = 1; k < instruction->inputsCount; k++)
+            {
+                int inputIndex = instruction->inputs[k];
+
+                // Apply inputs values to output based on node operation type
+                switch (instruction->type)
+                {
+                    case FNODE_ADD: FLanesAdd(output->data, registers[inputIndex].data, output->dataCount); break;
+                    case FNODE_SUBTRACT: FLanesSubtract(output->data, registers[inputIndex].data, output->dataCount); break;
+                    case FNODE_MULTIPLY:
+                    {
+                        if (registers[inputIndex].dataCount == 1) FLanesScale(output->data, registers[inputIndex].data[0], output->dataCount);
+                        else if (((registers[inputIndex].dataCount == 16) && (output->dataCount == 4)) || ((registers[inputIndex].dataCount == 4) && (output->dataCount == 16)))
+                        {
+                            for (int j = 0; j < output->dataCount; j++)
+                            {
+                                if (registers[inputIndex].dataCount == 16 && output->dataCount == 4)
+                                {
+                                    Vector4 vector = { output->data[0], output->data[1], output->data[2], output->data[3] };
+                                    Matrix matrix = { registers[inputIndex].data[4], registers[inputIndex].data[5], registers[inputIndex].data[6], registers[inputIndex].data[7],
+                                    registers[inputIndex].data[8], registers[inputIndex].data[9], registers[inputIndex].data[10], registers[inputIndex].data[11],
+                                    registers[inputIndex].data[12], registers[inputIndex].data[13], registers[inputIndex].data[14], registers[inputIndex].data[15] };
+                                    FMultiplyMatrixVector(&vector, &matrix);
+
+                                    for (int k = 0; k < MAX_VALUES; k++) output->data[k] = 0.0f;
+                                    output->data[0] = vector.x;
+                                    output->data[1] = vector.y;
+                                    output->data[2] = vector.z;
+                                    output->data[3] = vector.w;
+                                    output->dataCount = 4;
+                                }
+                                else if (registers[inputIndex].dataCount == 4 && output->dataCount == 16)
+                                {
+                                    Vector4 vector = { registers[inputIndex].data[0], registers[inputIndex].data[1], registers[inputIndex].data[2], registers[inputIndex].data[3] };
+                                    Matrix matrix = { output->data[4], output->data[5], output->data[6], output->data[7],
+                                    output->data[8], output->data[9], output->data[10], output->data[11],
+                                    output->data[12], output->data[13], output->data[14], output->data[15] };
+                                    FMultiplyMatrixVector(&vector, &matrix);
+
+                                    for (int k = 0; k < MAX_VALUES; k++) output->data[k] = 0.0f;
+                                    output->data[0] = vector.x;
+                                    output->data[1] = vector.y;
+                                    output->data[2] = vector.z;
+                                    output->data[3] = vector.w;
+                                    output->dataCount = 4;
+                                }
+                                else output->data[j] *= registers[inputIndex].data[j];
+                            }
+                        }
+                        else FLanesMultiply(output->data, registers[inputIndex].data, output->dataCount);
+                    } break;
+                    case FNODE_DIVIDE:
+                    {
+                        if (registers[inputIndex].dataCount == 1) FLanesDivideValue(output->data, registers[inputIndex].data[0], output->dataCount);
+                        else FLanesDivide(output->data, registers[inputIndex].data, output->dataCount);
+                    } break;
+                    default: break;
+                }
+            }
+        }
+        else
+        {
+            for (int k = 0; k < MAX_VALUES; k++) output->data[k] = 0.0f;
+            output->dataCount = 0;
+        }
+    }
+    else if (instruction->type == FNODE_APPEND)
+    {
+        if (instruction->inputsCount > 0)
+        {
+            int valuesCount = 0;
+            for (int k = 0; k < instruction->inputsCount; k++)
+            {
+                int inputIndex = instruction->inputs[k];
+
+                for (int j = 0; j < registers[inputIndex].dataCount; j++)
+                {
+                    output->data[valuesCount] = registers[inputIndex].data[j];
+                    valuesCount++;
+                }
+            }
+
+            output->dataCount = valuesCount;
+        }
+        else
+        {
+            for (int k = 0; k < MAX_VALUES; k++) output->data[k] = 0.0f;
+            output->dataCount = 0;
+        }
+    }
+    else if (instruction->type > FNODE_APPEND)
+    {
+        if (instruction->inputsCount > 0)
+        {
+            int index = instruction->inputs[0];
+
+            output->dataCount = registers[index].dataCount;
+            for (int k = 0; k < output->dataCount; k++) output->data[k] = registers[index].data[k];
+
+            // Batches calculation has its own math accuracy (fast by default)
+            bool fast = ((((ctx->batch != NULL) ? ctx->batchAccuracy : ctx->accuracy)) == FNODE_ACCURACY_FAST);
+
+            switch (instruction->type)
+            {
+                case FNODE_ONEMINUS: FLanesOneMinus(output->data, output->dataCount); break;
+                case FNODE_ABS: FLanesAbs(output->data, output->dataCount); break;
+                case FNODE_COS:
+                {
+                    for (int j = 0; j < output->dataCount; j++) output->data[j] = (fast ? FFastSinCos(output->data[j], 1) : (float)FCos(output->data[j]));
+                } break;
+                case FNODE_SIN:
+                {
+                    for (int j = 0; j < output->dataCount; j++) output->data[j] = (fast ? FFastSinCos(output->data[j], 0) : (float)FSin(output->data[j]));
+                } break;
+                case FNODE_TAN:
+                {
+                    for (int j = 0; j < output->dataCount; j++) output->data[j] = (fast ? FFastTan(output->data[j]) : (float)FTan(output->data[j]));
+                } break;
+                case FNODE_DEG2RAD: FLanesScale(output->data, DEG2RAD, output->dataCount); break;
+                case FNODE_RAD2DEG: FLanesScale(output->data, RAD2DEG, output->dataCount); break;
+                case FNODE_NORMALIZE:
+                {
+                    switch (output->dataCount)
+                    {
+                        case 2:
+                        {
+                            Vector2 temp = { output->data[0], output->data[1] };
+                            temp = FVector2Normalize(temp);
+                            output->data[0] = temp.x;
+                            output->data[1] = temp.y;
+                        } break;
+                        case 3:
+                        {
+                            Vector3 temp = { output->data[0], output->data[1], output->data[2] };
+                            temp = FVector3Normalize(temp);
+                            output->data[0] = temp.x;
+                            output->data[1] = temp.y;
+                            output->data[2] = temp.z;
+                        } break;
+                        case 4:
+                        {
+                            Vector4 temp = { output->data[0], output->data[1], output->data[2], output->data[3] };
+                            temp = FVector4Normalize(temp);
+                            output->data[0] = temp.x;
+                            output->data[1] = temp.y;
+                            output->data[2] = temp.z;
+                            output->data[3] = temp.w;
+                        } break;
+                        default: break;
+                    }
+                } break;
+                case FNODE_NEGATE: FLanesScale(output->data, -1.0f, output->dataCount); break;
+                case FNODE_RECIPROCAL: FLanesReciprocal(output->data, output->dataCount); break;
+                case FNODE_SQRT: FLanesSquareRoot(output->data, output->dataCount); break;
+                case FNODE_TRUNC:
+                {
+                    for (int j = 0; j < output->dataCount; j++) output->data[j] = FTrunc(output->data[j]);
+                } break;
+                case FNODE_ROUND:
+                {
+                    for (int j = 0; j < output->dataCount; j++) output->data[j] = FRound(output->data[j]);
+                } break;
+                case FNODE_VERTEXCOLOR:
+                {
+                    if (instruction->inputsCount == 1)
+                    {
+                        int index = instruction->inputs[0];
+                        switch ((int)registers[index].data[0])
+                        {
+                            case 0: output->dataCount = 4; break;
+                            case 1: output->dataCount = 3; break;
+                            default: output->dataCount = 1; break;
+                        }
+                    }
+                    else
+                    {
+                        output->dataCount = 0;
+                        for (int j = 0; j < MAX_VALUES; j++) output->data[j] = 0.0f;
+                    }
+                }
+                case FNODE_CEIL:
+                {
+                    for (int j = 0; j < output->dataCount; j++) output->data[j] = FCeil(output->data[j]);
+                } break;
+                case FNODE_CLAMP01: FLanesClamp(output->data, 0.0f, 1.0f, output->dataCount); break;
+                case FNODE_EXP2:
+                {
+                    for (int j = 0; j < output->dataCount; j++) output->data[j] = (fast ? FFastExp2(output->data[j]) : FPower(2.0f, output->data[j]));
+                } break;
+                case FNODE_POWER:
+                {
+                    if (instruction->inputsCount == 2)
+                    {
+                        int expIndex = instruction->inputs[1];
+
+                        if (registers[expIndex].dataCount == 1)
+                        {
+                            for (int j = 0; j < output->dataCount; j++) output->data[j] = (fast ? FFastPower(output->data[j], registers[expIndex].data[0]) : FPower(output->data[j], registers[expIndex].data[0]));
+                        }
+                        else TraceLogFNode(false, "values count of node %i should be 1 because it is an exponent (currently count: %i)", ctx->nodesSchedule[expIndex]->id, registers[expIndex].dataCount);
+                    }
+                    else
+                    {
+                        output->dataCount = 0;
+                        for (int j = 0; j < MAX_VALUES; j++) output->data[j] = 0.0f;
+                    }
+                } break;
+                case FNODE_STEP:
+                {
+                    if (instruction->inputsCount == 2)
+                    {
+                        int indexB = instruction->inputs[1];
+
+                        if (registers[indexB].dataCount == 1) output->data[0] = ((output->data[0] <= registers[indexB].data[0]) ? 1.0f : 0.0f);
+                        else TraceLogFNode(false, "values count of node %i should be 1 because it is an exponent (currently count: %i)", ctx->nodesSchedule[indexB]->id, registers[indexB].dataCount);
+                    }
+                    else
+                    {
+                        output->dataCount = 0;
+                        for (int j = 0; j < MAX_VALUES; j++) output->data[j] = 0.0f;
+                    }
+                } break;
+                case FNODE_POSTERIZE:
+                {
+                    if (instruction->inputsCount == 2)
+                    {
+                        int expIndex = instruction->inputs[1];
+
+                        if (registers[expIndex].dataCount == 1)
+                        {
+                            for (int j = 0; j < output->dataCount; j++) output->data[j] = FPosterize(output->data[j], registers[expIndex].data[0]);
+                        }
+                    }
+                    else
+                    {
+                        output->dataCount = 0;
+                        for (int j = 0; j < MAX_VALUES; j++) output->data[j] = 0.0f;
+                    }
+                } break;
+                case FNODE_MAX:
+                case FNODE_MIN:
+                {
+                    for (int j = 1; j < instruction->inputsCount; j++)
+                    {
+                        int inputIndex = instruction->inputs[j];
+
+                        if (instruction->type == FNODE_MAX) FLanesMax(output->data, registers[inputIndex].data, output->dataCount);
+                        else FLanesMin(output->data, registers[inputIndex].data, output->dataCount);
+                    }
+                } break;
+                case FNODE_LERP:
+                {                                
+                    if (instruction->inputsCount == 3)
+                    {
+                        int indexA = instruction->inputs[0];
+                        int indexB = instruction->inputs[1];
+                        int indexC = instruction->inputs[2];
+
+                        if ((output->dataCount >= 1) && (output->dataCount <= 4))
+                        {
+                            // Vector3 and Vector4 interpolations take b last components from a values
+                            float valuesB[4] = { registers[indexB].data[0], registers[indexB].data[1], registers[indexA].data[2], registers[indexA].data[3] };
+                            FLanesLerp(output->data, registers[indexA].data, valuesB, registers[indexC].data[0], output->dataCount);
+                        }
+                    }
+                    else
+                    {
+                        output->dataCount = 0;
+                        for (int j = 0; j < MAX_VALUES; j++) output->data[j] = 0.0f;
+                    }
+                } break;
+                case FNODE_SMOOTHSTEP:
+                {                                
+                    if (instruction->inputsCount == 3)
+                    {
+                        int indexA = instruction->inputs[0];
+                        int indexB = instruction->inputs[1];
+                        int indexC = instruction->inputs[2];
+
+                        FLanesSmoothStep(output->data, registers[indexA].data, registers[indexB].data, registers[indexC].data, output->dataCount);
+                    }
+                    else
+                    {
+                        output->dataCount = 0;
+                        for (int j = 0; j < MAX_VALUES; j++) output->data[j] = 0.0f;
+                    }
+                } break;
+                case FNODE_CROSSPRODUCT:
+                {
+                    if (instruction->inputsCount == 2)
+                    {
+                        int indexA = instruction->inputs[0];
+                        int indexB = instruction->inputs[1];
+
+                        for (int j = 0; j < MAX_VALUES; j++) output->data[j] = 0.0f;
+
+                        Vector3 vectorA = { registers[indexA].data[0], registers[indexA].data[1], registers[indexA].data[2] };
+                        Vector3 vectorB = { registers[indexB].data[0], registers[indexB].data[1], registers[indexB].data[2] };
+                        Vector3 cross = FCrossProduct(vectorA, vectorB);
+
+                        output->dataCount = 3;
+                        output->data[0] = cross.x;
+                        output->data[1] = cross.y;
+                        output->data[2] = cross.z;
+                    }
+                    else
+                    {
+                        output->dataCount = 0;
+                        for (int j = 0; j < MAX_VALUES; j++) output->data[j] = 0.0f;
+                    }
+                } break;
+                case FNODE_DESATURATE:
+                {
+                    if (instruction->inputsCount == 2)
+                    {
+                        int index = instruction->inputs[0];
+                        int index1 = instruction->inputs[1];
+
+                        for (int j = 0; j < MAX_VALUES; j++) output->data[j] = registers[index].data[j];
+                        output->dataCount = registers[index].dataCount;
+
+                        float amount = FClamp(registers[index1].data[0], 0.0f, 1.0f);
+                        float luminance = 0.3f*output->data[0] + 0.6f*output->data[1] + 0.1f*output->data[2];
+
+                        output->data[0] = output->data[0] + amount*(luminance - output->data[0]);
+                        output->data[1] = output->data[1] + amount*(luminance - output->data[1]);
+                        output->data[2] = output->data[2] + amount*(luminance - output->data[2]);
+                    }
+                    else
+                    {
+                        output->dataCount = 0;
+                        for (int j = 0; j < MAX_VALUES; j++) output->data[j] = 0.0f;
+                    }
+                } break;
+                case FNODE_DISTANCE:
+                {
+                    if (instruction->inputsCount == 2)
+                    {
+                        int indexA = instruction->inputs[0];
+                        int indexB = instruction->inputs[1];
+
+                        switch (output->dataCount)
+                        {
+                            case 1: output->data[0] = registers[indexB].data[0] - registers[indexA].data[0]; break;
+                            case 2:
+                            {
+                                Vector2 direction = { 0, 0 };
+                                direction.x = registers[indexB].data[0] - registers[indexA].data[0];
+                                direction.y = registers[indexB].data[1] - registers[indexA].data[1];
+
+                                output->data[0] = FVector2Length(direction);
+                            } break;
+                            case 3:
+                            {
+                                Vector3 direction = { 0, 0, 0 };
+                                direction.x = registers[indexB].data[0] - registers[indexA].data[0];
+                                direction.y = registers[indexB].data[1] - registers[indexA].data[1];
+                                direction.z = registers[indexB].data[2] - registers[indexA].data[2];
+
+                                output->data[0] = FVector3Length(direction);
+                            } break;
+                            case 4:
+                            {
+                                Vector4 direction = { 0, 0, 0, 0 };
+                                direction.x = registers[indexB].data[0] - registers[indexA].data[0];
+                                direction.y = registers[indexB].data[1] - registers[indexA].data[1];
+                                direction.z = registers[indexB].data[2] - registers[indexA].data[2];
+                                direction.w = registers[indexB].data[3] - registers[indexA].data[3];
+
+                                output->data[0] = FVector4Length(direction);
+                            } break;
+                            default: break;
+                        }
+
+                        for (int j = 1; j < MAX_VALUES; j++) output->data[j] = 0.0f;
+                        output->dataCount = 1;
+                    }
+                    else
+                    {
+                        for (int j = 0; j < MAX_VALUES; j++) output->data[j] = 0.0f;
+                        output->dataCount = 0;
+                    }
+                } break;
+                case FNODE_DOTPRODUCT:
+                {
+                    if (instruction->inputsCount == 2)
+                    {
+                        int indexA = instruction->inputs[0];
+                        int indexB = instruction->inputs[1];
+
+                        switch (output->dataCount)
+                        {
+                            case 2:
+                            {
+                                Vector2 vectorA = { registers[indexA].data[0], registers[indexA].data[1] };
+                                Vector2 vectorB = { registers[indexB].data[0], registers[indexB].data[1] };
+                                output->data[0] = FVector2Dot(vectorA, vectorB);
+                            } break;
+                            case 3:
+                            {
+                                Vector3 vectorA = { registers[indexA].data[0], registers[indexA].data[1], registers[indexA].data[2] };
+                                Vector3 vectorB = { registers[indexB].data[0], registers[indexB].data[1], registers[indexB].data[2] };
+                                output->data[0] = FVector3Dot(vectorA, vectorB);
+                            } break;
+                            case 4:
+                            {
+                                Vector4 vectorA = { registers[indexA].data[0], registers[indexA].data[1], registers[indexA].data[2], registers[indexA].data[3] };
+                                Vector4 vectorB = { registers[indexB].data[0], registers[indexB].data[1], registers[indexB].data[2], registers[indexB].data[3] };
+                                output->data[0] = FVector4Dot(vectorA, vectorB);
+                            } break;
+                            default: break;
+                        }
+
+                        for (int j = 1; j < MAX_VALUES; j++) output->data[j] = 0.0f;
+                        output->dataCount = 1;
+                    }
+                    else
+                    {
+                        for (int j = 0; j < MAX_VALUES; j++) output->data[j] = 0.0f;
+                        output->dataCount = 0;
+                    }
+                } break;
+                case FNODE_LENGTH:
+                {
+                    switch (output->dataCount)
+                    {
+                        case 2: output->data[0] = FVector2Length((Vector2){ output->data[0], output->data[1] }); break;
+                        case 3: output->data[0] = FVector3Length((Vector3){ output->data[0], output->data[1], output->data[2] }); break;
+                        case 4: output->data[0] = FVector4Length((Vector4){ output->data[0], output->data[1], output->data[2], output->data[3] }); break;
+                        default: break;
+                    }
+
+                    for (int j = 1; j < MAX_VALUES; j++) output->data[j] = 0.0f;
+                    output->dataCount = 1;
+                } break;
+                case FNODE_MULTIPLYMATRIX:
+                {
+                    if (instruction->inputsCount == 2)
+                    {
+                        int index = instruction->inputs[1];
+
+                        Matrix matrixA = { output->data[0], output->data[1], output->data[2], output->data[3], 
+                        output->data[4], output->data[5], output->data[6], output->data[7], 
+                        output->data[8], output->data[9], output->data[10], output->data[11], 
+                        output->data[12], output->data[13], output->data[14], output->data[15], };
+                        Matrix matrixB = { registers[index].data[0], registers[index].data[1], registers[index].data[2], registers[index].data[3], 
+                        registers[index].data[4], registers[index].data[5], registers[index].data[6], registers[index].data[7], 
+                        registers[index].data[8], registers[index].data[9], registers[index].data[10], registers[index].data[11], 
+                        registers[index].data[12], registers[index].data[13], registers[index].data[14], registers[index].data[15], };
+                        Matrix matrixAB = { 0 };
+                        FMatrixMultiply(&matrixAB, &matrixA, &matrixB);
+
+                        output->data[0] = matrixAB.m0;
+                        output->data[1] = matrixAB.m1;
+                        output->data[2] = matrixAB.m2;
+                        output->data[3] = matrixAB.m3;
+                        output->data[4] = matrixAB.m4;
+                        output->data[5] = matrixAB.m5;
+                        output->data[6] = matrixAB.m6;
+                        output->data[7] = matrixAB.m7;
+                        output->data[8] = matrixAB.m8;
+                        output->data[9] = matrixAB.m9;
+                        output->data[10] = matrixAB.m10;
+                        output->data[11] = matrixAB.m11;
+                        output->data[12] = matrixAB.m12;
+                        output->data[13] = matrixAB.m13;
+                        output->data[14] = matrixAB.m14;
+                        output->data[15] = matrixAB.m15;
+                    }
+                } break;
+                case FNODE_TRANSPOSE:
+                {
+                    Matrix matrix = { output->data[0], output->data[1], output->data[2], output->data[3], 
+                    output->data[4], output->data[5], output->data[6], output->data[7], 
+                    output->data[8], output->data[9], output->data[10], output->data[11], 
+                    output->data[12], output->data[13], output->data[14], output->data[15], };
+                    FMatrixTranspose(&matrix);
+
+                    output->data[0] = matrix.m0;
+                    output->data[1] = matrix.m1;
+                    output->data[2] = matrix.m2;
+                    output->data[3] = matrix.m3;
+                    output->data[4] = matrix.m4;
+                    output->data[5] = matrix.m5;
+                    output->data[6] = matrix.m6;
+                    output->data[7] = matrix.m7;
+                    output->data[8] = matrix.m8;
+                    output->data[9] = matrix.m9;
+                    output->data[10] = matrix.m10;
+                    output->data[11] = matrix.m11;
+                    output->data[12] = matrix.m12;
+                    output->data[13] = matrix.m13;
+                    output->data[14] = matrix.m14;
+                    output->data[15] = matrix.m15;
+                } break;
+                case FNODE_PROJECTION:
+                case FNODE_REJECTION:
+                {
+                    if (instruction->inputsCount == 2)
+                    {
+                        int indexA = instruction->inputs[0];
+                        int indexB = instruction->inputs[1];
+
+                        switch (output->dataCount)
+                        {
+                            case 2:
+                            {
+                                Vector2 vectorA = { registers[indexA].data[0], registers[indexA].data[1] };
+                                Vector2 vectorB = { registers[indexB].data[0], registers[indexB].data[1] };
+                                Vector2 newVector = ((instruction->type == FNODE_PROJECTION) ? FVector2Projection(vectorA, vectorB) : FVector2Rejection(vectorA, vectorB));
+
+                                output->data[0] = newVector.x;
+                                output->data[1] = newVector.y;
+
+                                for (int j = 2; j < MAX_VALUES; j++) output->data[j] = 0.0f;
+                                output->dataCount = 2;
+                            } break;
+                            case 3:
+                            {
+                                Vector3 vectorA = { registers[indexA].data[0], registers[indexA].data[1], registers[indexA].data[2] };
+                                Vector3 vectorB = { registers[indexB].data[0], registers[indexB].data[1], registers[indexB].data[2] };
+                                Vector3 newVector = ((instruction->type == FNODE_PROJECTION) ? FVector3Projection(vectorA, vectorB) : FVector3Rejection(vectorA, vectorB));
+
+                                output->data[0] = newVector.x;
+                                output->data[1] = newVector.y;
+                                output->data[2] = newVector.z;
+
+                                for (int j = 3; j < MAX_VALUES; j++) output->data[j] = 0.0f;
+                                output->dataCount = 3;
+                            } break;
+                            case 4:
+                            {
+                                Vector4 vectorA = { registers[indexA].data[0], registers[indexA].data[1], registers[indexA].data[2], registers[indexA].data[3] };
+                                Vector4 vectorB = { registers[indexB].data[0], registers[indexB].data[1], registers[indexB].data[2], registers[indexB].data[3] };
+                                Vector4 newVector = ((instruction->type == FNODE_PROJECTION) ? FVector4Projection(vectorA, vectorB) : FVector4Rejection(vectorA, vectorB));
+
+                                output->data[0] = newVector.x;
+                                output->data[1] = newVector.y;
+                                output->data[2] = newVector.z;
+                                output->data[3] = newVector.w;
+
+                                for (int j = 4; j < MAX_VALUES; j++) output->data[j] = 0.0f;
+                                output->dataCount = 4;
+                            } break;
+                            default: break;
+                        }
+                    }
+                    else
+                    {
+                        for (int j = 0; j < MAX_VALUES; j++) output->data[j] = 0.0f;
+                        output->dataCount = 0;
+                    }
+                } break;
+                case FNODE_HALFDIRECTION:
+                {
+                    if (instruction->inputsCount == 2)
+                    {
+                        int indexA = instruction->inputs[0];
+                        int indexB = instruction->inputs[1];
+
+                        bool check = true;
+                        check = ((ctx->nodesTape[indexA].type <= FNODE_E) || (ctx->nodesTape[indexA].type >= FNODE_MATRIX));
+                        if (check) check = ((ctx->nodesTape[indexB].type <= FNODE_E) || (ctx->nodesTape[indexB].type >= FNODE_MATRIX));
+
+                        if (check)
+                        {
+                            switch (output->dataCount)
+                            {
+                                case 2:
+                                {
+                                    Vector2 a = { registers[indexA].data[0], registers[indexA].data[1] };
+                                    Vector2 b = { registers[indexB].data[0], registers[indexB].data[1] };
+                                    Vector2 vectorA = FVector2Normalize(a);
+                                    Vector2 vectorB = FVector2Normalize(b);
+                                    Vector2 half = { vectorA.x + vectorB.x, vectorA.y + vectorB.y };
+
+                                    output->data[0] = half.x;
+                                    output->data[1] = half.y;
+
+                                    for (int j = 2; j < MAX_VALUES; j++) output->data[j] = 0.0f;
+                                    output->dataCount = 2;
+                                } break;
+                                case 3:
+                                {
+                                    Vector3 a = { registers[indexA].data[0], registers[indexA].data[1], registers[indexA].data[2] };
+                                    Vector3 b = { registers[indexB].data[0], registers[indexB].data[1], registers[indexB].data[2] };
+                                    Vector3 vectorA = FVector3Normalize(a);
+                                    Vector3 vectorB = FVector3Normalize(b);
+                                    Vector3 half = { vectorA.x + vectorB.x, vectorA.y + vectorB.y, vectorA.z + vectorB.z };
+
+                                    output->data[0] = half.x;
+                                    output->data[1] = half.y;
+                                    output->data[2] = half.z;
+
+                                    for (int j = 3; j < MAX_VALUES; j++) output->data[j] = 0.0f;
+                                    output->dataCount = 3;
+                                } break;
+                                case 4:
+                                {
+                                    Vector4 a = { registers[indexA].data[0], registers[indexA].data[1], registers[indexA].data[2], registers[indexA].data[3] };
+                                    Vector4 b = { registers[indexB].data[0], registers[indexB].data[1], registers[indexB].data[2], registers[indexB].data[3] };
+                                    Vector4 vectorA = FVector4Normalize(a);
+                                    Vector4 vectorB = FVector4Normalize(b);
+                                    Vector4 half = { vectorA.x + vectorB.x, vectorA.y + vectorB.y, vectorA.z + vectorB.z, vectorA.w + vectorB.w };
+
+                                    output->data[0] = half.x;
+                                    output->data[1] = half.y;
+                                    output->data[2] = half.z;
+                                    output->data[3] = half.w;
+
+                                    for (int j = 4; j < MAX_VALUES; j++) output->data[j] = 0.0f;
+                                    output->dataCount = 4;
+                                } break;
+                                default: break;
+                            }
+                        }
+                        else
+                        {
+                            for (int j = 0; j < MAX_VALUES; j++) output->data[j] = 0.0f;
+                        }
+                    }
+                    else
+                    {
+                        for (int j = 0; j < MAX_VALUES; j++) output->data[j] = 0.0f;
+                        output->dataCount = 0;
+                    }
+                }
+                case FNODE_SAMPLER2D:
+                {
+                    if (instruction->inputsCount == 2)
+                    {
+                        int indexA = instruction->inputs[1];
+                        switch ((int)registers[indexA].data[0])
+                        {
+                            case 0: output->dataCount = 4; break;
+                            case 1: output->dataCount = 3; break;
+                            default: output->dataCount = 1; break;
+                        }
+                    }
+                    else
+                    {
+                        for (int j = 0; j < MAX_VALUES; j++) output->data[j] = 0.0f;
+                        output->dataCount = 0;
+                    }
+                } break;
+                default: break;
+            }
+        }
+        else
+        {
+            for (int k = 0; k < MAX_VALUES; k++) output->data[k] = 0.0f;
+            output->dataCount = 0;
+        }
+    }
+
+    return (memcmp(&previous, output, sizeof(FNodeOutput)) != 0);
+}
+
+// Calculates an output node values for every batch vertex, pixel or time sample (returns false if not calculated)
+static bool CalculateBatch(FNodeContext *ctx, FBatch *batch, FNode output)
+{
+    if (output == NULL)
+    {
+        TraceLogFNode(true, "error trying to calculate a batch of a null referenced node");
+        return false;
+    }
+
+    UpdateValues(ctx);
+    if (ctx->scheduleDirty) BuildNodesSchedule(ctx);
+
+    if ((output->scheduleIndex == -1) || (output->scheduleIndex >= ctx->nodesScheduleAcyclicCount))
+    {
+        TraceLogFNode(false, "batch cannot be calculated from node %i (it is not scheduled or it depends on a cycle)", output->id);
+        return false;
+    }
+
+    batch->outputPosition = output->scheduleIndex;
+    batch->threadsCount = 1;
+
+    batch->offsets = (int *)FNODE_MALLOC(sizeof(int)*ctx->nodesScheduleCount);
+    batch->shapes = (FNodeOutput *)FNODE_MALLOC(sizeof(FNodeOutput)*ctx->nodesScheduleCount);
+    if ((batch->offsets == NULL) || (batch->shapes == NULL)) TraceLogFNode(true, "error trying to allocate batch calculation data");
+    ctx->usedMemory += (sizeof(int) + sizeof(FNodeOutput))*ctx->nodesScheduleCount;
+
+    // Inputs are always scheduled before the nodes using them, so a backwards pass finds every node output node depends on
+    for (int s = 0; s < ctx->nodesScheduleCount; s++) batch->offsets[s] = -1;
+    batch->offsets[batch->outputPosition] = 0;
+
+    for (int s = batch->outputPosition; s >= 0; s--)
+    {
+        if (batch->offsets[s] == -1) continue;
+        for (int k = 0; k < ctx->nodesTape[s].inputsCount; k++) batch->offsets[ctx->nodesTape[s].inputs[k]] = 0;
+    }
+
+    // First item calculation gives every output data count, which are the same for every vertex, pixel or time sample
+    memcpy(batch->shapes, ctx->registers, sizeof(FNodeOutput)*ctx->nodesScheduleCount);
+
+    for (int s = 0; s <= batch->outputPosition; s++)
+    {
+        if (batch->offsets[s] == -1) continue;
+
+        FInstruction *instruction = &ctx->nodesTape[s];
+
+        if (instruction->type <= FNODE_VECTOR4)
+        {
+            batch->shapes[s] = ctx->nodesSchedule[s]->output;
+
+            if (instruction->type == FNODE_TIME)
+            {
+                batch->shapes[s].data[0] = batch->time;
+                batch->shapes[s].dataCount = 1;
+            }
+            else if ((batch->type == BATCH_PIXELS) && (instruction->type == FNODE_VIEWDIRECTION))
+            {
+                // Sphere preview is viewed from positive z axis
+                batch->shapes[s].data[0] = 0.0f;
+                batch->shapes[s].data[1] = 0.0f;
+                batch->shapes[s].data[2] = 1.0f;
+                batch->shapes[s].dataCount = 3;
+            }
+        }
+        else if ((instruction->source != -1) && (batch->offsets[instruction->source] != -1)) batch->shapes[s] = batch->shapes[instruction->source];
+        else ExecuteInstruction(ctx, batch->shapes, s);
+
+        batch->offsets[s] = batch->lanesSize;
+        batch->lanesSize += batch->shapes[s].dataCount*BATCH_LANES;
+    }
+
+#if defined(FNODE_PARALLEL)
+    if (batch->itemsCount >= PARALLEL_MIN_ITEMS)
+    {
+        if (ctx->workers == NULL) ctx->workers = CreateWorkers(ctx);
+        batch->threadsCount = FNODE_PARALLEL_THREADS;
+    }
+#endif
+
+    batch->lanes = (float *)FNODE_MALLOC(sizeof(float)*batch->lanesSize*batch->threadsCount);
+    batch->registers = (FNodeOutput *)FNODE_MALLOC(sizeof(FNodeOutput)*ctx->nodesScheduleCount*batch->threadsCount);
+    if (((batch->lanes == NULL) && (batch->lanesSize > 0)) || (batch->registers == NULL)) TraceLogFNode(true, "error trying to allocate batch calculation lanes");
+    ctx->usedMemory += (sizeof(float)*batch->lanesSize + sizeof(FNodeOutput)*ctx->nodesScheduleCount)*batch->threadsCount;
+
+    batch->outputCount = batch->shapes[batch->outputPosition].dataCount;
+    ctx->batch = batch;
+
+#if defined(FNODE_PARALLEL)
+    if (batch->threadsCount > 1)
+    {
+        ctx->workers->job = CalculateBatchShare;
+        WaitWorkers(ctx->workers);
+    }
+#endif
+
+    CalculateBatchShare(ctx, 0);
+
+    ctx->batch = NULL;
+
+    FNODE_FREE(batch->registers);
+    FNODE_FREE(batch->lanes);
+    FNODE_FREE(batch->shapes);
+    FNODE_FREE(batch->offsets);
+    ctx->usedMemory -= (sizeof(float)*batch->lanesSize + sizeof(FNodeOutput)*ctx->nodesScheduleCount)*batch->threadsCount;
+    ctx->usedMemory -= (sizeof(int) + sizeof(FNodeOutput))*ctx->nodesScheduleCount;
+
+    return true;
+}
+
+// Calculates a thread share of current batch chunks
+static void CalculateBatchShare(FNodeContext *ctx, int index)
+{
+    FBatch *batch = ctx->batch;
+    float *lanes = batch->lanes + batch->lanesSize*index;
+    FNodeOutput *registers = batch->registers + ctx->nodesScheduleCount*index;
+    bool discarded[BATCH_LANES] = { 0 };
+
+    memcpy(registers, batch->shapes, sizeof(FNodeOutput)*ctx->nodesScheduleCount);
+
+    // Constant nodes values are the same for every item, so their lanes are filled once (bound ones are loaded again by every chunk)
+    for (int s = 0; s <= batch->outputPosition; s++)
+    {
+        if ((batch->offsets[s] != -1) && (ctx->nodesTape[s].type <= FNODE_VECTOR4))
+        {
+            for (int c = 0; c < batch->shapes[s].dataCount; c++)
+            {
+                for (int l = 0; l < BATCH_LANES; l++) lanes[batch->offsets[s] + c*BATCH_LANES + l] = batch->shapes[s].data[c];
+            }
+        }
+    }
+
+    int chunksCount = (batch->itemsCount + BATCH_LANES - 1)/BATCH_LANES;
+
+    for (int chunk = index; chunk < chunksCount; chunk += batch->threadsCount)
+    {
+        int first = chunk*BATCH_LANES;
+        int count = (((batch->itemsCount - first) < BATCH_LANES) ? (batch->itemsCount - first) : BATCH_LANES);
+
+        for (int l = 0; l < BATCH_LANES; l++) discarded[l] = false;
+
+        for (int s = 0; s <= batch->outputPosition; s++)
+        {
+            if (batch->offsets[s] == -1) continue;
+
+            FInstruction *instruction = &ctx->nodesTape[s];
+            float *output = lanes + batch->offsets[s];
+            int dataCount = batch->shapes[s].dataCount;
+
+            if (LoadBatchLanes(ctx, lanes, s, first, count, discarded)) continue;
+            else if (instruction->type <= FNODE_VECTOR4) continue;
+            else if ((instruction->source != -1) && (batch->offsets[instruction->source] != -1)) memcpy(output, lanes + batch->offsets[instruction->source], sizeof(float)*dataCount*BATCH_LANES);
+            else if (!ExecuteLanesInstruction(ctx, lanes, s))
+            {
+                // Instructions without lanes kernel are executed one item at a time over thread registers
+                for (int l = 0; l < count; l++)
+                {
+                    for (int k = 0; k < instruction->inputsCount; k++)
+                    {
+                        int input = instruction->inputs[k];
+                        for (int c = 0; c < batch->shapes[input].dataCount; c++) registers[input].data[c] = lanes[batch->offsets[input] + c*BATCH_LANES + l];
+                    }
+
+                    registers[s] = batch->shapes[s];
+                    ExecuteInstruction(ctx, registers, s);
+
+                    for (int c = 0; c < dataCount; c++) output[c*BATCH_LANES + l] = registers[s].data[c];
+                }
+            }
+        }
+
+        float *output = lanes + batch->offsets[batch->outputPosition];
+        int dataCount = batch->shapes[batch->outputPosition].dataCount;
+
+        if (batch->type == BATCH_PIXELS)
+        {
+            // Output values are converted to colors as fragment shader final color (single values are gray, missing components are 0 and alpha is 1)
+            for (int l = 0; l < count; l++)
+            {
+                unsigned char *pixel = batch->pixels + (first + l)*4;
+
+                for (int c = 0; c < 4; c++)
+                {
+                    float value = 0.0f;
+
+                    if (discarded[l]) value = 0.0f;
+                    else if (dataCount == 1) value = ((c < 3) ? output[l] : 1.0f);
+                    else if (c < dataCount) value = output[c*BATCH_LANES + l];
+                    else if (c == 3) value = 1.0f;
+
+                    value = ((value < 0.0f) ? 0.0f : ((value > 1.0f) ? 1.0f : value));
+                    pixel[c] = (unsigned char)(value*255.0f + 0.5f);
+                }
+            }
+        }
+        else if (batch->type == BATCH_TIMES)
+        {
+            for (int c = 0; c < dataCount; c++) memcpy(batch->curves + c*batch->itemsCount + first, output + c*BATCH_LANES, sizeof(float)*count);
+        }
+        else
+        {
+            for (int l = 0; l < count; l++)
+            {
+                for (int c = 0; c < 3; c++) batch->positions[(first + l)*3 + c] = ((c < dataCount) ? output[c*BATCH_LANES + l] : 0.0f);
+            }
+        }
+    }
+
+#if defined(FNODE_PARALLEL)
+    // Threads pool threads must be done with current chunks before caller thread releases them
+    if (batch->threadsCount > 1) WaitWorkers(ctx->workers);
+#endif
+}
+
+// Loads vertices, pixels or time samples data bound to a node into its lanes and returns false if node is not bound
+static bool LoadBatchLanes(FNodeContext *ctx, float *lanes, int position, int first, int count, bool *discarded)
+{
+    FBatch *batch = ctx->batch;
+    FInstruction *instruction = &ctx->nodesTape[position];
+    float *output = lanes + batch->offsets[position];
+    int dataCount = batch->shapes[position].dataCount;
+
+    // Time samples only change time nodes, the rest of nodes are calculated as values calculation does
+    if ((batch->type == BATCH_TIMES) != (instruction->type == FNODE_TIME)) return false;
+
+    switch (instruction->type)
+    {
+        case FNODE_TIME:
+        {
+            for (int l = 0; l < count; l++) output[l] = batch->times[first + l];
+        } break;
+        case FNODE_VERTEXPOSITION:
+        case FNODE_VERTEXNORMAL:
+        case FNODE_FRESNEL:
+        {
+            if (batch->type == BATCH_PIXELS)
+            {
+                // Preview pixels cover a sphere of radius 1 viewed from positive z axis, so its positions are its normals too
+                for (int l = 0; l < count; l++)
+                {
+                    float x = 2.0f*((float)((first + l)%batch->width) + 0.5f)/(float)batch->width - 1.0f;
+                    float y = 1.0f - 2.0f*((float)((first + l)/batch->width) + 0.5f)/(float)batch->height;
+                    Vector3 normal = { x, y, 1.0f - x*x - y*y };
+
+                    if (normal.z > 0.0f) normal.z = (float)sqrt(normal.z);
+                    else normal = FVector3Normalize((Vector3){ x, y, 0.0f });
+
+                    if (instruction->type == FNODE_FRESNEL) output[l] = 1.0f - normal.z;
+                    else
+                    {
+                        float values[3] = { normal.x, normal.y, normal.z };
+                        for (int c = 0; (c < dataCount) && (c < 3); c++) output[c*BATCH_LANES + l] = values[c];
+                    }
+                }
+            }
+            else if (instruction->type != FNODE_FRESNEL)
+            {
+                float *vertices = ((instruction->type == FNODE_VERTEXPOSITION) ? batch->mesh.vertices : batch->mesh.normals);
+
+                for (int c = 0; c < dataCount; c++)
+                {
+                    for (int l = 0; l < count; l++) output[c*BATCH_LANES + l] = (((vertices != NULL) && (c < 3)) ? vertices[(first + l)*3 + c] : 0.0f);
+                }
+            }
+            else return false;
+        } break;
+        case FNODE_VERTEXCOLOR:
+        case FNODE_SAMPLER2D:
+        {
+            // Color mode input selects rgba (0), rgb (1) or a single channel (2 = r, 3 = g, 4 = b, 5 = a)
+            int modeInput = ((instruction->type == FNODE_VERTEXCOLOR) ? 0 : 1);
+            int mode = ((instruction->inputsCount == (modeInput + 1)) ? (int)batch->shapes[instruction->inputs[modeInput]].data[0] : -1);
+
+            if ((instruction->type == FNODE_SAMPLER2D) && (batch->type != BATCH_PIXELS)) return false;
+
+            for (int l = 0; l < count; l++)
+            {
+                // Preview has no mesh colors, so vertex colors are white as mesh default colors
+                Vector4 color = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+                if (instruction->type == FNODE_SAMPLER2D)
+                {
+                    int unit = (int)batch->shapes[instruction->inputs[0]].data[0];
+                    float u = ((float)((first + l)%batch->width) + 0.5f)/(float)batch->width;
+                    float v = ((float)((first + l)/batch->width) + 0.5f)/(float)batch->height;
+
+                    if ((unit >= 0) && (unit < batch->texturesCount)) color = FImageBilinear(batch->textures[unit], u, v);
+                    else color = (Vector4){ 0.0f, 0.0f, 0.0f, 1.0f };
+
+                    // Fragment shader discards transparent pixels of rgba and alpha samplers
+                    if (((mode == 0) || (mode == 5)) && (color.w == 0.0f)) discarded[l] = true;
+                }
+                else if (batch->type == BATCH_VERTICES)
+                {
+                    if (batch->mesh.colors != NULL)
+                    {
+                        unsigned char *texel = batch->mesh.colors + (first + l)*4;
+                        color = (Vector4){ (float)texel[0]/255.0f, (float)texel[1]/255.0f, (float)texel[2]/255.0f, (float)texel[3]/255.0f };
+                    }
+                }
+
+                float channels[4] = { color.x, color.y, color.z, color.w };
+
+                for (int c = 0; c < dataCount; c++)
+                {
+                    int channel = (((mode == 0) || (mode == 1)) ? c : mode - 2);
+                    output[c*BATCH_LANES + l] = (((channel >= 0) && (channel < 4)) ? channels[channel] : 0.0f);
+                }
+            }
+        } break;
+        default: return false;
+    }
+
+    return true;
+}
+
+// Executes a nodes tape instruction over every lane and returns false if it has no lanes kernel
+static bool ExecuteLanesInstruction(FNodeContext *ctx, float *lanes, int position)
+{
+    FBatch *batch = ctx->batch;
+    FInstruction *instruction = &ctx->nodesTape[position];
+    int dataCount = batch->shapes[position].dataCount;
+    int count = dataCount*BATCH_LANES;
+
+    if ((instruction->inputsCount == 0) || (dataCount == 0)) return false;
+    if (batch->shapes[instruction->inputs[0]].dataCount != dataCount) return false;
+
+    // Lanes kernels work component by component, so every input must have output data count (or a single value to scale it)
+    for (int k = 1; k < instruction->inputsCount; k++)
+    {
+        int input = instruction->inputs[k];
+        int inputCount = batch->shapes[input].dataCount;
+
+        switch (instruction->type)
+        {
+            case FNODE_ADD:
+            case FNODE_SUBTRACT: if (inputCount != dataCount) return false; break;
+            case FNODE_MULTIPLY: if ((inputCount != dataCount) && (inputCount != 1) && !CheckLanesTransform(ctx, position, input)) return false; break;
+            case FNODE_DIVIDE: if ((inputCount != dataCount) && (inputCount != 1)) return false; break;
+            default: break;
+        }
+    }
+
+    float *output = lanes + batch->offsets[position];
+
+    switch (instruction->type)
+    {
+        case FNODE_ADD:
+        case FNODE_SUBTRACT:
+        case FNODE_MULTIPLY:
+        case FNODE_DIVIDE:
+        case FNODE_ONEMINUS:
+        case FNODE_ABS:
+        case FNODE_COS:
+        case FNODE_SIN:
+        case FNODE_TAN:
+        case FNODE_DEG2RAD:
+        case FNODE_RAD2DEG:
+        case FNODE_NEGATE:
+        case FNODE_RECIPROCAL:
+        case FNODE_SQRT:
+        case FNODE_TRUNC:
+        case FNODE_ROUND:
+        case FNODE_CEIL:
+        case FNODE_CLAMP01:
+        case FNODE_EXP2:
+        case FNODE_VERTEX:
+        case FNODE_FRAGMENT: memcpy(output, lanes + batch->offsets[instruction->inputs[0]], sizeof(float)*count); break;
+        default: return false;
+    }
+
+    for (int k = 1; k < instruction->inputsCount; k++)
+    {
+        float *input = lanes + batch->offsets[instruction->inputs[k]];
+        bool single = (batch->shapes[instruction->inputs[k]].dataCount == 1);
+
+        switch (instruction->type)
+        {
+            case FNODE_ADD: FLanesAdd(output, input, count); break;
+            case FNODE_SUBTRACT: FLanesSubtract(output, input, count); break;
+            case FNODE_MULTIPLY:
+            {
+                if (single)
+                {
+                    for (int c = 0; c < dataCount; c++) FLanesMultiply(output + c*BATCH_LANES, input, BATCH_LANES);
+                }
+                else if (CheckLanesTransform(ctx, position, instruction->inputs[k]))
+                {
+                    // Matrix is built from its last 12 values and applied once per vector component, as values calculation does
+                    Matrix matrix = { 0 };
+                    memcpy(&matrix, batch->shapes[instruction->inputs[k]].data + 4, sizeof(float)*12);
+
+                    for (int c = 0; c < dataCount; c++) FLanesTransform(output, BATCH_LANES, &matrix, BATCH_LANES);
+                }
+                else FLanesMultiply(output, input, count);
+            } break;
+            case FNODE_DIVIDE:
+            {
+                if (single)
+                {
+                    for (int c = 0; c < dataCount; c++) FLanesDivide(output + c*BATCH_LANES, input, BATCH_LANES);
+                }
+                else FLanesDivide(output, input, count);
+            } break;
+            default: break;
+        }
+    }
+
+    bool fast = (ctx->batchAccuracy == FNODE_ACCURACY_FAST);
+
+    switch (instruction->type)
+    {
+        case FNODE_ONEMINUS: FLanesOneMinus(output, count); break;
+        case FNODE_ABS: FLanesAbs(output, count); break;
+        case FNODE_COS:
+        {
+            if (fast) FLanesSinCos(output, 1, count);
+            else for (int j = 0; j < count; j++) output[j] = (float)FCos(output[j]);
+        } break;
+        case FNODE_SIN:
+        {
+            if (fast) FLanesSinCos(output, 0, count);
+            else for (int j = 0; j < count; j++) output[j] = (float)FSin(output[j]);
+        } break;
+        case FNODE_TAN:
+        {
+            if (fast) FLanesTan(output, count);
+            else for (int j = 0; j < count; j++) output[j] = (float)FTan(output[j]);
+        } break;
+        case FNODE_DEG2RAD: FLanesScale(output, DEG2RAD, count); break;
+        case FNODE_RAD2DEG: FLanesScale(output, RAD2DEG, count); break;
+        case FNODE_NEGATE: FLanesScale(output, -1.0f, count); break;
+        case FNODE_RECIPROCAL: FLanesReciprocal(output, count); break;
+        case FNODE_SQRT: FLanesSquareRoot(output, count); break;
+        case FNODE_TRUNC:
+        {
+            for (int j = 0; j < count; j++) output[j] = FTrunc(output[j]);
+        } break;
+        case FNODE_ROUND:
+        {
+            for (int j = 0; j < count; j++) output[j] = FRound(output[j]);
+        } break;
+        case FNODE_CEIL:
+        {
+            for (int j = 0; j < count; j++) output[j] = FCeil(output[j]);
+        } break;
+        case FNODE_CLAMP01: FLanesClamp(output, 0.0f, 1.0f, count); break;
+        case FNODE_EXP2:
+        {
+            if (fast) FLanesExp2(output, count);
+            else for (int j = 0; j < count; j++) output[j] = FPower(2.0f, output[j]);
+        } break;
+        default: break;
+    }
+
+    return true;
+}
+
+// Returns true if a multiply instruction transforms its vector lanes by a constant matrix input
+// NOTE: matrices are the same for every lane, any other 16 values input (like multiplied matrices) is multiplied component by component
+static bool CheckLanesTransform(FNodeContext *ctx, int position, int input)
+{
+    FBatch *batch = ctx->batch;
+
+    return ((batch->shapes[input].dataCount == 16) && (batch->shapes[position].dataCount == 4) && ((ctx->nodesTape[input].type == FNODE_MVP) || (ctx->nodesTape[input].type == FNODE_MATRIX)));
+}
+
+// Returns an image color at texture coordinates with bilinear filtering and repeat wrapping (black for missing or not R8G8B8A8 images)
+static Vector4 FImageBilinear(Image image, float u, float v)
+{
+    float values[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+
+    if ((image.data != NULL) && (image.format == UNCOMPRESSED_R8G8B8A8) && (image.width > 0) && (image.height > 0))
+    {
+        const unsigned char *texels = (const unsigned char *)image.data;
+        float x = u*(float)image.width - 0.5f;
+        float y = v*(float)image.height - 0.5f;
+        int x0 = (int)floor(x);
+        int y0 = (int)floor(y);
+        float fx = x - (float)x0;
+        float fy = y - (float)y0;
+
+        values[3] = 0.0f;
+
+        // Weight the four nearest texels by their distance to the coordinates
+        for (int j = 0; j < 4; j++)
+        {
+            int tx = (((x0 + (j & 1))%image.width) + image.width)%image.width;
+            int ty = (((y0 + (j >> 1))%image.height) + image.height)%image.height;
+            float weight = (((j & 1) ? fx : (1.0f - fx))*((j >> 1) ? fy : (1.0f - fy)));
+
+            for (int c = 0; c < 4; c++) values[c] += weight*(float)texels[(ty*image.width + tx)*4 + c]/255.0f;
+        }
+    }
+
+    return (Vector4){ values[0], values[1], values[2], values[3] };
+}
+
+#if defined(FNODE_PARALLEL)
+// Groups scheduled nodes which do not depend on cycles by dependency level
+static void BuildNodesLevels(FNodeContext *ctx)
+{
+    // Pending inputs are not needed once nodes are scheduled, so they store every position level
+    int *levels = ctx->nodesPendingInputs;
+
+    ctx->levelsCount = 0;
+
+    // Node level is the longest inputs path length, so nodes of a level only depend on nodes of previous levels
+    for (int s = 0; s < ctx->nodesScheduleAcyclicCount; s++)
+    {
+        levels[s] = 0;
+
+        for (int k = 0; k < ctx->nodesTape[s].inputsCount; k++)
+        {
+            int level = levels[ctx->nodesTape[s].inputs[k]] + 1;
+            if (level > levels[s]) levels[s] = level;
+        }
+
+        // Nodes which copy an equivalent node register are calculated after it
+        if ((ctx->nodesTape[s].source != -1) && (levels[ctx->nodesTape[s].source] >= levels[s])) levels[s] = levels[ctx->nodesTape[s].source] + 1;
+
+        if (levels[s] >= ctx->levelsCount) ctx->levelsCount = levels[s] + 1;
+    }
+
+    // Positions are sorted by level keeping calculation order inside every level
+    for (int l = 0; l < ctx->levelsCount; l++) ctx->levelsEnd[l] = 0;
+    for (int s = 0; s < ctx->nodesScheduleAcyclicCount; s++) ctx->levelsEnd[levels[s]]++;
+    for (int l = 1; l < ctx->levelsCount; l++) ctx->levelsEnd[l] += ctx->levelsEnd[l - 1];
+
+    for (int s = ctx->nodesScheduleAcyclicCount - 1; s >= 0; s--)
+    {
+        ctx->levelsEnd[levels[s]]--;
+        ctx->levelsPositions[ctx->levelsEnd[levels[s]]] = s;
+    }
+
+    // Every level end is moved from its start to next level start
+    for (int l = 0; l < (ctx->levelsCount - 1); l++) ctx->levelsEnd[l] = ctx->levelsEnd[l + 1];
+    if (ctx->levelsCount > 0) ctx->levelsEnd[ctx->levelsCount - 1] = ctx->nodesScheduleAcyclicCount;
+}
+
+// Creates a nodes calculation threads pool
+static FWorkers *CreateWorkers(FNodeContext *ctx)
+{
+    FWorkers *pool = (FWorkers *)FNODE_MALLOC(sizeof(FWorkers));
+    if (pool == NULL) TraceLogFNode(true, "error trying to allocate a nodes calculation threads pool");
+
+    memset(pool, 0, sizeof(FWorkers));
+    ctx->usedMemory += sizeof(FWorkers);
+
+    pool->ctx = ctx;
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->condition, NULL);
+
+    for (int i = 0; i < (FNODE_PARALLEL_THREADS - 1); i++)
+    {
+        pool->threads[i].pool = pool;
+        pool->threads[i].index = i + 1;
+
+        if (pthread_create(&pool->threads[i].thread, NULL, WorkerThread, &pool->threads[i]) != 0) TraceLogFNode(true, "error trying to create a nodes calculation thread");
+    }
+
+    TraceLogFNode(false, "nodes calculation threads pool created (%i threads) [USED RAM: %i bytes]", FNODE_PARALLEL_THREADS, ctx->usedMemory);
+
+    return pool;
+}
+
+// Stops and destroys a nodes calculation threads pool
+static void DestroyWorkers(FNodeContext *ctx, FWorkers *pool)
+{
+    pool->quit = true;
+    WaitWorkers(pool);
+
+    for (int i = 0; i < (FNODE_PARALLEL_THREADS - 1); i++) pthread_join(pool->threads[i].thread, NULL);
+
+    pthread_cond_destroy(&pool->condition);
+    pthread_mutex_destroy(&pool->mutex);
+
+    FNODE_FREE(pool);
+    ctx->usedMemory -= sizeof(FWorkers);
+    if (ctx->workers == pool) ctx->workers = NULL;
+}
+
+// Waits until every threads pool thread (and caller thread) arrives
+static void WaitWorkers(FWorkers *pool)
+{
+    pthread_mutex_lock(&pool->mutex);
+
+    unsigned int generation = pool->generation;
+    pool->arrived++;
+
+    if (pool->arrived == FNODE_PARALLEL_THREADS)
+    {
+        pool->arrived = 0;
+        pool->generation++;
+        pthread_cond_broadcast(&pool->condition);
+    }
+    else
+    {
+        while (generation == pool->generation) pthread_cond_wait(&pool->condition, &pool->mutex);
+    }
+
+    pthread_mutex_unlock(&pool->mutex);
+}
+
+// Calculates a thread share of every dependency level nodes values
+static void CalculateLevels(FNodeContext *ctx, int index)
+{
+    bool shared = false;
+
+    for (int l = 0; l < ctx->levelsCount; l++)
+    {
+        int start = ((l > 0) ? ctx->levelsEnd[l - 1] : 0);
+        int end = ctx->levelsEnd[l];
+
+        // Narrow levels are not worth threads synchronization, so caller thread calculates them alone
+        if ((end - start) < PARALLEL_MIN_LEVEL)
+        {
+            if (shared) WaitWorkers(ctx->workers);
+            shared = false;
+
+            if (index == 0)
+            {
+                for (int i = start; i < end; i++)
+                {
+                    int p = ctx->levelsPositions[i];
+                    if (CalculateNodeValues(ctx, p)) ctx->nodesSchedule[p]->textDirty = true;
+                    ctx->nodesSchedule[p]->dirty = false;
+                }
+            }
+        }
+        else
+        {
+            // Threads wait for previous levels values before calculating its share of current level
+            WaitWorkers(ctx->workers);
+            shared = true;
+
+            int first = start + (end - start)*index/FNODE_PARALLEL_THREADS;
+            int last = start + (end - start)*(index + 1)/FNODE_PARALLEL_THREADS;
+
+            for (int i = first; i < last; i++)
+            {
+                int p = ctx->levelsPositions[i];
+                if (CalculateNodeValues(ctx, p)) ctx->nodesSchedule[p]->textDirty = true;
+                ctx->nodesSchedule[p]->dirty = false;
+            }
+        }
+    }
+
+    // Threads pool threads must be done with current levels before caller thread can change them
+    WaitWorkers(ctx->workers);
+}
+
+// Threads pool thread loop, runs pool job every time caller thread starts
+static void *WorkerThread(void *data)
+{
+    FWorker *worker = (FWorker *)data;
+
+    while (true)
+    {
+        WaitWorkers(worker->pool);
+        if (worker->pool->quit) break;
+
+        worker->pool->job(worker->pool->ctx, worker->index);
+    }
+
+    return NULL;
+}
+#endif
+
+// Doubles the lines pool capacity
+static void GrowLinesPool(FNodeContext *ctx)
+{
+    int capacity = ((ctx->linesCapacity > 0) ? ctx->linesCapacity*2 : INITIAL_LINES_CAPACITY);
+    if (capacity > (HANDLE_INDEX_MASK + 1)) TraceLogFNode(true, "lines pool capacity cannot be increased over handles ids limit (%i)", (HANDLE_INDEX_MASK + 1));
+
+    ctx->lines = (FLine *)FResizeArray(ctx, ctx->lines, ctx->linesCapacity*sizeof(FLine), capacity*sizeof(FLine));
+    ctx->linesIndex = (int *)FResizeArray(ctx, ctx->linesIndex, ctx->linesCapacity*sizeof(int), capacity*sizeof(int));
+    ctx->linesGenerations = (unsigned short *)FResizeArray(ctx, ctx->linesGenerations, ctx->linesCapacity*sizeof(unsigned short), capacity*sizeof(unsigned short));
+
+    for (int i = ctx->linesCapacity; i < capacity; i++)
+    {
+        ctx->lines[i] = NULL;
+        ctx->linesIndex[i] = -1;
+        ctx->linesGenerations[i] = 1;
+    }
+
+    if (ctx->linesIds.bits == NULL) InitIdAllocator(ctx, &ctx->linesIds, capacity);
+    else GrowIdAllocator(ctx, &ctx->linesIds, capacity);
+
+    ctx->linesCapacity = capacity;
+
+    TraceLogFNode(false, "lines pool capacity increased to %i [USED RAM: %i bytes]", ctx->linesCapacity, ctx->usedMemory);
+}
+
+// Doubles the comments pool capacity
+static void GrowCommentsPool(FNodeContext *ctx)
+{
+    int capacity = ((ctx->commentsCapacity > 0) ? ctx->commentsCapacity*2 : INITIAL_COMMENTS_CAPACITY);
+
+    ctx->comments = (FComment *)FResizeArray(ctx, ctx->comments, ctx->commentsCapacity*sizeof(FComment), capacity*sizeof(FComment));
+    for (int i = ctx->commentsCapacity; i < capacity; i++) ctx->comments[i] = NULL;
+
+    if (ctx->commentsIds.bits == NULL) InitIdAllocator(ctx, &ctx->commentsIds, capacity);
+    else GrowIdAllocator(ctx, &ctx->commentsIds, capacity);
+
+    ctx->commentsCapacity = capacity;
+
+    TraceLogFNode(false, "comments pool capacity increased to %i [USED RAM: %i bytes]", ctx->commentsCapacity, ctx->usedMemory);
+}
+
+// Returns a block from an arena allocator
+static void *ArenaAlloc(FNodeContext *ctx, FArena *arena)
+{
+    void *block = NULL;
+    int blockSize = (arena->blockSize + 15) & ~15;
+    int headerSize = (sizeof(FArenaChunk) + 15) & ~15;
+
+    if (arena->freeBlocks != NULL)
+    {
+        block = arena->freeBlocks;
+        arena->freeBlocks = *(void **)block;
+    }
+    else
+    {
+        if ((arena->chunks == NULL) || (arena->chunks->used == ARENA_CHUNK_BLOCKS))
+        {
+            FArenaChunk *chunk = (FArenaChunk *)FNODE_MALLOC(headerSize + ARENA_CHUNK_BLOCKS*blockSize);
+            if (chunk == NULL) TraceLogFNode(true, "arena chunk allocation failed when trying to allocate %i bytes", headerSize + ARENA_CHUNK_BLOCKS*blockSize);
+            ctx->usedMemory += headerSize + ARENA_CHUNK_BLOCKS*blockSize;
+
+            chunk->next = arena->chunks;
+            chunk->used = 0;
+            arena->chunks = chunk;
+        }
+
+        block = (char *)arena->chunks + headerSize + arena->chunks->used*blockSize;
+        arena->chunks->used++;
+    }
+
+    return block;
+}
+
+// Releases a block to be recycled by an arena allocator
+static void ArenaFree(FArena *arena, void *block)
+{
+    if (block != NULL)
+    {
+        *(void **)block = arena->freeBlocks;
+        arena->freeBlocks = block;
+    }
+}
+
+// Releases all the chunks of an arena allocator at once
+static void ResetArena(FNodeContext *ctx, FArena *arena)
+{
+    int chunkSize = ((sizeof(FArenaChunk) + 15) & ~15) + ARENA_CHUNK_BLOCKS*((arena->blockSize + 15) & ~15);
+
+    while (arena->chunks != NULL)
+    {
+        FArenaChunk *next = arena->chunks->next;
+        FNODE_FREE(arena->chunks);
+        ctx->usedMemory -= chunkSize;
+        arena->chunks = next;
+    }
+
+    arena->freeBlocks = NULL;
+}
+
+// Removes a linked line from nodes adjacency lists
+static void UnlinkNodeLine(FNodeContext *ctx, FLine line)
+{
+    FNode fromNode = GetNodeFromHandle(ctx, line->from);
+    FNode toNode = GetNodeFromHandle(ctx, line->to);
+
+    // Remove line from end node inputs keeping inputs link order
+    for (int i = 0; i < toNode->inputsCount; i++)
+    {
+        if (toNode->inputLines[i] == line)
+        {
+            for (int k = i; k < (toNode->inputsCount - 1); k++)
+            {
+                toNode->inputs[k] = toNode->inputs[k + 1];
+                toNode->inputLines[k] = toNode->inputLines[k + 1];
+            }
+
+            toNode->inputsCount--;
+            toNode->inputs[toNode->inputsCount] = -1;
+            toNode->inputLines[toNode->inputsCount] = NULL;
+            break;
+        }
+    }
+
+    // Remove line from start node outputs list
+    if (line->prevOutput != NULL) line->prevOutput->nextOutput = line->nextOutput;
+    else fromNode->outputLines = line->nextOutput;
+    if (line->nextOutput != NULL) line->nextOutput->prevOutput = line->prevOutput;
+    fromNode->outputsCount--;
+
+    line->to = NULL_HANDLE;
+    line->prevOutput = NULL;
+    line->nextOutput = NULL;
+
+    ctx->scheduleDirty = true;
+    MarkNodeDirty(ctx, toNode);
+
+    if (toNode->usesCount > 0) ReleaseNodeUse(ctx, fromNode);
+}
+
+// Returns the generation of a released id handles (never 0)
+static unsigned short NextHandleGeneration(unsigned short generation)
+{
+    return ((generation >= HANDLE_GENERATION_MASK) ? 1 : (generation + 1));
+}
+
+// Returns length of a Vector2
+static float FVector2Length(Vector2 v)
+{
+    return (float)sqrt(v.x*v.x + v.y*v.y);
+}
+
+// Returns length of a Vector3
+static float FVector3Length(Vector3 v)
+{
+    return (float)sqrt(v.x*v.x + v.y*v.y + v.z*v.z);
+}
+
+// Returns length of a Vector4
+static float FVector4Length(Vector4 v)
+{
+    return (float)sqrt(v.x*v.x + v.y*v.y + v.z*v.z + v.w*v.w);
+}
+
+// Returns a normalized Vector2
+static Vector2 FVector2Normalize(Vector2 v)
+{
+    float length = FVector2Length(v);
+    return (Vector2){ v.x/length, v.y/length };
+}
+
+// Returns a normalized Vector3
+static Vector3 FVector3Normalize(Vector3 v)
+{
+    float length = FVector3Length(v);
+    return (Vector3){ v.x/length, v.y/length, v.z/length };
+}
+
+// Returns a normalized Vector4
+static Vector4 FVector4Normalize(Vector4 v)
+{
+    float length = FVector4Length(v);
+    return (Vector4){ v.x/length, v.y/length, v.z/length, v.w/length };
+}
+
+// Returns the projection vector of two Vector2
+static Vector2 FVector2Projection(Vector2 a, Vector2 b)
+{
+    Vector2 output = { 0, 0 };
+
+    float dotAB = FVector2Dot(a, b);
+    float dotBB = FVector2Dot(b, b);
+    output.x = dotAB/dotBB*b.x;
+    output.y = dotAB/dotBB*b.y;
+
+    return output;
+}
+
+// Returns the projection vector of two Vector3
+static Vector3 FVector3Projection(Vector3 a, Vector3 b)
+{
+    Vector3 output = { 0, 0, 0 };
+
+    float dotAB = FVector3Dot(a, b);
+    float dotBB = FVector3Dot(b, b);
+    output.x = dotAB/dotBB*b.x;
+    output.y = dotAB/dotBB*b.y;
     output.z = dotAB/dotBB*b.z;
 
     return output;
@@ -2415,29 +4323,35 @@ static Matrix FMatrixIdentity()
     return result;
 }
 
-// Returns the result of multiply two matrices
-static Matrix FMatrixMultiply(Matrix left, Matrix right)
-{
-    Matrix result;
-
-    result.m0 = right.m0*left.m0 + right.m1*left.m4 + right.m2*left.m8 + right.m3*left.m12;
-    result.m1 = right.m0*left.m1 + right.m1*left.m5 + right.m2*left.m9 + right.m3*left.m13;
-    result.m2 = right.m0*left.m2 + right.m1*left.m6 + right.m2*left.m10 + right.m3*left.m14;
-    result.m3 = right.m0*left.m3 + right.m1*left.m7 + right.m2*left.m11 + right.m3*left.m15;
-    result.m4 = right.m4*left.m0 + right.m5*left.m4 + right.m6*left.m8 + right.m7*left.m12;
-    result.m5 = right.m4*left.m1 + right.m5*left.m5 + right.m6*left.m9 + right.m7*left.m13;
-    result.m6 = right.m4*left.m2 + right.m5*left.m6 + right.m6*left.m10 + right.m7*left.m14;
-    result.m7 = right.m4*left.m3 + right.m5*left.m7 + right.m6*left.m11 + right.m7*left.m15;
-    result.m8 = right.m8*left.m0 + right.m9*left.m4 + right.m10*left.m8 + right.m11*left.m12;
-    result.m9 = right.m8*left.m1 + right.m9*left.m5 + right.m10*left.m9 + right.m11*left.m13;
-    result.m10 = right.m8*left.m2 + right.m9*left.m6 + right.m10*left.m10 + right.m11*left.m14;
-    result.m11 = right.m8*left.m3 + right.m9*left.m7 + right.m10*left.m11 + right.m11*left.m15;
-    result.m12 = right.m12*left.m0 + right.m13*left.m4 + right.m14*left.m8 + right.m15*left.m12;
-    result.m13 = right.m12*left.m1 + right.m13*left.m5 + right.m14*left.m9 + right.m15*left.m13;
-    result.m14 = right.m12*left.m2 + right.m13*left.m6 + right.m14*left.m10 + right.m15*left.m14;
-    result.m15 = right.m12*left.m3 + right.m13*left.m7 + right.m14*left.m11 + right.m15*left.m15;
+// Sets result as the multiplication of two matrices
+// NOTE: matrices are stored row by row, so every result row is a combination of the right matrix rows
+static void FMatrixMultiply(Matrix *result, const Matrix *left, const Matrix *right)
+{
+    const float *a = (const float *)left;
+    const float *b = (const float *)right;
+    float *values = (float *)result;
+
+#if defined(FNODE_SIMD_SSE2)
+    __m128 rows[4] = { _mm_loadu_ps(b), _mm_loadu_ps(b + 4), _mm_loadu_ps(b + 8), _mm_loadu_ps(b + 12) };
 
-    return result;
+    for (int i = 0; i < 4; i++)
+    {
+        __m128 row = _mm_mul_ps(_mm_set1_ps(a[i*4]), rows[0]);
+        row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a[i*4 + 1]), rows[1]));
+        row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a[i*4 + 2]), rows[2]));
+        row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a[i*4 + 3]), rows[3]));
+        _mm_storeu_ps(values + i*4, row);
+    }
+#else
+    float temp[16] = { 0 };
+
+    for (int i = 0; i < 4; i++)
+    {
+        for (int j = 0; j < 4; j++) temp[i*4 + j] = a[i*4]*b[j] + a[i*4 + 1]*b[4 + j] + a[i*4 + 2]*b[8 + j] + a[i*4 + 3]*b[12 + j];
+    }
+
+    for (int i = 0; i < 16; i++) values[i] = temp[i];
+#endif
 }
 
 // Returns translation matrix
@@ -2454,9 +4368,6 @@ static Matrix FMatrixTranslate(float x, float y, float z)
 // Create rotation matrix from axis and angle provided in radians
 static Matrix FMatrixRotate(Vector3 axis, float angle)
 {
-    Matrix result;
-
-    Matrix mat = FMatrixIdentity();
     float x = axis.x, y = axis.y, z = axis.z;
     float length = sqrt(x*x + y*y + z*z);
 
@@ -2472,33 +4383,11 @@ static Matrix FMatrixRotate(Vector3 axis, float angle)
     float cosres = cosf(angle);
     float t = 1.0f - cosres;
 
-    // Cache some matrix values (speed optimization)
-    float a00 = mat.m0, a01 = mat.m1, a02 = mat.m2, a03 = mat.m3;
-    float a10 = mat.m4, a11 = mat.m5, a12 = mat.m6, a13 = mat.m7;
-    float a20 = mat.m8, a21 = mat.m9, a22 = mat.m10, a23 = mat.m11;
-
-    // Construct the elements of the rotation matrix
-    float b00 = x*x*t + cosres, b01 = y*x*t + z*sinres, b02 = z*x*t - y*sinres;
-    float b10 = x*y*t - z*sinres, b11 = y*y*t + cosres, b12 = z*y*t + x*sinres;
-    float b20 = x*z*t + y*sinres, b21 = y*z*t - x*sinres, b22 = z*z*t + cosres;
-
-    // Perform rotation-specific matrix multiplication
-    result.m0 = a00*b00 + a10*b01 + a20*b02;
-    result.m1 = a01*b00 + a11*b01 + a21*b02;
-    result.m2 = a02*b00 + a12*b01 + a22*b02;
-    result.m3 = a03*b00 + a13*b01 + a23*b02;
-    result.m4 = a00*b10 + a10*b11 + a20*b12;
-    result.m5 = a01*b10 + a11*b11 + a21*b12;
-    result.m6 = a02*b10 + a12*b11 + a22*b12;
-    result.m7 = a03*b10 + a13*b11 + a23*b12;
-    result.m8 = a00*b20 + a10*b21 + a20*b22;
-    result.m9 = a01*b20 + a11*b21 + a21*b22;
-    result.m10 = a02*b20 + a12*b21 + a22*b22;
-    result.m11 = a03*b20 + a13*b21 + a23*b22;
-    result.m12 = mat.m12;
-    result.m13 = mat.m13;
-    result.m14 = mat.m14;
-    result.m15 = mat.m15;
+    // Rotation applies over identity, so its elements are the result elements
+    Matrix result = { x*x*t + cosres, x*y*t - z*sinres, x*z*t + y*sinres, 0.0f,
+                      y*x*t + z*sinres, y*y*t + cosres, y*z*t - x*sinres, 0.0f,
+                      z*x*t - y*sinres, z*y*t + x*sinres, z*z*t + cosres, 0.0f,
+                      0.0f, 0.0f, 0.0f, 1.0f };
 
     return result;
 }
@@ -2517,40 +4406,62 @@ static Matrix FMatrixScale(float x, float y, float z)
 // Transposes provided matrix
 static void FMatrixTranspose(Matrix *mat)
 {
-    Matrix temp;
+    float *values = (float *)mat;
 
-    temp.m0 = mat->m0;
-    temp.m1 = mat->m4;
-    temp.m2 = mat->m8;
-    temp.m3 = mat->m12;
-    temp.m4 = mat->m1;
-    temp.m5 = mat->m5;
-    temp.m6 = mat->m9;
-    temp.m7 = mat->m13;
-    temp.m8 = mat->m2;
-    temp.m9 = mat->m6;
-    temp.m10 = mat->m10;
-    temp.m11 = mat->m14;
-    temp.m12 = mat->m3;
-    temp.m13 = mat->m7;
-    temp.m14 = mat->m11;
-    temp.m15 = mat->m15;
+#if defined(FNODE_SIMD_SSE2)
+    __m128 row0 = _mm_loadu_ps(values);
+    __m128 row1 = _mm_loadu_ps(values + 4);
+    __m128 row2 = _mm_loadu_ps(values + 8);
+    __m128 row3 = _mm_loadu_ps(values + 12);
 
-    *mat = temp;
+    _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+    _mm_storeu_ps(values, row0);
+    _mm_storeu_ps(values + 4, row1);
+    _mm_storeu_ps(values + 8, row2);
+    _mm_storeu_ps(values + 12, row3);
+#else
+    for (int i = 0; i < 4; i++)
+    {
+        for (int j = i + 1; j < 4; j++)
+        {
+            float temp = values[i*4 + j];
+            values[i*4 + j] = values[j*4 + i];
+            values[j*4 + i] = temp;
+        }
+    }
+#endif
 }
 
 // Transform a quaternion given a transformation matrix
-static void FMultiplyMatrixVector(Vector4 *v, Matrix mat)
+static void FMultiplyMatrixVector(Vector4 *v, const Matrix *mat)
 {
+#if defined(FNODE_SIMD_SSE2)
+    // Columns are combined by vector components in the same order as scalar rows dot products
+    const float *values = (const float *)mat;
+    __m128 column0 = _mm_loadu_ps(values);
+    __m128 column1 = _mm_loadu_ps(values + 4);
+    __m128 column2 = _mm_loadu_ps(values + 8);
+    __m128 column3 = _mm_loadu_ps(values + 12);
+
+    _MM_TRANSPOSE4_PS(column0, column1, column2, column3);
+
+    __m128 result = _mm_mul_ps(column0, _mm_set1_ps(v->x));
+    result = _mm_add_ps(result, _mm_mul_ps(column1, _mm_set1_ps(v->y)));
+    result = _mm_add_ps(result, _mm_mul_ps(column2, _mm_set1_ps(v->z)));
+    result = _mm_add_ps(result, _mm_mul_ps(column3, _mm_set1_ps(v->w)));
+    _mm_storeu_ps((float *)v, result);
+#else
     float x = v->x;
     float y = v->y;
     float z = v->z;
     float w = v->w;
 
-    v->x = mat.m0*x + mat.m4*y + mat.m8*z + mat.m12*w;
-    v->y = mat.m1*x + mat.m5*y + mat.m9*z + mat.m13*w;
-    v->z = mat.m2*x + mat.m6*y + mat.m10*z + mat.m14*w;
-    v->w = mat.m3*x + mat.m7*y + mat.m11*z + mat.m15*w;
+    v->x = mat->m0*x + mat->m4*y + mat->m8*z + mat->m12*w;
+    v->y = mat->m1*x + mat->m5*y + mat->m9*z + mat->m13*w;
+    v->z = mat->m2*x + mat->m6*y + mat->m10*z + mat->m14*w;
+    v->w = mat->m3*x + mat->m7*y + mat->m11*z + mat->m15*w;
+#endif
 }
 
 // Returns the cosine value of a radian angle
@@ -2583,6 +4494,103 @@ static float FSquareRoot(float value)
     return (float)sqrt(value);
 }
 
+// Returns a radian angle reduced to [-PI/4, PI/4] and its PI/2 quadrant
+// NOTE: PI/2 is split in three parts with few significant bits, so quadrants multiples are exact until FAST_MAX_ANGLE
+static float FReduceAngle(float value, int *quadrant)
+{
+    float k = floorf(value*0.636619772f + 0.5f);
+
+    *quadrant = (int)k;
+
+    return (((value - k*1.5703125f) - k*4.837512969970703125e-4f) - k*7.54978995489188216e-8f);
+}
+
+// Returns the sine (quadrant 0) or cosine (quadrant 1) of a radian angle (fast accuracy)
+static float FFastSinCos(float value, int quadrant)
+{
+    if (!(fabsf(value) <= FAST_MAX_ANGLE)) return ((quadrant == 0) ? FSin(value) : FCos(value));
+
+    int k = 0;
+    float r = FReduceAngle(value, &k);
+    float z = r*r;
+
+    // Minimax polynomials of sine and cosine in [-PI/4, PI/4] range
+    float sine = ((-1.9515295891e-4f*z + 8.3321608736e-3f)*z - 1.6666654611e-1f)*z*r + r;
+    float cosine = ((2.443315711809948e-5f*z - 1.388731625493765e-3f)*z + 4.166664568298827e-2f)*z*z - 0.5f*z + 1.0f;
+
+    k = (k + quadrant) & 3;
+    float result = ((k & 1) ? cosine : sine);
+
+    return ((k & 2) ? -result : result);
+}
+
+// Returns the tangent value of a radian angle (fast accuracy)
+static float FFastTan(float value)
+{
+    if (!(fabsf(value) <= FAST_MAX_ANGLE)) return FTan(value);
+
+    int k = 0;
+    float r = FReduceAngle(value, &k);
+    float z = r*r;
+    float result = (((((9.38540185543e-3f*z + 3.11992232697e-3f)*z + 2.44301354525e-2f)*z + 5.34112807005e-2f)*z + 1.33387994085e-1f)*z + 3.33331568548e-1f)*z*r + r;
+
+    return ((k & 1) ? -1.0f/result : result);
+}
+
+// Returns two to the power of a value (fast accuracy)
+static float FFastExp2(float value)
+{
+    if (!((value >= -126.0f) && (value <= 127.0f))) return FPower(2.0f, value);
+
+    // Integer part scales the polynomial of the fractional part in [-0.5, 0.5] range
+    float i = floorf(value + 0.5f);
+    float f = value - i;
+    float result = (((((1.540353039e-4f*f + 1.333355815e-3f)*f + 9.618129108e-3f)*f + 5.550410866e-2f)*f + 2.402265070e-1f)*f + 6.931471806e-1f)*f + 1.0f;
+    int bits = ((int)i + 127) << 23;
+    float scale = 0.0f;
+
+    memcpy(&scale, &bits, sizeof(float));
+
+    return result*scale;
+}
+
+// Returns the base two logarithm of a positive normal value (fast accuracy)
+static float FFastLog2(float value)
+{
+    int bits = 0;
+    memcpy(&bits, &value, sizeof(float));
+
+    // Exponent bits are the integer part, mantissa in [sqrt(0.5), sqrt(2)] range is the polynomial one
+    int exponent = ((bits >> 23) & 0xff) - 127;
+    float mantissa = 0.0f;
+
+    bits = (bits & 0x007fffff) | 0x3f800000;
+    memcpy(&mantissa, &bits, sizeof(float));
+
+    if (mantissa > 1.41421356f)
+    {
+        mantissa *= 0.5f;
+        exponent++;
+    }
+
+    float x = mantissa - 1.0f;
+    float z = x*x;
+    float result = ((((((((7.0376836292e-2f*x - 1.1514610310e-1f)*x + 1.1676998740e-1f)*x - 1.2420140846e-1f)*x + 1.4249322787e-1f)*x - 1.6668057665e-1f)*x + 2.0000714765e-1f)*x - 2.4999993993e-1f)*x + 3.3333331174e-1f)*x*z;
+
+    result = x + (result - 0.5f*z);
+
+    return result*1.44269504f + (float)exponent;
+}
+
+// Returns a value to the power of an exponent (fast accuracy)
+static float FFastPower(float value, float exp)
+{
+    // Negative, zero, subnormal and not finite bases keep exact accuracy rules
+    if (!((value >= FLT_MIN) && (value <= FLT_MAX))) return FPower(value, exp);
+
+    return FFastExp2(exp*FFastLog2(value));
+}
+
 // Returns a value rounded based on the samples
 static float FPosterize(float value, float samples)
 {
@@ -2676,6 +4684,430 @@ static float FSmoothStep(float min, float max, float value)
     return output;
 }
 
+// Adds b values to a values (float4 lanes kernel)
+static void FLanesAdd(float *a, const float *b, int count)
+{
+#if defined(FNODE_SIMD_SSE2)
+    for (int j = 0; j < count; j += 4) FLanesStore(a + j, _mm_add_ps(_mm_loadu_ps(a + j), _mm_loadu_ps(b + j)), count - j);
+#else
+    for (int j = 0; j < count; j++) a[j] += b[j];
+#endif
+}
+
+// Subtracts b values from a values (float4 lanes kernel)
+static void FLanesSubtract(float *a, const float *b, int count)
+{
+#if defined(FNODE_SIMD_SSE2)
+    for (int j = 0; j < count; j += 4) FLanesStore(a + j, _mm_sub_ps(_mm_loadu_ps(a + j), _mm_loadu_ps(b + j)), count - j);
+#else
+    for (int j = 0; j < count; j++) a[j] -= b[j];
+#endif
+}
+
+// Multiplies a values by b values (float4 lanes kernel)
+static void FLanesMultiply(float *a, const float *b, int count)
+{
+#if defined(FNODE_SIMD_SSE2)
+    for (int j = 0; j < count; j += 4) FLanesStore(a + j, _mm_mul_ps(_mm_loadu_ps(a + j), _mm_loadu_ps(b + j)), count - j);
+#else
+    for (int j = 0; j < count; j++) a[j] *= b[j];
+#endif
+}
+
+// Divides a values by b values (float4 lanes kernel)
+static void FLanesDivide(float *a, const float *b, int count)
+{
+#if defined(FNODE_SIMD_SSE2)
+    for (int j = 0; j < count; j += 4) FLanesStore(a + j, _mm_div_ps(_mm_loadu_ps(a + j), _mm_loadu_ps(b + j)), count - j);
+#else
+    for (int j = 0; j < count; j++) a[j] /= b[j];
+#endif
+}
+
+// Multiplies a values by a value (float4 lanes kernel)
+static void FLanesScale(float *a, float value, int count)
+{
+#if defined(FNODE_SIMD_SSE2)
+    __m128 scale = _mm_set1_ps(value);
+    for (int j = 0; j < count; j += 4) FLanesStore(a + j, _mm_mul_ps(_mm_loadu_ps(a + j), scale), count - j);
+#else
+    for (int j = 0; j < count; j++) a[j] *= value;
+#endif
+}
+
+// Divides a values by a value (float4 lanes kernel)
+static void FLanesDivideValue(float *a, float value, int count)
+{
+#if defined(FNODE_SIMD_SSE2)
+    __m128 divisor = _mm_set1_ps(value);
+    for (int j = 0; j < count; j += 4) FLanesStore(a + j, _mm_div_ps(_mm_loadu_ps(a + j), divisor), count - j);
+#else
+    for (int j = 0; j < count; j++) a[j] /= value;
+#endif
+}
+
+// Subtracts a values from one (float4 lanes kernel)
+static void FLanesOneMinus(float *a, int count)
+{
+#if defined(FNODE_SIMD_SSE2)
+    __m128 one = _mm_set1_ps(1.0f);
+    for (int j = 0; j < count; j += 4) FLanesStore(a + j, _mm_sub_ps(one, _mm_loadu_ps(a + j)), count - j);
+#else
+    for (int j = 0; j < count; j++) a[j] = 1 - a[j];
+#endif
+}
+
+// Divides one by a values (float4 lanes kernel)
+static void FLanesReciprocal(float *a, int count)
+{
+#if defined(FNODE_SIMD_SSE2)
+    __m128 one = _mm_set1_ps(1.0f);
+    for (int j = 0; j < count; j += 4) FLanesStore(a + j, _mm_div_ps(one, _mm_loadu_ps(a + j)), count - j);
+#else
+    for (int j = 0; j < count; j++) a[j] = 1/a[j];
+#endif
+}
+
+// Negates negative a values (float4 lanes kernel)
+static void FLanesAbs(float *a, int count)
+{
+#if defined(FNODE_SIMD_SSE2)
+    // Lanes are negated by comparison (not clearing sign bit), so -0.0f values are kept like scalar version
+    __m128 zero = _mm_setzero_ps();
+    __m128 minusOne = _mm_set1_ps(-1.0f);
+
+    for (int j = 0; j < count; j += 4)
+    {
+        __m128 values = _mm_loadu_ps(a + j);
+        FLanesStore(a + j, FLanesSelect(_mm_cmplt_ps(values, zero), _mm_mul_ps(values, minusOne), values), count - j);
+    }
+#else
+    for (int j = 0; j < count; j++)
+    {
+        if (a[j] < 0) a[j] *= -1;
+    }
+#endif
+}
+
+// Returns the square root of a values (float4 lanes kernel)
+static void FLanesSquareRoot(float *a, int count)
+{
+#if defined(FNODE_SIMD_SSE2)
+    for (int j = 0; j < count; j += 4) FLanesStore(a + j, _mm_sqrt_ps(_mm_loadu_ps(a + j)), count - j);
+#else
+    for (int j = 0; j < count; j++) a[j] = FSquareRoot(a[j]);
+#endif
+}
+
+// Clamps a values by a min and max values (float4 lanes kernel)
+static void FLanesClamp(float *a, float min, float max, int count)
+{
+#if defined(FNODE_SIMD_SSE2)
+    __m128 minimum = _mm_set1_ps(min);
+    __m128 maximum = _mm_set1_ps(max);
+
+    for (int j = 0; j < count; j += 4)
+    {
+        __m128 values = _mm_loadu_ps(a + j);
+        __m128 clamped = FLanesSelect(_mm_cmplt_ps(values, minimum), minimum, values);
+        FLanesStore(a + j, FLanesSelect(_mm_cmpgt_ps(values, maximum), maximum, clamped), count - j);
+    }
+#else
+    for (int j = 0; j < count; j++) a[j] = FClamp(a[j], min, max);
+#endif
+}
+
+// Replaces a values by greater b values (float4 lanes kernel)
+static void FLanesMax(float *a, const float *b, int count)
+{
+#if defined(FNODE_SIMD_SSE2)
+    for (int j = 0; j < count; j += 4)
+    {
+        __m128 valuesA = _mm_loadu_ps(a + j);
+        __m128 valuesB = _mm_loadu_ps(b + j);
+        FLanesStore(a + j, FLanesSelect(_mm_cmpgt_ps(valuesB, valuesA), valuesB, valuesA), count - j);
+    }
+#else
+    for (int j = 0; j < count; j++)
+    {
+        if (b[j] > a[j]) a[j] = b[j];
+    }
+#endif
+}
+
+// Replaces a values by lower b values (float4 lanes kernel)
+static void FLanesMin(float *a, const float *b, int count)
+{
+#if defined(FNODE_SIMD_SSE2)
+    for (int j = 0; j < count; j += 4)
+    {
+        __m128 valuesA = _mm_loadu_ps(a + j);
+        __m128 valuesB = _mm_loadu_ps(b + j);
+        FLanesStore(a + j, FLanesSelect(_mm_cmplt_ps(valuesB, valuesA), valuesB, valuesA), count - j);
+    }
+#else
+    for (int j = 0; j < count; j++)
+    {
+        if (b[j] < a[j]) a[j] = b[j];
+    }
+#endif
+}
+
+// Returns the interpolation between a and b values (float4 lanes kernel)
+static void FLanesLerp(float *output, const float *a, const float *b, float time, int count)
+{
+#if defined(FNODE_SIMD_SSE2)
+    __m128 lerpTime = _mm_set1_ps(time);
+
+    for (int j = 0; j < count; j += 4)
+    {
+        __m128 valuesA = _mm_loadu_ps(a + j);
+        FLanesStore(output + j, _mm_add_ps(valuesA, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(b + j), valuesA), lerpTime)), count - j);
+    }
+#else
+    for (int j = 0; j < count; j++) output[j] = FLerp(a[j], b[j], time);
+#endif
+}
+
+// Returns the interpolate of values in ranges (float4 lanes kernel)
+static void FLanesSmoothStep(float *output, const float *min, const float *max, const float *value, int count)
+{
+#if defined(FNODE_SIMD_SSE2)
+    __m128 zero = _mm_setzero_ps();
+    __m128 one = _mm_set1_ps(1.0f);
+
+    for (int j = 0; j < count; j += 4)
+    {
+        __m128 minimum = _mm_loadu_ps(min + j);
+        __m128 maximum = _mm_loadu_ps(max + j);
+        __m128 ordered = _mm_cmple_ps(minimum, maximum);
+        __m128 range = FLanesSelect(ordered, _mm_sub_ps(maximum, minimum), _mm_sub_ps(minimum, maximum));
+        __m128 values = _mm_sub_ps(_mm_div_ps(_mm_loadu_ps(value + j), range), FLanesSelect(ordered, minimum, maximum));
+
+        values = FLanesSelect(_mm_cmpgt_ps(values, one), one, FLanesSelect(_mm_cmplt_ps(values, zero), zero, values));
+        FLanesStore(output + j, values, count - j);
+    }
+#else
+    for (int j = 0; j < count; j++) output[j] = FSmoothStep(min[j], max[j], value[j]);
+#endif
+}
+
+// Transforms components lanes vectors by a matrix (float4 lanes kernel)
+// NOTE: lanes hold every vector component contiguously, separated by stride floats
+static void FLanesTransform(float *lanes, int stride, const Matrix *mat, int count)
+{
+#if defined(FNODE_SIMD_SSE2)
+    const float *values = (const float *)mat;
+    __m128 rows[16] = { 0 };
+    for (int i = 0; i < 16; i++) rows[i] = _mm_set1_ps(values[i]);
+
+    for (int j = 0; j < count; j += 4)
+    {
+        __m128 x = _mm_loadu_ps(lanes + j);
+        __m128 y = _mm_loadu_ps(lanes + stride + j);
+        __m128 z = _mm_loadu_ps(lanes + stride*2 + j);
+        __m128 w = _mm_loadu_ps(lanes + stride*3 + j);
+
+        for (int i = 0; i < 4; i++)
+        {
+            __m128 result = _mm_mul_ps(rows[i*4], x);
+            result = _mm_add_ps(result, _mm_mul_ps(rows[i*4 + 1], y));
+            result = _mm_add_ps(result, _mm_mul_ps(rows[i*4 + 2], z));
+            result = _mm_add_ps(result, _mm_mul_ps(rows[i*4 + 3], w));
+            FLanesStore(lanes + stride*i + j, result, count - j);
+        }
+    }
+#else
+    for (int j = 0; j < count; j++)
+    {
+        Vector4 vector = { lanes[j], lanes[stride + j], lanes[stride*2 + j], lanes[stride*3 + j] };
+        FMultiplyMatrixVector(&vector, mat);
+
+        lanes[j] = vector.x;
+        lanes[stride + j] = vector.y;
+        lanes[stride*2 + j] = vector.z;
+        lanes[stride*3 + j] = vector.w;
+    }
+#endif
+}
+
+// Returns the sine (quadrant 0) or cosine (quadrant 1) of a values (float4 lanes kernel, fast accuracy)
+static void FLanesSinCos(float *a, int quadrant, int count)
+{
+#if defined(FNODE_SIMD_SSE2)
+    __m128 maxAngle = _mm_set1_ps(FAST_MAX_ANGLE);
+    __m128 signMask = _mm_set1_ps(-0.0f);
+
+    for (int j = 0; j < count; j += 4)
+    {
+        __m128 values = _mm_loadu_ps(a + j);
+        __m128i k = _mm_setzero_si128();
+        __m128 r = FLanesReduceAngle(values, &k);
+        __m128 z = _mm_mul_ps(r, r);
+
+        __m128 sine = _mm_sub_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(-1.9515295891e-4f), z), _mm_set1_ps(8.3321608736e-3f)), z), _mm_set1_ps(1.6666654611e-1f));
+        sine = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(sine, z), r), r);
+
+        __m128 cosine = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(_mm_mul_ps(_mm_set1_ps(2.443315711809948e-5f), z), _mm_set1_ps(1.388731625493765e-3f)), z), _mm_set1_ps(4.166664568298827e-2f));
+        cosine = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(_mm_mul_ps(cosine, z), z), _mm_mul_ps(_mm_set1_ps(0.5f), z)), _mm_set1_ps(1.0f));
+
+        // Odd quadrants use the other polynomial, last two quadrants flip its sign bit
+        k = _mm_add_epi32(k, _mm_set1_epi32(quadrant));
+        __m128 odd = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(k, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+        __m128 sign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(k, _mm_set1_epi32(2)), 30));
+        __m128 result = _mm_xor_ps(FLanesSelect(odd, cosine, sine), sign);
+
+        FLanesStore(a + j, result, count - j);
+
+        // Angles out of reduction range keep exact accuracy
+        int reduced = _mm_movemask_ps(_mm_cmple_ps(_mm_andnot_ps(signMask, values), maxAngle));
+
+        if (reduced != 0xf)
+        {
+            float original[4] = { 0 };
+            _mm_storeu_ps(original, values);
+
+            for (int l = 0; (l < 4) && (l < count - j); l++)
+            {
+                if (!(reduced & (1 << l))) a[j + l] = ((quadrant == 0) ? FSin(original[l]) : FCos(original[l]));
+            }
+        }
+    }
+#else
+    for (int j = 0; j < count; j++) a[j] = FFastSinCos(a[j], quadrant);
+#endif
+}
+
+// Returns the tangent of a values (float4 lanes kernel, fast accuracy)
+static void FLanesTan(float *a, int count)
+{
+#if defined(FNODE_SIMD_SSE2)
+    __m128 maxAngle = _mm_set1_ps(FAST_MAX_ANGLE);
+    __m128 signMask = _mm_set1_ps(-0.0f);
+
+    for (int j = 0; j < count; j += 4)
+    {
+        __m128 values = _mm_loadu_ps(a + j);
+        __m128i k = _mm_setzero_si128();
+        __m128 r = FLanesReduceAngle(values, &k);
+        __m128 z = _mm_mul_ps(r, r);
+
+        __m128 result = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(9.38540185543e-3f), z), _mm_set1_ps(3.11992232697e-3f));
+        result = _mm_add_ps(_mm_mul_ps(result, z), _mm_set1_ps(2.44301354525e-2f));
+        result = _mm_add_ps(_mm_mul_ps(result, z), _mm_set1_ps(5.34112807005e-2f));
+        result = _mm_add_ps(_mm_mul_ps(result, z), _mm_set1_ps(1.33387994085e-1f));
+        result = _mm_add_ps(_mm_mul_ps(result, z), _mm_set1_ps(3.33331568548e-1f));
+        result = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(result, z), r), r);
+
+        __m128 odd = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(k, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+        result = FLanesSelect(odd, _mm_div_ps(_mm_set1_ps(-1.0f), result), result);
+
+        FLanesStore(a + j, result, count - j);
+
+        int reduced = _mm_movemask_ps(_mm_cmple_ps(_mm_andnot_ps(signMask, values), maxAngle));
+
+        if (reduced != 0xf)
+        {
+            float original[4] = { 0 };
+            _mm_storeu_ps(original, values);
+
+            for (int l = 0; (l < 4) && (l < count - j); l++)
+            {
+                if (!(reduced & (1 << l))) a[j + l] = FTan(original[l]);
+            }
+        }
+    }
+#else
+    for (int j = 0; j < count; j++) a[j] = FFastTan(a[j]);
+#endif
+}
+
+// Returns two to the power of a values (float4 lanes kernel, fast accuracy)
+static void FLanesExp2(float *a, int count)
+{
+#if defined(FNODE_SIMD_SSE2)
+    __m128 minimum = _mm_set1_ps(-126.0f);
+    __m128 maximum = _mm_set1_ps(127.0f);
+
+    for (int j = 0; j < count; j += 4)
+    {
+        __m128 values = _mm_loadu_ps(a + j);
+        __m128 inside = _mm_and_ps(_mm_cmpge_ps(values, minimum), _mm_cmple_ps(values, maximum));
+
+        // Lanes out of range are clamped to keep scale bits valid, their values are calculated again below
+        __m128 i = FLanesFloor(_mm_add_ps(FLanesSelect(inside, values, _mm_setzero_ps()), _mm_set1_ps(0.5f)));
+        __m128 f = _mm_sub_ps(FLanesSelect(inside, values, _mm_setzero_ps()), i);
+
+        __m128 result = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(1.540353039e-4f), f), _mm_set1_ps(1.333355815e-3f));
+        result = _mm_add_ps(_mm_mul_ps(result, f), _mm_set1_ps(9.618129108e-3f));
+        result = _mm_add_ps(_mm_mul_ps(result, f), _mm_set1_ps(5.550410866e-2f));
+        result = _mm_add_ps(_mm_mul_ps(result, f), _mm_set1_ps(2.402265070e-1f));
+        result = _mm_add_ps(_mm_mul_ps(result, f), _mm_set1_ps(6.931471806e-1f));
+        result = _mm_add_ps(_mm_mul_ps(result, f), _mm_set1_ps(1.0f));
+
+        __m128 scale = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(_mm_cvttps_epi32(i), _mm_set1_epi32(127)), 23));
+        FLanesStore(a + j, _mm_mul_ps(result, scale), count - j);
+
+        int reduced = _mm_movemask_ps(inside);
+
+        if (reduced != 0xf)
+        {
+            float original[4] = { 0 };
+            _mm_storeu_ps(original, values);
+
+            for (int l = 0; (l < 4) && (l < count - j); l++)
+            {
+                if (!(reduced & (1 << l))) a[j + l] = FPower(2.0f, original[l]);
+            }
+        }
+    }
+#else
+    for (int j = 0; j < count; j++) a[j] = FFastExp2(a[j]);
+#endif
+}
+
+#if defined(FNODE_SIMD_SSE2)
+// Stores the first count values of a float4 register keeping the rest lanes unchanged
+static void FLanesStore(float *lanes, __m128 values, int count)
+{
+    if (count >= 4) _mm_storeu_ps(lanes, values);
+    else
+    {
+        // Lanes over values count still belong to the output data, so they keep their previous values
+        __m128 mask = _mm_castsi128_ps(_mm_cmplt_epi32(_mm_set_epi32(3, 2, 1, 0), _mm_set1_epi32(count)));
+        _mm_storeu_ps(lanes, FLanesSelect(mask, values, _mm_loadu_ps(lanes)));
+    }
+}
+
+// Returns a lanes where mask is set and b lanes elsewhere
+static __m128 FLanesSelect(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+// Returns the largest integers not greater than values (absolute values lower than 2^31)
+static __m128 FLanesFloor(__m128 values)
+{
+    // Truncated values greater than negative values are one unit over their floor
+    __m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(values));
+
+    return _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, values), _mm_set1_ps(1.0f)));
+}
+
+// Returns radian angles reduced to [-PI/4, PI/4] and their PI/2 quadrants
+static __m128 FLanesReduceAngle(__m128 values, __m128i *quadrant)
+{
+    __m128 k = FLanesFloor(_mm_add_ps(_mm_mul_ps(values, _mm_set1_ps(0.636619772f)), _mm_set1_ps(0.5f)));
+
+    *quadrant = _mm_cvttps_epi32(k);
+
+    __m128 r = _mm_sub_ps(values, _mm_mul_ps(k, _mm_set1_ps(1.5703125f)));
+    r = _mm_sub_ps(r, _mm_mul_ps(k, _mm_set1_ps(4.837512969970703125e-4f)));
+
+    return _mm_sub_ps(r, _mm_mul_ps(k, _mm_set1_ps(7.54978995489188216e-8f)));
+}
+#endif
+
 // Returns an ease linear value between two parameters
 static float FEaseLinear(float t, float b, float c, float d)
 { 
@@ -2705,9 +5137,37 @@ static void FStringToFloat(float *pointer, const char *string)
 }
 
 // Sends formatted output to an initialized string pointer
+// NOTE: output is the same as sprintf() with "%.3f" format, which is used just for big and not finite values
 static void FFloatToString(char *buffer, float value)
 {
-    sprintf(buffer, "%.3f", value);
+    if (!(fabsf(value) < 1e9f))
+    {
+        sprintf(buffer, "%.3f", value);
+        return;
+    }
+
+    // Float values scaled by 1000 are exact as doubles, so rounding them matches sprintf() rounding (halfway cases to even)
+    long long thousandths = (long long)rint(fabs((double)value*1000.0));
+    long long integer = thousandths/1000;
+    int fraction = (int)(thousandths%1000);
+    char digits[20] = { 0 };
+    int count = 0;
+    int length = 0;
+
+    do
+    {
+        digits[count++] = (char)('0' + integer%10);
+        integer /= 10;
+    } while (integer > 0);
+
+    if (signbit(value)) buffer[length++] = '-';
+    while (count > 0) buffer[length++] = digits[--count];
+
+    buffer[length++] = '.';
+    buffer[length++] = (char)('0' + fraction/100);
+    buffer[length++] = (char)('0' + (fraction/10)%10);
+    buffer[length++] = (char)('0' + fraction%10);
+    buffer[length] = '\0';
 }
 
 #endif  // FNODE_IMPLEMENTATION
@@ -75,6 +75,8 @@
 #define     VERTEX_PATH                 "output/shader.vs"                          // Vertex shader output path
 #define     FRAGMENT_PATH               "output/shader.fs"                          // Fragment shader output path
 #define     DATA_PATH                   "output/shader.fnode"                       // Shader data output path
+#define     PREVIEW_PATH                "output/preview.png"                        // Fragment shader CPU rendered preview output path
+#define     PREVIEW_SIZE                256                                         // Fragment shader CPU rendered preview width and height
 #define     EXAMPLE_VERTEX_PATH         "res/example/output/shader.vs"              // Vertex shader output path of start example
 #define     EXAMPLE_FRAGMENT_PATH       "res/example/output/shader.fs"              // Fragment shader output path of start example
 #define     EXAMPLE_DATA_PATH           "res/example/output/shader.fnode"           // Shader data output path of start example
@@ -139,6 +141,7 @@ typedef enum {
 //----------------------------------------------------------------------------------
 // Global Variables
 //----------------------------------------------------------------------------------
+FNodeContext *context = NULL;               // Edited nodes graph context
 Vector2 mousePosition = { 0, 0 };           // Current mouse position
 Vector2 lastMousePosition = { 0, 0 };       // Previous frame mouse position
 Vector2 mouseDelta = { 0, 0 };              // Current frame mouse position increment since previous frame
@@ -167,10 +170,10 @@ int timeUniformF = -1;                      // Created shader current time unifo
 bool loadedShader = false;                  // Current loaded custom shader state
 float currentTime = 0;                      // Current global time to send to shader as attribute
 Texture2D textures[MAX_TEXTURES] = { 0 };   // Shader texture unit textures
+Image images[MAX_TEXTURES] = { 0 };         // Shader texture unit source images kept in RAM for CPU rendered preview
 Rectangle texRects[MAX_TEXTURES] = { 0 };   // Interfaces panels to display current loaded textures and unload them
 bool loadedtexRects = false;                // State of texRects initialization
 int loadedFiles = 0;                        // Loaded textures count
-bool usedUnits[MAX_TEXTURES] = { false };   // Shader compiling used texture units
 bool drawVisor = true;                      // Visor display enabled state
 bool fullVisor = false;                     // Visor full screen state
 bool help = false;                          // Display help message state
@@ -191,20 +194,25 @@ RenderTexture2D gridTarget;                 // Grid display render target
 //----------------------------------------------------------------------------------
 void CheckPreviousShader(bool makeGraph);                       // Check if there are a compatible shader in output folder
 void LoadDefaultProject(void);                                  // Loads example project nodes and shader
+bool LoadGraphData(const char *path);                           // Loads project nodes and lines from a data file (returns false if file cannot be opened)
+void LoadTextureUnit(int unit, const char *path);               // Loads a texture in a shader texture unit keeping its source image
+void UnloadTextureUnit(int unit);                               // Unloads a shader texture unit texture and its source image
 void UpdateMouseData(void);                                     // Updates current mouse position and delta position
 void UpdateInputsData(void);                                    // Updates current inputs states
 void UpdateScroll(void);                                        // Updates mouse scrolling for menu and canvas drag
 void UpdateNodesEdit(void);                                     // Check node data values edit input
 void UpdateNodesDrag(void);                                     // Check node drag input
 void UpdateNodesLink(void);                                     // Check node link input
+void UpdateNodesVisibility(void);                               // Pins nodes inside canvas view so their values are calculated even if unused
 void UpdateCommentCreationEdit(void);                           // Check comment creation and shape edit input
 void UpdateCommentsDrag(void);                                  // Check comment drag input
 void UpdateCommentsEdit(void);                                  // Check comment text edit input
 void UpdateShaderData(void);                                    // Update required values to created shader for geometry data calculations
 void SaveChanges(void);                                         // Serialize current project data and write to file
-void CompileShader(void);                                       // Compiles all node structure to create the GLSL fragment shader in output folder
-void CheckConstant(FNode node, FILE *file);                     // Check nodes searching for constant values to define them in shaders
-void CompileNode(FNode node, FILE *file, bool fragment);        // Compiles a specific node checking its inputs and writing current node operation in shader
+void ExportPreview(void);                                       // Renders fragment output node on CPU and writes it as an image in output folder
+void CompileShader(FNodeContext *ctx, ShaderVersion version);   // Compiles all node structure to create the GLSL fragment shader in output folder
+void CheckConstant(FNodeContext *ctx, FNode node, FILE *file, bool *usedUnits);  // Check nodes searching for constant values to define them in shaders
+void CompileNode(FNodeContext *ctx, FNode node, FILE *file, bool fragment, ShaderVersion version);  // Compiles a specific node checking its inputs and writing current node operation in shader
 void AlignAllNodes(void);                                       // Aligns all created nodes
 void ClearUnusedNodes(void);                                    // Destroys all unused nodes
 void ClearGraph(void);                                          // Destroys all created nodes and its linked lines
@@ -252,126 +260,7 @@ void CheckPreviousShader(bool makeGraph)
 
         if (makeGraph)
         {
-            FILE *dataFile = fopen(DATA_PATH, "r");
-            if (dataFile != NULL)
-            {
-                float type = -1;
-                float inputs[MAX_INPUTS] = { -1, -1, -1, -1 };
-                float inputsCount = -1;
-                float inputsLimit = -1;
-                float dataCount = -1;
-                float property = -1;
-                float data[MAX_VALUES] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
-                float shapeX = -1;
-                float shapeY = -1;
-
-                while (fscanf(dataFile, "%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,\n", &type, &property,
-                &inputs[0], &inputs[1], &inputs[2], &inputs[3], &inputsCount, &inputsLimit, &dataCount, &data[0], &data[1], &data[2],
-                &data[3], &data[4], &data[5], &data[6], &data[7], &data[8], &data[9], &data[10], &data[11], &data[12], &data[13], &data[14],
-                &data[15], &shapeX, &shapeY) > 0)
-                {                
-                    FNode newNode = InitializeNode(true);
-                    newNode->type = type;
-                    newNode->property = property;
-
-                    if (type < FNODE_ADD) newNode->inputShape = (Rectangle){ 0, 0, 0, 0 };
-
-                    switch ((int)type)
-                    {
-                        case FNODE_PI: newNode->name = "Pi"; break;
-                        case FNODE_E: newNode->name = "e"; break;
-                        case FNODE_TIME: newNode->name = "Current Time"; break;
-                        case FNODE_VERTEXPOSITION: newNode->name = "Vertex Position"; break;
-                        case FNODE_VERTEXNORMAL: newNode->name = "Normal Direction"; break;
-                        case FNODE_FRESNEL: newNode->name = "Fresnel"; break;
-                        case FNODE_VIEWDIRECTION: newNode->name = "View Direction"; break;
-                        case FNODE_MVP: newNode->name = "MVP Matrix"; break;
-                        case FNODE_MATRIX: newNode->name = "Matrix 4x4"; break;
-                        case FNODE_VALUE: newNode->name = "Value"; break;
-                        case FNODE_VECTOR2: newNode->name = "Vector 2"; break;
-                        case FNODE_VECTOR3: newNode->name = "Vector 3"; break;
-                        case FNODE_VECTOR4: newNode->name = "Vector 4"; break;
-                        case FNODE_ADD: newNode->name = "Add"; break;
-                        case FNODE_SUBTRACT: newNode->name = "Subtract"; break;
-                        case FNODE_MULTIPLY: newNode->name = "Multiply"; break;
-                        case FNODE_DIVIDE: newNode->name = "Divide"; break;
-                        case FNODE_APPEND: newNode->name = "Append"; break;
-                        case FNODE_ONEMINUS: newNode->name = "One Minus"; break;
-                        case FNODE_ABS: newNode->name = "Abs"; break;
-                        case FNODE_COS:newNode->name = "Cos"; break;
-                        case FNODE_SIN: newNode->name = "Sin"; break;
-                        case FNODE_TAN: newNode->name = "Tan"; break;
-                        case FNODE_DEG2RAD: newNode->name = "Deg to Rad"; break;
-                        case FNODE_RAD2DEG: newNode->name = "Rad to Deg"; break;
-                        case FNODE_NORMALIZE: newNode->name = "Normalize"; break;
-                        case FNODE_NEGATE: newNode->name = "Negate"; break;
-                        case FNODE_RECIPROCAL: newNode->name = "Reciprocal"; break;
-                        case FNODE_SQRT: newNode->name = "Square Root"; break;
-                        case FNODE_TRUNC: newNode->name = "Trunc"; break;
-                        case FNODE_ROUND: newNode->name = "Round"; break;
-                        case FNODE_VERTEXCOLOR: newNode->name = "Vertex Color"; break;
-                        case FNODE_CEIL: newNode->name = "Ceil"; break;
-                        case FNODE_CLAMP01: newNode->name = "Clamp 0-1"; break;
-                        case FNODE_EXP2: newNode->name = "Exp 2"; break;
-                        case FNODE_POWER: newNode->name = "Power"; break;
-                        case FNODE_STEP: newNode->name = "Step"; break;
-                        case FNODE_POSTERIZE: newNode->name = "Posterize"; break;
-                        case FNODE_MAX: newNode->name = "Max"; break;
-                        case FNODE_MIN: newNode->name = "Min"; break;
-                        case FNODE_LERP: newNode->name = "Lerp"; break;
-                        case FNODE_SMOOTHSTEP: newNode->name = "Smooth Step"; break;
-                        case FNODE_CROSSPRODUCT: newNode->name = "Cross Product"; break;
-                        case FNODE_DESATURATE: newNode->name = "Desaturate"; break;
-                        case FNODE_DISTANCE: newNode->name = "Distance"; break;
-                        case FNODE_DOTPRODUCT: newNode->name = "Dot Product"; break;
-                        case FNODE_LENGTH: newNode->name = "Length"; break;
-                        case FNODE_MULTIPLYMATRIX: newNode->name = "Multiply Matrix"; break;
-                        case FNODE_TRANSPOSE: newNode->name = "Transpose"; break;
-                        case FNODE_PROJECTION: newNode->name = "Projection Vector"; break;
-                        case FNODE_REJECTION: newNode->name = "Rejection Vector"; break;
-                        case FNODE_HALFDIRECTION: newNode->name = "Half Direction"; break;
-                        case FNODE_SAMPLER2D: newNode->name = "Sampler 2D"; break;
-                        case FNODE_VERTEX: newNode->name = "[OUTPUT] Vertex Position"; break;
-                        case FNODE_FRAGMENT: newNode->name = "[OUTPUT] Fragment Color"; break;
-                        default: break;
-                    }
-
-                    for (int i = 0; i < MAX_INPUTS; i++) newNode->inputs[i] = inputs[i];
-
-                    newNode->inputsCount = inputsCount;
-                    newNode->inputsLimit = inputsLimit;
-
-                    for (int i = 0; i < MAX_VALUES; i++)
-                    {
-                        newNode->output.data[i].value = data[i];
-                        FFloatToString(newNode->output.data[i].valueText, newNode->output.data[i].value);
-                    }
-
-                    newNode->output.dataCount = dataCount;
-                    newNode->shape.x = shapeX;
-                    newNode->shape.y = shapeY;
-
-                    UpdateNodeShapes(newNode);
-                }
-
-                int from = -1;
-                int to = -1;            
-
-                while (fscanf(dataFile, "?%i?%i\n", &from, &to) > 0)
-                {
-                    tempLine = CreateNodeLine(from);
-                    tempLine->to = to;
-                }
-
-                for (int i = 0; i < nodesCount; i++) UpdateNodeShapes(nodes[i]);
-
-                CalculateValues();
-
-                for (int i = 0; i < nodesCount; i++) UpdateNodeShapes(nodes[i]);
-
-                loadedShader = true;
-                fclose(dataFile);
-            }
+            if (LoadGraphData(DATA_PATH)) loadedShader = true;
             else TraceLogFNode(false, "error when trying to open previous shader data file");
         }
     }
@@ -386,8 +275,8 @@ void LoadDefaultProject(void)
     Shader previousShader = LoadShader(EXAMPLE_VERTEX_PATH, EXAMPLE_FRAGMENT_PATH);
     if (previousShader.id > 0)
     {
-        textures[0] = LoadTexture(MODEL_TEXTURE_WINDAMOUNT);
-        textures[1] = LoadTexture(MODEL_TEXTURE_DIFFUSE);
+        LoadTextureUnit(0, MODEL_TEXTURE_WINDAMOUNT);
+        LoadTextureUnit(1, MODEL_TEXTURE_DIFFUSE);
 
         for (int i = 0; i < DEFAULT_PROJECT_TEXTURES; i++)
         {
@@ -406,135 +295,165 @@ void LoadDefaultProject(void)
         timeUniformV = GetShaderLocation(shader, "vertCurrentTime");
         timeUniformF = GetShaderLocation(shader, "fragCurrentTime");
 
-        FILE *dataFile = fopen(EXAMPLE_DATA_PATH, "r");
-        if (dataFile != NULL)
+        if (LoadGraphData(EXAMPLE_DATA_PATH)) loadedShader = true;
+    }
+
+    if (!loadedShader)
+    {
+        CreateNodeMaterial(context, FNODE_VERTEX, "[OUTPUT] Vertex Position", 0);
+        CreateNodeMaterial(context, FNODE_FRAGMENT, "[OUTPUT] Fragment Color", 0);
+    }
+}
+
+// Loads project nodes and lines from a data file (returns false if file cannot be opened)
+bool LoadGraphData(const char *path)
+{
+    FILE *dataFile = fopen(path, "r");
+    if (dataFile == NULL) return false;
+
+    BeginGraphEdit(context);
+
+    float type = -1;
+    float inputs[MAX_INPUTS] = { -1, -1, -1, -1 };
+    float inputsCount = -1;
+    float inputsLimit = -1;
+    float dataCount = -1;
+    float property = -1;
+    float data[MAX_VALUES] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+    float shapeX = -1;
+    float shapeY = -1;
+
+    while (fscanf(dataFile, "%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,\n", &type, &property,
+    &inputs[0], &inputs[1], &inputs[2], &inputs[3], &inputsCount, &inputsLimit, &dataCount, &data[0], &data[1], &data[2],
+    &data[3], &data[4], &data[5], &data[6], &data[7], &data[8], &data[9], &data[10], &data[11], &data[12], &data[13], &data[14],
+    &data[15], &shapeX, &shapeY) > 0)
+    {                
+        // Output nodes are created as materials so every node they can reach is calculated
+        FNode newNode = (((int)type >= FNODE_VERTEX) ? CreateNodeMaterial(context, type, NULL, 0) : InitializeNode(context, true));
+        newNode->type = type;
+        newNode->property = property;
+
+        if (type < FNODE_ADD) newNode->inputShape = (Rectangle){ 0, 0, 0, 0 };
+
+        switch ((int)type)
         {
-            float type = -1;
-            float inputs[MAX_INPUTS] = { -1, -1, -1, -1 };
-            float inputsCount = -1;
-            float inputsLimit = -1;
-            float dataCount = -1;
-            float property = -1;
-            float data[MAX_VALUES] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
-            float shapeX = -1;
-            float shapeY = -1;
-
-            while (fscanf(dataFile, "%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,\n", &type, &property,
-            &inputs[0], &inputs[1], &inputs[2], &inputs[3], &inputsCount, &inputsLimit, &dataCount, &data[0], &data[1], &data[2],
-            &data[3], &data[4], &data[5], &data[6], &data[7], &data[8], &data[9], &data[10], &data[11], &data[12], &data[13], &data[14],
-            &data[15], &shapeX, &shapeY) > 0)
-            {                
-                FNode newNode = InitializeNode(true);
-                newNode->type = type;
-                newNode->property = property;
-
-                if (type < FNODE_ADD) newNode->inputShape = (Rectangle){ 0, 0, 0, 0 };
-
-                switch ((int)type)
-                {
-                    case FNODE_PI: newNode->name = "Pi"; break;
-                    case FNODE_E: newNode->name = "e"; break;
-                    case FNODE_TIME: newNode->name = "Current Time"; break;
-                    case FNODE_VERTEXPOSITION: newNode->name = "Vertex Position"; break;
-                    case FNODE_VERTEXNORMAL: newNode->name = "Normal Direction"; break;
-                    case FNODE_FRESNEL: newNode->name = "Fresnel"; break;
-                    case FNODE_VIEWDIRECTION: newNode->name = "View Direction"; break;
-                    case FNODE_MVP: newNode->name = "MVP Matrix"; break;
-                    case FNODE_MATRIX: newNode->name = "Matrix 4x4"; break;
-                    case FNODE_VALUE: newNode->name = "Value"; break;
-                    case FNODE_VECTOR2: newNode->name = "Vector 2"; break;
-                    case FNODE_VECTOR3: newNode->name = "Vector 3"; break;
-                    case FNODE_VECTOR4: newNode->name = "Vector 4"; break;
-                    case FNODE_ADD: newNode->name = "Add"; break;
-                    case FNODE_SUBTRACT: newNode->name = "Subtract"; break;
-                    case FNODE_MULTIPLY: newNode->name = "Multiply"; break;
-                    case FNODE_DIVIDE: newNode->name = "Divide"; break;
-                    case FNODE_APPEND: newNode->name = "Append"; break;
-                    case FNODE_ONEMINUS: newNode->name = "One Minus"; break;
-                    case FNODE_ABS: newNode->name = "Abs"; break;
-                    case FNODE_COS:newNode->name = "Cos"; break;
-                    case FNODE_SIN: newNode->name = "Sin"; break;
-                    case FNODE_TAN: newNode->name = "Tan"; break;
-                    case FNODE_DEG2RAD: newNode->name = "Deg to Rad"; break;
-                    case FNODE_RAD2DEG: newNode->name = "Rad to Deg"; break;
-                    case FNODE_NORMALIZE: newNode->name = "Normalize"; break;
-                    case FNODE_NEGATE: newNode->name = "Negate"; break;
-                    case FNODE_RECIPROCAL: newNode->name = "Reciprocal"; break;
-                    case FNODE_SQRT: newNode->name = "Square Root"; break;
-                    case FNODE_TRUNC: newNode->name = "Trunc"; break;
-                    case FNODE_ROUND: newNode->name = "Round"; break;
-                    case FNODE_VERTEXCOLOR: newNode->name = "Vertex Color"; break;
-                    case FNODE_CEIL: newNode->name = "Ceil"; break;
-                    case FNODE_CLAMP01: newNode->name = "Clamp 0-1"; break;
-                    case FNODE_EXP2: newNode->name = "Exp 2"; break;
-                    case FNODE_POWER: newNode->name = "Power"; break;
-                    case FNODE_STEP: newNode->name = "Step"; break;
-                    case FNODE_POSTERIZE: newNode->name = "Posterize"; break;
-                    case FNODE_MAX: newNode->name = "Max"; break;
-                    case FNODE_MIN: newNode->name = "Min"; break;
-                    case FNODE_LERP: newNode->name = "Lerp"; break;
-                    case FNODE_SMOOTHSTEP: newNode->name = "Smooth Step"; break;
-                    case FNODE_CROSSPRODUCT: newNode->name = "Cross Product"; break;
-                    case FNODE_DESATURATE: newNode->name = "Desaturate"; break;
-                    case FNODE_DISTANCE: newNode->name = "Distance"; break;
-                    case FNODE_DOTPRODUCT: newNode->name = "Dot Product"; break;
-                    case FNODE_LENGTH: newNode->name = "Length"; break;
-                    case FNODE_MULTIPLYMATRIX: newNode->name = "Multiply Matrix"; break;
-                    case FNODE_TRANSPOSE: newNode->name = "Transpose"; break;
-                    case FNODE_PROJECTION: newNode->name = "Projection Vector"; break;
-                    case FNODE_REJECTION: newNode->name = "Rejection Vector"; break;
-                    case FNODE_HALFDIRECTION: newNode->name = "Half Direction"; break;
-                    case FNODE_SAMPLER2D: newNode->name = "Sampler 2D"; break;
-                    case FNODE_VERTEX: newNode->name = "[OUTPUT] Vertex Position"; break;
-                    case FNODE_FRAGMENT: newNode->name = "[OUTPUT] Fragment Color"; break;
-                    default: break;
-                }
+            case FNODE_PI: newNode->name = "Pi"; break;
+            case FNODE_E: newNode->name = "e"; break;
+            case FNODE_TIME: newNode->name = "Current Time"; break;
+            case FNODE_VERTEXPOSITION: newNode->name = "Vertex Position"; break;
+            case FNODE_VERTEXNORMAL: newNode->name = "Normal Direction"; break;
+            case FNODE_FRESNEL: newNode->name = "Fresnel"; break;
+            case FNODE_VIEWDIRECTION: newNode->name = "View Direction"; break;
+            case FNODE_MVP: newNode->name = "MVP Matrix"; break;
+            case FNODE_MATRIX: newNode->name = "Matrix 4x4"; break;
+            case FNODE_VALUE: newNode->name = "Value"; break;
+            case FNODE_VECTOR2: newNode->name = "Vector 2"; break;
+            case FNODE_VECTOR3: newNode->name = "Vector 3"; break;
+            case FNODE_VECTOR4: newNode->name = "Vector 4"; break;
+            case FNODE_ADD: newNode->name = "Add"; break;
+            case FNODE_SUBTRACT: newNode->name = "Subtract"; break;
+            case FNODE_MULTIPLY: newNode->name = "Multiply"; break;
+            case FNODE_DIVIDE: newNode->name = "Divide"; break;
+            case FNODE_APPEND: newNode->name = "Append"; break;
+            case FNODE_ONEMINUS: newNode->name = "One Minus"; break;
+            case FNODE_ABS: newNode->name = "Abs"; break;
+            case FNODE_COS:newNode->name = "Cos"; break;
+            case FNODE_SIN: newNode->name = "Sin"; break;
+            case FNODE_TAN: newNode->name = "Tan"; break;
+            case FNODE_DEG2RAD: newNode->name = "Deg to Rad"; break;
+            case FNODE_RAD2DEG: newNode->name = "Rad to Deg"; break;
+            case FNODE_NORMALIZE: newNode->name = "Normalize"; break;
+            case FNODE_NEGATE: newNode->name = "Negate"; break;
+            case FNODE_RECIPROCAL: newNode->name = "Reciprocal"; break;
+            case FNODE_SQRT: newNode->name = "Square Root"; break;
+            case FNODE_TRUNC: newNode->name = "Trunc"; break;
+            case FNODE_ROUND: newNode->name = "Round"; break;
+            case FNODE_VERTEXCOLOR: newNode->name = "Vertex Color"; break;
+            case FNODE_CEIL: newNode->name = "Ceil"; break;
+            case FNODE_CLAMP01: newNode->name = "Clamp 0-1"; break;
+            case FNODE_EXP2: newNode->name = "Exp 2"; break;
+            case FNODE_POWER: newNode->name = "Power"; break;
+            case FNODE_STEP: newNode->name = "Step"; break;
+            case FNODE_POSTERIZE: newNode->name = "Posterize"; break;
+            case FNODE_MAX: newNode->name = "Max"; break;
+            case FNODE_MIN: newNode->name = "Min"; break;
+            case FNODE_LERP: newNode->name = "Lerp"; break;
+            case FNODE_SMOOTHSTEP: newNode->name = "Smooth Step"; break;
+            case FNODE_CROSSPRODUCT: newNode->name = "Cross Product"; break;
+            case FNODE_DESATURATE: newNode->name = "Desaturate"; break;
+            case FNODE_DISTANCE: newNode->name = "Distance"; break;
+            case FNODE_DOTPRODUCT: newNode->name = "Dot Product"; break;
+            case FNODE_LENGTH: newNode->name = "Length"; break;
+            case FNODE_MULTIPLYMATRIX: newNode->name = "Multiply Matrix"; break;
+            case FNODE_TRANSPOSE: newNode->name = "Transpose"; break;
+            case FNODE_PROJECTION: newNode->name = "Projection Vector"; break;
+            case FNODE_REJECTION: newNode->name = "Rejection Vector"; break;
+            case FNODE_HALFDIRECTION: newNode->name = "Half Direction"; break;
+            case FNODE_SAMPLER2D: newNode->name = "Sampler 2D"; break;
+            case FNODE_VERTEX: newNode->name = "[OUTPUT] Vertex Position"; break;
+            case FNODE_FRAGMENT: newNode->name = "[OUTPUT] Fragment Color"; break;
+            default: break;
+        }
 
-                for (int i = 0; i < MAX_INPUTS; i++) newNode->inputs[i] = inputs[i];
+        // Node inputs are linked from lines data
+        newNode->inputsLimit = inputsLimit;
 
-                newNode->inputsCount = inputsCount;
-                newNode->inputsLimit = inputsLimit;
+        for (int i = 0; i < MAX_VALUES; i++)
+        {
+            newNode->output.data[i] = data[i];
+            FFloatToString(newNode->values[i].valueText, newNode->output.data[i]);
+        }
 
-                for (int i = 0; i < MAX_VALUES; i++)
-                {
-                    newNode->output.data[i].value = data[i];
-                    FFloatToString(newNode->output.data[i].valueText, newNode->output.data[i].value);
-                }
+        newNode->output.dataCount = dataCount;
+        MarkNodeDirty(context, newNode);
+        newNode->shape.x = shapeX;
+        newNode->shape.y = shapeY;
 
-                newNode->output.dataCount = dataCount;
-                newNode->shape.x = shapeX;
-                newNode->shape.y = shapeY;
+        UpdateNodeShapes(newNode);
+    }
 
-                UpdateNodeShapes(newNode);
-            }
+    int from = -1;
+    int to = -1;
 
-            int from = -1;
-            int to = -1;  
+    while (fscanf(dataFile, "?%i?%i\n", &from, &to) > 0)
+    {
+        FLine line = CreateNodeLine(context, from);
+        if (!LinkNodeLine(context, line, to)) DestroyNodeLine(context, line);
+    }
 
-            while (fscanf(dataFile, "?%i?%i\n", &from, &to) > 0)
-            {
-                tempLine = CreateNodeLine(from);
-                tempLine->to = to;
-            }
+    // Calculate loaded nodes values and shapes once all lines are linked
+    EndGraphEdit(context);
 
-            for (int i = 0; i < nodesCount; i++) UpdateNodeShapes(nodes[i]);
+    fclose(dataFile);
 
-            CalculateValues();
+    return true;
+}
 
-            for (int i = 0; i < nodesCount; i++) UpdateNodeShapes(nodes[i]);
+// Loads a texture in a shader texture unit keeping its source image
+void LoadTextureUnit(int unit, const char *path)
+{
+    UnloadTextureUnit(unit);
 
-            loadedShader = true;
-            fclose(dataFile);
-        }
-    }
+    // Sampler nodes preview reads pixels from RAM, so source image is kept instead of reading texture back from GPU
+    images[unit] = LoadImage(path);
 
-    if (!loadedShader)
+    if (images[unit].data != NULL)
     {
-        CreateNodeMaterial(FNODE_VERTEX, "[OUTPUT] Vertex Position", 0);
-        CreateNodeMaterial(FNODE_FRAGMENT, "[OUTPUT] Fragment Color", 0);
+        ImageFormat(&images[unit], UNCOMPRESSED_R8G8B8A8);
+        textures[unit] = LoadTextureFromImage(images[unit]);
     }
 }
 
+// Unloads a shader texture unit texture and its source image
+void UnloadTextureUnit(int unit)
+{
+    if (textures[unit].id != 0) UnloadTexture(textures[unit]);
+    if (images[unit].data != NULL) UnloadImage(images[unit]);
+
+    textures[unit] = (Texture2D){ 0 };
+    images[unit] = (Image){ 0 };
+}
+
 // Updates current mouse position and delta position
 void UpdateMouseData(void)
 {
@@ -551,6 +470,7 @@ void UpdateMouseData(void)
 void UpdateInputsData(void)
 {
     if (IsKeyPressed('H')) help = !help;
+    else if (IsKeyPressed('P') && (context->editNode == NULL_HANDLE) && (context->editComment == -1)) ExportPreview();
     else if (IsKeyPressed(KEY_RIGHT_ALT) && drawVisor)
     {
         fullVisor = !fullVisor;
@@ -559,7 +479,7 @@ void UpdateInputsData(void)
     }
 
     // Update canvas camera values
-    camera.target = mousePosition;
+    context->camera.target = mousePosition;
 }
 
 // Updates mouse scrolling for menu and canvas drag
@@ -572,8 +492,8 @@ void UpdateScroll(void)
             UpdateCamera(&camera3d);
         else if (CheckCollisionPointRec(mousePosition, (Rectangle){ 0, 0, canvasSize.x, canvasSize.y }))
         {
-            if (IsKeyDown(KEY_LEFT_ALT)) camera.offset.x -= GetMouseWheelMove()*UI_SCROLL;
-            else camera.offset.y -= GetMouseWheelMove()*UI_SCROLL;
+            if (IsKeyDown(KEY_LEFT_ALT)) context->camera.offset.x -= GetMouseWheelMove()*UI_SCROLL;
+            else context->camera.offset.y -= GetMouseWheelMove()*UI_SCROLL;
         }
         else
         {
@@ -615,17 +535,19 @@ void UpdateNodesEdit(void)
 {
     if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON))
     {
-        int index = -1;
+        FNode node = NULL;
         int data = -1;
-        for (int i = 0; i < nodesCount; i++)
+        for (int i = 0; i < context->nodesOrderCount; i++)
         {
-            if ((nodes[i]->type >= FNODE_MATRIX) && (nodes[i]->type <= FNODE_VECTOR4))
+            if (context->nodesOrder[i] == NULL) continue;
+
+            if ((context->nodesOrder[i]->type >= FNODE_MATRIX) && (context->nodesOrder[i]->type <= FNODE_VECTOR4))
             {
-                for (int k = 0; k < nodes[i]->output.dataCount; k++)
+                for (int k = 0; k < context->nodesOrder[i]->output.dataCount; k++)
                 {
-                    if (CheckCollisionPointRec(mousePosition, CameraToViewRec(nodes[i]->output.data[k].shape, camera)))
+                    if (CheckCollisionPointRec(mousePosition, CameraToViewRec(context->nodesOrder[i]->values[k].shape, context->camera)))
                     {
-                        index = i;
+                        node = context->nodesOrder[i];
                         data = k;
                         break;
                     }
@@ -633,50 +555,40 @@ void UpdateNodesEdit(void)
             }
         }
 
-        if (index != -1)
+        if (node != NULL)
         {
-            if ((editNode == -1) && (selectedNode == -1) && (lineState == 0) && (commentState == 0) && (selectedComment == -1) && (editSize == -1) && (editSizeType == -1) && (editComment == -1))
+            if ((context->editNode == NULL_HANDLE) && (context->selectedNode == NULL_HANDLE) && (context->lineState == 0) && (context->commentState == 0) && (context->selectedComment == -1) && (context->editSize == -1) && (context->editSizeType == -1) && (context->editComment == -1))
             {
-                editNode = nodes[index]->id;
-                editNodeType = data;
-                editNodeText = (char *)FNODE_MALLOC(MAX_NODE_LENGTH);
-                usedMemory += MAX_NODE_LENGTH;
-                for (int i = 0; i < MAX_NODE_LENGTH; i++) editNodeText[i] = nodes[index]->output.data[data].valueText[i];
+                context->editNode = GetNodeHandle(context, node);
+                context->editNodeType = data;
+                context->editNodeText = (char *)FNODE_MALLOC(MAX_NODE_LENGTH);
+                context->usedMemory += MAX_NODE_LENGTH;
+                for (int i = 0; i < MAX_NODE_LENGTH; i++) context->editNodeText[i] = node->values[data].valueText[i];
             }
-            else if ((editNode != -1) && (selectedNode == -1) && (lineState == 0) && (commentState == 0) && (selectedComment == -1) && (editSize == -1) && (editSizeType == -1) && (editComment == -1))
+            else if ((context->editNode != NULL_HANDLE) && (context->selectedNode == NULL_HANDLE) && (context->lineState == 0) && (context->commentState == 0) && (context->selectedComment == -1) && (context->editSize == -1) && (context->editSizeType == -1) && (context->editComment == -1))
             {
-                if ((nodes[index]->id != editNode) || (data != editNodeType))
+                if ((GetNodeHandle(context, node) != context->editNode) || (data != context->editNodeType))
                 {
-                    for (int i = 0; i < nodesCount; i++)
-                    {
-                        if (nodes[i]->id == editNode)
-                        {
-                            for (int k = 0; k < MAX_NODE_LENGTH; k++) nodes[i]->output.data[editNodeType].valueText[k] = editNodeText[k];
-                        }
-                    }
+                    FNode editNode = GetNodeFromHandle(context, context->editNode);
+                    if (editNode != NULL) for (int k = 0; k < MAX_NODE_LENGTH; k++) editNode->values[context->editNodeType].valueText[k] = context->editNodeText[k];
 
-                    editNode = nodes[index]->id;
-                    editNodeType = data;
+                    context->editNode = GetNodeHandle(context, node);
+                    context->editNodeType = data;
 
-                    for (int i = 0; i < MAX_NODE_LENGTH; i++) editNodeText[i] = nodes[index]->output.data[data].valueText[i];
+                    for (int i = 0; i < MAX_NODE_LENGTH; i++) context->editNodeText[i] = node->values[data].valueText[i];
                 }
             }
         }
-        else if ((editNode != -1) && (editNodeType != -1))
+        else if ((context->editNode != NULL_HANDLE) && (context->editNodeType != -1))
         {
-            for (int i = 0; i < nodesCount; i++)
-            {
-                if (nodes[i]->id == editNode)
-                {
-                    for (int k = 0; k < MAX_NODE_LENGTH; k++) nodes[i]->output.data[editNodeType].valueText[k] = editNodeText[k];
-                }
-            }
-
-            editNode = -1;
-            editNodeType = -1;
-            FNODE_FREE(editNodeText);
-            usedMemory -= MAX_NODE_LENGTH;
-            editNodeText = NULL;
+            FNode editNode = GetNodeFromHandle(context, context->editNode);
+            if (editNode != NULL) for (int k = 0; k < MAX_NODE_LENGTH; k++) editNode->values[context->editNodeType].valueText[k] = context->editNodeText[k];
+
+            context->editNode = NULL_HANDLE;
+            context->editNodeType = -1;
+            FNODE_FREE(context->editNodeText);
+            context->usedMemory -= MAX_NODE_LENGTH;
+            context->editNodeText = NULL;
         }     
     }
 }
@@ -684,105 +596,104 @@ void UpdateNodesEdit(void)
 // Check node drag input
 void UpdateNodesDrag(void)
 {
-    if ((selectedNode == -1) && (lineState == 0) && (commentState == 0) && (selectedComment == -1))
+    if ((context->selectedNode == NULL_HANDLE) && (context->lineState == 0) && (context->commentState == 0) && (context->selectedComment == -1))
     {
         if (IsMouseButtonDown(MOUSE_LEFT_BUTTON))
         {
-            for (int i = nodesCount - 1; i >= 0; i--)
+            for (int i = context->nodesOrderCount - 1; i >= 0; i--)
             {
-                if (CheckCollisionPointRec(mousePosition, CameraToViewRec(nodes[i]->shape, camera)))
+                if (context->nodesOrder[i] == NULL) continue;
+
+                if (CheckCollisionPointRec(mousePosition, CameraToViewRec(context->nodesOrder[i]->shape, context->camera)))
                 {
-                    selectedNode = nodes[i]->id;
-                    currentOffset = (Vector2){ mousePosition.x - nodes[i]->shape.x, mousePosition.y - nodes[i]->shape.y };
+                    context->selectedNode = GetNodeHandle(context, context->nodesOrder[i]);
+                    currentOffset = (Vector2){ mousePosition.x - context->nodesOrder[i]->shape.x, mousePosition.y - context->nodesOrder[i]->shape.y };
                     break;
                 }
             }
 
-            if ((selectedNode == -1) && (scrollState == 0) && (!CheckCollisionPointRec(mousePosition, (Rectangle){ canvasSize.x, 0, (screenSize.x - canvasSize.x), screenSize.y })))
+            if ((context->selectedNode == NULL_HANDLE) && (scrollState == 0) && (!CheckCollisionPointRec(mousePosition, (Rectangle){ canvasSize.x, 0, (screenSize.x - canvasSize.x), screenSize.y })))
             {
-                camera.offset.x += mouseDelta.x;
-                camera.offset.y += mouseDelta.y;
+                context->camera.offset.x += mouseDelta.x;
+                context->camera.offset.y += mouseDelta.y;
             }
         }
         else if (IsMouseButtonPressed(MOUSE_RIGHT_BUTTON))
         {
-            for (int i = nodesCount - 1; i >= 0; i--)
+            for (int i = context->nodesOrderCount - 1; i >= 0; i--)
             {
-                if (CheckCollisionPointRec(mousePosition, CameraToViewRec(nodes[i]->shape, camera)) && (nodes[i]->type < FNODE_VERTEX))
+                if (context->nodesOrder[i] == NULL) continue;
+
+                if (CheckCollisionPointRec(mousePosition, CameraToViewRec(context->nodesOrder[i]->shape, context->camera)) && (context->nodesOrder[i]->type < FNODE_VERTEX))
                 {
-                    DestroyNode(nodes[i]);
-                    CalculateValues();
+                    BeginGraphEdit(context);
+                    DestroyNode(context, context->nodesOrder[i]);
+                    EndGraphEdit(context);
                     break;
                 }
             }
         }
     }
-    else if ((selectedNode != -1) && (lineState == 0) && (commentState == 0) && (selectedComment == -1))
+    else if ((context->selectedNode != NULL_HANDLE) && (context->lineState == 0) && (context->commentState == 0) && (context->selectedComment == -1))
     {
-        for (int i = 0; i < nodesCount; i++)
+        FNode node = GetNodeFromHandle(context, context->selectedNode);
+
+        if (node != NULL)
         {
-            if (nodes[i]->id == selectedNode)
-            {
-                nodes[i]->shape.x = mousePosition.x - currentOffset.x;
-                nodes[i]->shape.y = mousePosition.y - currentOffset.y;
+            node->shape.x = mousePosition.x - currentOffset.x;
+            node->shape.y = mousePosition.y - currentOffset.y;
 
-                // Check aligned drag movement input
-                if (IsKeyDown(KEY_LEFT_ALT)) AlignNode(nodes[i]);
+            // Check aligned drag movement input
+            if (IsKeyDown(KEY_LEFT_ALT)) AlignNode(node);
 
-                UpdateNodeShapes(nodes[i]);
-                break;
-            }
+            UpdateNodeShapes(node);
         }
 
-        if (IsMouseButtonUp(MOUSE_LEFT_BUTTON)) selectedNode = -1;
+        if (IsMouseButtonUp(MOUSE_LEFT_BUTTON) || (node == NULL)) context->selectedNode = NULL_HANDLE;
     }
 }
 
 // Check node link input
 void UpdateNodesLink(void)
 {
-    if ((selectedNode == -1) && (commentState == 0) && (selectedComment == -1)) 
+    if ((context->selectedNode == NULL_HANDLE) && (context->commentState == 0) && (context->selectedComment == -1)) 
     {
-        switch (lineState)
+        switch (context->lineState)
         {
             case 0:
             {
                 if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON))
                 {
-                    for (int i = nodesCount - 1; i >= 0; i--)
+                    for (int i = context->nodesOrderCount - 1; i >= 0; i--)
                     {
-                        if (CheckCollisionPointRec(mousePosition, CameraToViewRec(nodes[i]->outputShape, camera)))
+                        if (context->nodesOrder[i] == NULL) continue;
+
+                        if (CheckCollisionPointRec(mousePosition, CameraToViewRec(context->nodesOrder[i]->outputShape, context->camera)))
                         {
-                            tempLine = CreateNodeLine(nodes[i]->id);
-                            lineState = 1;
+                            context->tempLine = CreateNodeLine(context, context->nodesOrder[i]->id);
+                            context->lineState = 1;
                             break;
                         }
                     }
                 }
                 else if (IsMouseButtonPressed(MOUSE_RIGHT_BUTTON) && !IsKeyDown(KEY_LEFT_ALT))
                 {
-                    for (int i = nodesCount - 1; i >= 0; i--)
+                    for (int i = context->nodesOrderCount - 1; i >= 0; i--)
                     {
-                        if (CheckCollisionPointRec(mousePosition, CameraToViewRec(nodes[i]->outputShape, camera)))
-                        {
-                            for (int k = linesCount - 1; k >= 0; k--)
-                            {
-                                if (nodes[i]->id == lines[k]->from) DestroyNodeLine(lines[k]);
-                            }
+                        if (context->nodesOrder[i] == NULL) continue;
 
-                            CalculateValues();
-                            CalculateValues();
+                        if (CheckCollisionPointRec(mousePosition, CameraToViewRec(context->nodesOrder[i]->outputShape, context->camera)))
+                        {
+                            BeginGraphEdit(context);
+                            while (context->nodesOrder[i]->outputLines != NULL) DestroyNodeLine(context, context->nodesOrder[i]->outputLines);
+                            EndGraphEdit(context);
                             break;
                         }
-                        else if (CheckCollisionPointRec(mousePosition, CameraToViewRec(nodes[i]->inputShape, camera)))
+                        else if (CheckCollisionPointRec(mousePosition, CameraToViewRec(context->nodesOrder[i]->inputShape, context->camera)))
                         {
-                            for (int k = linesCount - 1; k >= 0; k--)
-                            {
-                                if (nodes[i]->id == lines[k]->to) DestroyNodeLine(lines[k]);
-                            }
-
-                            CalculateValues();
-                            CalculateValues();
+                            BeginGraphEdit(context);
+                            while (context->nodesOrder[i]->inputsCount > 0) DestroyNodeLine(context, context->nodesOrder[i]->inputLines[context->nodesOrder[i]->inputsCount - 1]);
+                            EndGraphEdit(context);
                             break;
                         }
                     }
@@ -792,93 +703,99 @@ void UpdateNodesLink(void)
             {
                 if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON))
                 {
-                    for (int i = 0; i < nodesCount; i++)
+                    for (int i = 0; i < context->nodesOrderCount; i++)
                     {
-                        if (CheckCollisionPointRec(mousePosition, CameraToViewRec(nodes[i]->inputShape, camera)) && (nodes[i]->id != tempLine->from) && (nodes[i]->inputsCount < nodes[i]->inputsLimit))
+                        if (context->nodesOrder[i] == NULL) continue;
+
+                        if (CheckCollisionPointRec(mousePosition, CameraToViewRec(context->nodesOrder[i]->inputShape, context->camera)) && (GetNodeHandle(context, context->nodesOrder[i]) != context->tempLine->from) && (context->nodesOrder[i]->inputsCount < context->nodesOrder[i]->inputsLimit))
                         {
-                            // Get which index has the first input node id from current nude                            
-                            int indexFrom = GetNodeIndex(tempLine->from);
+                            // Resolve the node the temporal line starts from
+                            FNode fromNode = GetNodeFromHandle(context, context->tempLine->from);
+                            if (fromNode == NULL) break;
 
                             bool valuesCheck = true;
-                            if (nodes[i]->type == FNODE_SAMPLER2D) valuesCheck = (nodes[indexFrom]->output.dataCount == 1);
-                            else if (nodes[i]->type == FNODE_LERP) valuesCheck = (nodes[i]->inputsCount <= nodes[i]->inputsLimit);
-                            else if (nodes[i]->type == FNODE_APPEND) valuesCheck = ((nodes[i]->output.dataCount + nodes[indexFrom]->output.dataCount <= 4) && (nodes[indexFrom]->output.dataCount == 1));
-                            else if (nodes[i]->type == FNODE_VERTEXCOLOR) valuesCheck = (nodes[indexFrom]->output.dataCount == 1);
-                            else if ((nodes[i]->type == FNODE_POWER) && (nodes[i]->inputsCount == 1)) valuesCheck = (nodes[indexFrom]->output.dataCount == 1);
-                            else if (nodes[i]->type == FNODE_STEP) valuesCheck = (nodes[indexFrom]->output.dataCount == 1);
-                            else if (nodes[i]->type == FNODE_NORMALIZE) valuesCheck = ((nodes[indexFrom]->output.dataCount > 1) && (nodes[indexFrom]->output.dataCount <= 4));
-                            else if (nodes[i]->type == FNODE_CROSSPRODUCT) valuesCheck = (nodes[indexFrom]->output.dataCount == 3);
-                            else if (nodes[i]->type == FNODE_DESATURATE)
+                            if (context->nodesOrder[i]->type == FNODE_SAMPLER2D) valuesCheck = (fromNode->output.dataCount == 1);
+                            else if (context->nodesOrder[i]->type == FNODE_LERP) valuesCheck = (context->nodesOrder[i]->inputsCount <= context->nodesOrder[i]->inputsLimit);
+                            else if (context->nodesOrder[i]->type == FNODE_APPEND) valuesCheck = ((context->nodesOrder[i]->output.dataCount + fromNode->output.dataCount <= 4) && (fromNode->output.dataCount == 1));
+                            else if (context->nodesOrder[i]->type == FNODE_VERTEXCOLOR) valuesCheck = (fromNode->output.dataCount == 1);
+                            else if ((context->nodesOrder[i]->type == FNODE_POWER) && (context->nodesOrder[i]->inputsCount == 1)) valuesCheck = (fromNode->output.dataCount == 1);
+                            else if (context->nodesOrder[i]->type == FNODE_STEP) valuesCheck = (fromNode->output.dataCount == 1);
+                            else if (context->nodesOrder[i]->type == FNODE_NORMALIZE) valuesCheck = ((fromNode->output.dataCount > 1) && (fromNode->output.dataCount <= 4));
+                            else if (context->nodesOrder[i]->type == FNODE_CROSSPRODUCT) valuesCheck = (fromNode->output.dataCount == 3);
+                            else if (context->nodesOrder[i]->type == FNODE_DESATURATE)
                             {
-                                if (nodes[i]->inputsCount == 0) valuesCheck = (nodes[indexFrom]->output.dataCount < 4);
-                                else if (nodes[i]->inputsCount == 1) valuesCheck = (nodes[indexFrom]->output.dataCount == 1);
+                                if (context->nodesOrder[i]->inputsCount == 0) valuesCheck = (fromNode->output.dataCount < 4);
+                                else if (context->nodesOrder[i]->inputsCount == 1) valuesCheck = (fromNode->output.dataCount == 1);
                             }
-                            else if ((nodes[i]->type == FNODE_DOTPRODUCT) || (nodes[i]->type == FNODE_LENGTH) || ((nodes[i]->type >= FNODE_PROJECTION) && (nodes[i]->type <= FNODE_HALFDIRECTION)))
+                            else if ((context->nodesOrder[i]->type == FNODE_DOTPRODUCT) || (context->nodesOrder[i]->type == FNODE_LENGTH) || ((context->nodesOrder[i]->type >= FNODE_PROJECTION) && (context->nodesOrder[i]->type <= FNODE_HALFDIRECTION)))
                             {
-                                valuesCheck = ((nodes[indexFrom]->output.dataCount > 1) && (nodes[indexFrom]->output.dataCount <= 4));
+                                valuesCheck = ((fromNode->output.dataCount > 1) && (fromNode->output.dataCount <= 4));
 
-                                if (valuesCheck && (nodes[i]->inputsCount > 0))
+                                if (valuesCheck && (context->nodesOrder[i]->inputsCount > 0))
                                 {
-                                    int index = GetNodeIndex(nodes[i]->inputs[0]);
+                                    int index = GetNodeIndex(context, context->nodesOrder[i]->inputs[0]);
                                     
-                                    if (index != -1) valuesCheck = (nodes[indexFrom]->output.dataCount == nodes[index]->output.dataCount);
+                                    if (index != -1) valuesCheck = (fromNode->output.dataCount == context->nodes[index]->output.dataCount);
                                     else TraceLogFNode(true, "error when trying to get node inputs index");
                                 }
                             }
-                            else if (nodes[i]->type == FNODE_DISTANCE)
+                            else if (context->nodesOrder[i]->type == FNODE_DISTANCE)
                             {
-                                valuesCheck = ((nodes[indexFrom]->output.dataCount <= 4));
+                                valuesCheck = ((fromNode->output.dataCount <= 4));
 
-                                if (valuesCheck && (nodes[i]->inputsCount > 0))
+                                if (valuesCheck && (context->nodesOrder[i]->inputsCount > 0))
                                 {
-                                    int index = GetNodeIndex(nodes[i]->inputs[0]);
+                                    int index = GetNodeIndex(context, context->nodesOrder[i]->inputs[0]);
                                     
-                                    if (index != -1) valuesCheck = (nodes[indexFrom]->output.dataCount == nodes[index]->output.dataCount);
+                                    if (index != -1) valuesCheck = (fromNode->output.dataCount == context->nodes[index]->output.dataCount);
                                     else TraceLogFNode(true, "error when trying to get node inputs index");
                                 }
                             }
-                            else if ((nodes[i]->type == FNODE_MULTIPLYMATRIX) || (nodes[i]->type == FNODE_TRANSPOSE)) valuesCheck = (nodes[indexFrom]->output.dataCount == 16);
-                            else if (nodes[i]->type >= FNODE_VERTEX) valuesCheck = (nodes[indexFrom]->output.dataCount <= nodes[i]->output.dataCount);
-                            else if (nodes[i]->type > FNODE_DIVIDE) valuesCheck = (nodes[i]->output.dataCount == nodes[indexFrom]->output.dataCount);
-
-                            if (((nodes[i]->inputsCount == 0) && (nodes[i]->type != FNODE_NORMALIZE) && (nodes[i]->type != FNODE_DOTPRODUCT) && 
-                            (nodes[i]->type != FNODE_LENGTH) && (nodes[i]->type != FNODE_MULTIPLYMATRIX) && (nodes[i]->type != FNODE_TRANSPOSE) && (nodes[i]->type != FNODE_PROJECTION) &&
-                            (nodes[i]->type != FNODE_DISTANCE) && (nodes[i]->type != FNODE_REJECTION) && (nodes[i]->type != FNODE_HALFDIRECTION) && (nodes[i]->type != FNODE_STEP) &&
-                            (nodes[i]->type != FNODE_LERP) && (nodes[i]->type != FNODE_SAMPLER2D)) || valuesCheck)
+                            else if ((context->nodesOrder[i]->type == FNODE_MULTIPLYMATRIX) || (context->nodesOrder[i]->type == FNODE_TRANSPOSE)) valuesCheck = (fromNode->output.dataCount == 16);
+                            else if (context->nodesOrder[i]->type >= FNODE_VERTEX) valuesCheck = (fromNode->output.dataCount <= context->nodesOrder[i]->output.dataCount);
+                            else if (context->nodesOrder[i]->type > FNODE_DIVIDE) valuesCheck = (context->nodesOrder[i]->output.dataCount == fromNode->output.dataCount);
+
+                            if (((context->nodesOrder[i]->inputsCount == 0) && (context->nodesOrder[i]->type != FNODE_NORMALIZE) && (context->nodesOrder[i]->type != FNODE_DOTPRODUCT) && 
+                            (context->nodesOrder[i]->type != FNODE_LENGTH) && (context->nodesOrder[i]->type != FNODE_MULTIPLYMATRIX) && (context->nodesOrder[i]->type != FNODE_TRANSPOSE) && (context->nodesOrder[i]->type != FNODE_PROJECTION) &&
+                            (context->nodesOrder[i]->type != FNODE_DISTANCE) && (context->nodesOrder[i]->type != FNODE_REJECTION) && (context->nodesOrder[i]->type != FNODE_HALFDIRECTION) && (context->nodesOrder[i]->type != FNODE_STEP) &&
+                            (context->nodesOrder[i]->type != FNODE_LERP) && (context->nodesOrder[i]->type != FNODE_SAMPLER2D)) || valuesCheck)
                             {
+                                BeginGraphEdit(context);
+
                                 // Check if there is already a line created with same linking ids
-                                for (int k = 0; k < linesCount; k++)
+                                for (int k = 0; k < context->nodesOrder[i]->inputsCount; k++)
                                 {
-                                    if ((lines[k]->to == nodes[i]->id) && (lines[k]->from == tempLine->from))
+                                    if (context->nodesOrder[i]->inputs[k] == fromNode->id)
                                     {
-                                        DestroyNodeLine(lines[k]);
+                                        DestroyNodeLine(context, context->nodesOrder[i]->inputLines[k]);
                                         break;
                                     }
                                 }
 
                                 // Save temporal line values and destroy it
-                                int from = tempLine->from;
-                                int to = nodes[i]->id;
-                                DestroyNodeLine(tempLine);
+                                int from = fromNode->id;
+                                int to = context->nodesOrder[i]->id;
+                                DestroyNodeLine(context, context->tempLine);
 
                                 // Create final node line
-                                FLine temp = CreateNodeLine(from);
-                                temp->to = to;
+                                // Create final node line (it is discarded if it closes a cycle)
+                                FLine temp = CreateNodeLine(context, from);
+                                if (!LinkNodeLine(context, temp, to)) DestroyNodeLine(context, temp);
+
+                                EndGraphEdit(context);
 
                                 // Reset linking state values
-                                lineState = 0;
-                                CalculateValues();
-                                CalculateValues();
+                                context->lineState = 0;
                                 break;
                             }
-                            else TraceLogFNode(false, "error trying to link node ID %i (length: %i) with node ID %i (length: %i)", nodes[i]->id, nodes[i]->output.dataCount, nodes[indexFrom]->id, nodes[indexFrom]->output.dataCount);
+                            else TraceLogFNode(false, "error trying to link node ID %i (length: %i) with node ID %i (length: %i)", context->nodesOrder[i]->id, context->nodesOrder[i]->output.dataCount, fromNode->id, fromNode->output.dataCount);
                         }
                     }
                 }
                 else if (IsMouseButtonPressed(MOUSE_RIGHT_BUTTON))
                 {
-                    DestroyNodeLine(tempLine);
-                    lineState = 0;
+                    DestroyNodeLine(context, context->tempLine);
+                    context->lineState = 0;
                 }
             } break;
             default: break;
@@ -889,9 +806,9 @@ void UpdateNodesLink(void)
 // Check comment creation input
 void UpdateCommentCreationEdit(void)
 {
-    if ((selectedNode == -1) && (lineState == 0) && (selectedComment == -1)) 
+    if ((context->selectedNode == NULL_HANDLE) && (context->lineState == 0) && (context->selectedComment == -1)) 
     {
-        switch (commentState)
+        switch (context->commentState)
         {
             case 0:
             {
@@ -899,75 +816,75 @@ void UpdateCommentCreationEdit(void)
                 {
                     if (IsKeyDown(KEY_LEFT_ALT))
                     {
-                        commentState = 1;
+                        context->commentState = 1;
 
-                        tempCommentPos.x = mousePosition.x;
-                        tempCommentPos.y = mousePosition.y;
+                        context->tempCommentPos.x = mousePosition.x;
+                        context->tempCommentPos.y = mousePosition.y;
 
-                        tempComment = CreateComment();
-                        tempComment->shape.x = mousePosition.x - camera.offset.x;
-                        tempComment->shape.y = mousePosition.y - camera.offset.y;
+                        context->tempComment = CreateComment(context);
+                        context->tempComment->shape.x = mousePosition.x - context->camera.offset.x;
+                        context->tempComment->shape.y = mousePosition.y - context->camera.offset.y;
 
-                        UpdateCommentShapes(tempComment);
+                        UpdateCommentShapes(context, context->tempComment);
                     }
                     else
                     {
-                        for (int i = 0; i < commentsCount; i++)
+                        for (int i = 0; i < context->commentsCount; i++)
                         {
-                            if (CheckCollisionPointRec(mousePosition, CameraToViewRec(comments[i]->sizeTShape, camera)))
+                            if (CheckCollisionPointRec(mousePosition, CameraToViewRec(context->comments[i]->sizeTShape, context->camera)))
                             {
-                                editSize = comments[i]->id;
-                                commentState = 1;
-                                editSizeType = 0;
+                                context->editSize = context->comments[i]->id;
+                                context->commentState = 1;
+                                context->editSizeType = 0;
                                 break;
                             }
-                            else if (CheckCollisionPointRec(mousePosition, CameraToViewRec(comments[i]->sizeBShape, camera)))
+                            else if (CheckCollisionPointRec(mousePosition, CameraToViewRec(context->comments[i]->sizeBShape, context->camera)))
                             {
-                                editSize = comments[i]->id;
-                                commentState = 1;
-                                editSizeType = 1;
+                                context->editSize = context->comments[i]->id;
+                                context->commentState = 1;
+                                context->editSizeType = 1;
                                 break;
                             }
-                            else if (CheckCollisionPointRec(mousePosition, CameraToViewRec(comments[i]->sizeLShape, camera)))
+                            else if (CheckCollisionPointRec(mousePosition, CameraToViewRec(context->comments[i]->sizeLShape, context->camera)))
                             {
-                                editSize = comments[i]->id;
-                                commentState = 1;
-                                editSizeType = 2;
+                                context->editSize = context->comments[i]->id;
+                                context->commentState = 1;
+                                context->editSizeType = 2;
                                 break;
                             }
-                            else if (CheckCollisionPointRec(mousePosition, CameraToViewRec(comments[i]->sizeRShape, camera)))
+                            else if (CheckCollisionPointRec(mousePosition, CameraToViewRec(context->comments[i]->sizeRShape, context->camera)))
                             {
-                                editSize = comments[i]->id;
-                                commentState = 1;
-                                editSizeType = 3;
+                                context->editSize = context->comments[i]->id;
+                                context->commentState = 1;
+                                context->editSizeType = 3;
                                 break;
                             }
-                            else if (CheckCollisionPointRec(mousePosition, CameraToViewRec(comments[i]->sizeTlShape, camera)))
+                            else if (CheckCollisionPointRec(mousePosition, CameraToViewRec(context->comments[i]->sizeTlShape, context->camera)))
                             {
-                                editSize = comments[i]->id;
-                                commentState = 1;
-                                editSizeType = 4;
+                                context->editSize = context->comments[i]->id;
+                                context->commentState = 1;
+                                context->editSizeType = 4;
                                 break;
                             }
-                            else if (CheckCollisionPointRec(mousePosition, CameraToViewRec(comments[i]->sizeTrShape, camera)))
+                            else if (CheckCollisionPointRec(mousePosition, CameraToViewRec(context->comments[i]->sizeTrShape, context->camera)))
                             {
-                                editSize = comments[i]->id;
-                                commentState = 1;
-                                editSizeType = 5;
+                                context->editSize = context->comments[i]->id;
+                                context->commentState = 1;
+                                context->editSizeType = 5;
                                 break;
                             }
-                            else if (CheckCollisionPointRec(mousePosition, CameraToViewRec(comments[i]->sizeBlShape, camera)))
+                            else if (CheckCollisionPointRec(mousePosition, CameraToViewRec(context->comments[i]->sizeBlShape, context->camera)))
                             {
-                                editSize = comments[i]->id;
-                                commentState = 1;
-                                editSizeType = 6;
+                                context->editSize = context->comments[i]->id;
+                                context->commentState = 1;
+                                context->editSizeType = 6;
                                 break;
                             }
-                            else if (CheckCollisionPointRec(mousePosition, CameraToViewRec(comments[i]->sizeBrShape, camera)))
+                            else if (CheckCollisionPointRec(mousePosition, CameraToViewRec(context->comments[i]->sizeBrShape, context->camera)))
                             {
-                                editSize = comments[i]->id;
-                                commentState = 1;
-                                editSizeType = 7;
+                                context->editSize = context->comments[i]->id;
+                                context->commentState = 1;
+                                context->editSizeType = 7;
                                 break;
                             }
                         }
@@ -976,99 +893,99 @@ void UpdateCommentCreationEdit(void)
             } break;
             case 1:
             {
-                if (editSize != -1)
+                if (context->editSize != -1)
                 {
-                    for (int i = 0; i < commentsCount; i++)
+                    for (int i = 0; i < context->commentsCount; i++)
                     {
-                        if (comments[i]->id == editSize)
+                        if (context->comments[i]->id == context->editSize)
                         {
-                            switch (editSizeType)
+                            switch (context->editSizeType)
                             {
                                 case 0:
                                 {
-                                    comments[i]->shape.y += mouseDelta.y;
-                                    comments[i]->shape.height -= mouseDelta.y;
+                                    context->comments[i]->shape.y += mouseDelta.y;
+                                    context->comments[i]->shape.height -= mouseDelta.y;
                                 } break;
-                                case 1: comments[i]->shape.height += mouseDelta.y; break;
+                                case 1: context->comments[i]->shape.height += mouseDelta.y; break;
                                 case 2:
                                 {
-                                    comments[i]->shape.x += mouseDelta.x;
-                                    comments[i]->shape.width -= mouseDelta.x;
+                                    context->comments[i]->shape.x += mouseDelta.x;
+                                    context->comments[i]->shape.width -= mouseDelta.x;
                                 } break;
-                                case 3: comments[i]->shape.width += mouseDelta.x; break;
+                                case 3: context->comments[i]->shape.width += mouseDelta.x; break;
                                 case 4:
                                 {
-                                    comments[i]->shape.x += mouseDelta.x;
-                                    comments[i]->shape.width -= mouseDelta.x;
-                                    comments[i]->shape.y += mouseDelta.y;
-                                    comments[i]->shape.height -= mouseDelta.y;
+                                    context->comments[i]->shape.x += mouseDelta.x;
+                                    context->comments[i]->shape.width -= mouseDelta.x;
+                                    context->comments[i]->shape.y += mouseDelta.y;
+                                    context->comments[i]->shape.height -= mouseDelta.y;
                                 } break;
                                 case 5:
                                 {
-                                    comments[i]->shape.width += mouseDelta.x;
-                                    comments[i]->shape.y += mouseDelta.y;
-                                    comments[i]->shape.height -= mouseDelta.y;
+                                    context->comments[i]->shape.width += mouseDelta.x;
+                                    context->comments[i]->shape.y += mouseDelta.y;
+                                    context->comments[i]->shape.height -= mouseDelta.y;
                                 } break;
                                 case 6:
                                 {
-                                    comments[i]->shape.x += mouseDelta.x;
-                                    comments[i]->shape.width -= mouseDelta.x;
-                                    comments[i]->shape.height += mouseDelta.y;
+                                    context->comments[i]->shape.x += mouseDelta.x;
+                                    context->comments[i]->shape.width -= mouseDelta.x;
+                                    context->comments[i]->shape.height += mouseDelta.y;
                                 } break;
                                 case 7:
                                 {
-                                    comments[i]->shape.width += mouseDelta.x;
-                                    comments[i]->shape.height += mouseDelta.y;
+                                    context->comments[i]->shape.width += mouseDelta.x;
+                                    context->comments[i]->shape.height += mouseDelta.y;
                                 } break;
                                 default: break;
                             }
 
-                            UpdateCommentShapes(comments[i]);
+                            UpdateCommentShapes(context, context->comments[i]);
                             break;
                         }
                     }
 
                     if (IsMouseButtonUp(MOUSE_LEFT_BUTTON))
                     {
-                        editSize = -1;
-                        editSizeType = -1;
-                        commentState = 0;
+                        context->editSize = -1;
+                        context->editSizeType = -1;
+                        context->commentState = 0;
                     }
                 }
                 else
                 {
-                    if ((mousePosition.x - tempCommentPos.x) >= 0) tempComment->shape.width = mousePosition.x - tempComment->shape.x - camera.offset.x;
+                    if ((mousePosition.x - context->tempCommentPos.x) >= 0) context->tempComment->shape.width = mousePosition.x - context->tempComment->shape.x - context->camera.offset.x;
                     else
                     {
-                        tempComment->shape.width = tempCommentPos.x - mousePosition.x;
-                        tempComment->shape.x = tempCommentPos.x - tempComment->shape.width - camera.offset.x;
+                        context->tempComment->shape.width = context->tempCommentPos.x - mousePosition.x;
+                        context->tempComment->shape.x = context->tempCommentPos.x - context->tempComment->shape.width - context->camera.offset.x;
                     }
 
-                    if ((mousePosition.y - tempCommentPos.y) >= 0) tempComment->shape.height = mousePosition.y - tempComment->shape.y - camera.offset.y;
+                    if ((mousePosition.y - context->tempCommentPos.y) >= 0) context->tempComment->shape.height = mousePosition.y - context->tempComment->shape.y - context->camera.offset.y;
                     else
                     {
-                        tempComment->shape.height = tempCommentPos.y - mousePosition.y;
-                        tempComment->shape.y = tempCommentPos.y - tempComment->shape.height - camera.offset.y;
+                        context->tempComment->shape.height = context->tempCommentPos.y - mousePosition.y;
+                        context->tempComment->shape.y = context->tempCommentPos.y - context->tempComment->shape.height - context->camera.offset.y;
                     }
 
-                    UpdateCommentShapes(tempComment);
+                    UpdateCommentShapes(context, context->tempComment);
 
                     if (IsMouseButtonUp(MOUSE_LEFT_BUTTON))
                     {
                         // Save temporal comment values
-                        Rectangle tempRec = { tempComment->shape.x, tempComment->shape.y, tempComment->shape.width, tempComment->shape.height };
-                        DestroyComment(tempComment);
+                        Rectangle tempRec = { context->tempComment->shape.x, context->tempComment->shape.y, context->tempComment->shape.width, context->tempComment->shape.height };
+                        DestroyComment(context, context->tempComment);
 
                         // Reset comment state
-                        commentState = 0;
+                        context->commentState = 0;
 
                         if (tempRec.width >= 0 && tempRec.height >= 0)
                         {
                             // Create final comment
-                            FComment temp = CreateComment();
+                            FComment temp = CreateComment(context);
                             temp->shape = tempRec;
 
-                            UpdateCommentShapes(temp);
+                            UpdateCommentShapes(context, temp);
                         }
                         else TraceLogFNode(false, "comment have not been created because its width or height are has a negative value");
                     }
@@ -1082,27 +999,25 @@ void UpdateCommentCreationEdit(void)
 // Check comment drag input
 void UpdateCommentsDrag(void)
 {
-    if ((selectedComment == -1) && (lineState == 0) && (commentState == 0) && (selectedNode == -1))
+    if ((context->selectedComment == -1) && (context->lineState == 0) && (context->commentState == 0) && (context->selectedNode == NULL_HANDLE))
     {
         if (!IsKeyDown(KEY_LEFT_ALT))
         {
             if (IsMouseButtonDown(MOUSE_LEFT_BUTTON))
             {
-                for (int i = commentsCount - 1; i >= 0; i--)
+                for (int i = context->commentsCount - 1; i >= 0; i--)
                 {
-                    if (CheckCollisionPointRec(mousePosition, CameraToViewRec(comments[i]->shape, camera)))
+                    if (CheckCollisionPointRec(mousePosition, CameraToViewRec(context->comments[i]->shape, context->camera)))
                     {
-                        selectedComment = comments[i]->id;
-                        currentOffset = (Vector2){ mousePosition.x - comments[i]->shape.x, mousePosition.y - comments[i]->shape.y };
+                        context->selectedComment = context->comments[i]->id;
+                        currentOffset = (Vector2){ mousePosition.x - context->comments[i]->shape.x, mousePosition.y - context->comments[i]->shape.y };
 
-                        for (int k = 0; k < nodesCount; k++)
+                        for (int k = 0; k < context->nodesCount; k++)
                         {
-                            if (CheckCollisionRecs(CameraToViewRec(comments[i]->shape, camera), CameraToViewRec(nodes[k]->shape, camera)))
+                            if (CheckCollisionRecs(CameraToViewRec(context->comments[i]->shape, context->camera), CameraToViewRec(context->nodes[k]->shape, context->camera)))
                             {
-                                selectedCommentNodes[selectedCommentNodesCount] = nodes[k]->id;
-                                selectedCommentNodesCount++;
-
-                                if (selectedCommentNodesCount > MAX_NODES) break;
+                                context->selectedCommentNodes[context->selectedCommentNodesCount] = GetNodeHandle(context, context->nodes[k]);
+                                context->selectedCommentNodesCount++;
                             }
                         }
 
@@ -1113,40 +1028,36 @@ void UpdateCommentsDrag(void)
         }
         else if (IsMouseButtonPressed(MOUSE_RIGHT_BUTTON))
         {
-            for (int i = commentsCount - 1; i >= 0; i--)
+            for (int i = context->commentsCount - 1; i >= 0; i--)
             {
-                if (CheckCollisionPointRec(mousePosition, CameraToViewRec(comments[i]->shape, camera)))
+                if (CheckCollisionPointRec(mousePosition, CameraToViewRec(context->comments[i]->shape, context->camera)))
                 {
-                    DestroyComment(comments[i]);
+                    DestroyComment(context, context->comments[i]);
                     break;
                 }
             }
         }
     }
-    else if ((selectedComment != -1) && (lineState == 0) && (commentState == 0) && (selectedNode == -1))
+    else if ((context->selectedComment != -1) && (context->lineState == 0) && (context->commentState == 0) && (context->selectedNode == NULL_HANDLE))
     {
-        for (int i = 0; i < commentsCount; i++)
+        for (int i = 0; i < context->commentsCount; i++)
         {
-            if (comments[i]->id == selectedComment)
+            if (context->comments[i]->id == context->selectedComment)
             {
-                comments[i]->shape.x = mousePosition.x - currentOffset.x;
-                comments[i]->shape.y = mousePosition.y - currentOffset.y;
+                context->comments[i]->shape.x = mousePosition.x - currentOffset.x;
+                context->comments[i]->shape.y = mousePosition.y - currentOffset.y;
 
-                UpdateCommentShapes(comments[i]);
+                UpdateCommentShapes(context, context->comments[i]);
 
-                for (int k = 0; k < selectedCommentNodesCount; k++)
+                for (int k = 0; k < context->selectedCommentNodesCount; k++)
                 {
-                    for (int j = 0; j < nodesCount; j++)
-                    {
-                        if (nodes[j]->id == selectedCommentNodes[k])
-                        {
-                            nodes[j]->shape.x += mouseDelta.x;
-                            nodes[j]->shape.y += mouseDelta.y;
+                    FNode node = GetNodeFromHandle(context, context->selectedCommentNodes[k]);
+                    if (node == NULL) continue;
 
-                            UpdateNodeShapes(nodes[j]);
-                            break;
-                        }
-                    }
+                    node->shape.x += mouseDelta.x;
+                    node->shape.y += mouseDelta.y;
+
+                    UpdateNodeShapes(node);
                 }
                 break;
             }
@@ -1154,10 +1065,10 @@ void UpdateCommentsDrag(void)
 
         if (IsMouseButtonUp(MOUSE_LEFT_BUTTON))
         {
-            selectedComment = -1;
+            context->selectedComment = -1;
 
-            for (int i = 0; i < selectedCommentNodesCount; i++) selectedCommentNodes[i] = -1;
-            selectedCommentNodesCount = 0;
+            for (int i = 0; i < context->selectedCommentNodesCount; i++) context->selectedCommentNodes[i] = NULL_HANDLE;
+            context->selectedCommentNodesCount = 0;
         }
     }
 }
@@ -1167,45 +1078,56 @@ void UpdateCommentsEdit(void)
 {
     if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON))
     {
-        if ((editComment == -1) && (selectedNode == -1) && (lineState == 0) && (commentState == 0) && (selectedComment == -1) && (editSize == -1) && (editSizeType == -1) && (editNode == -1))
+        if ((context->editComment == -1) && (context->selectedNode == NULL_HANDLE) && (context->lineState == 0) && (context->commentState == 0) && (context->selectedComment == -1) && (context->editSize == -1) && (context->editSizeType == -1) && (context->editNode == NULL_HANDLE))
         {
-            for (int i = 0; i < commentsCount; i++)
+            for (int i = 0; i < context->commentsCount; i++)
             {
-                if (CheckCollisionPointRec(mousePosition, CameraToViewRec(comments[i]->valueShape, camera)))
+                if (CheckCollisionPointRec(mousePosition, CameraToViewRec(context->comments[i]->valueShape, context->camera)))
                 {
-                    editComment = i;
+                    context->editComment = i;
                     break;
                 }
             }
         }
-        else if ((editComment != -1) && (selectedNode == -1) && (lineState == 0) && (commentState == 0) && (selectedComment == -1) && (editSize == -1) && (editSizeType == -1) && (editNode == -1))
+        else if ((context->editComment != -1) && (context->selectedNode == NULL_HANDLE) && (context->lineState == 0) && (context->commentState == 0) && (context->selectedComment == -1) && (context->editSize == -1) && (context->editSizeType == -1) && (context->editNode == NULL_HANDLE))
         {
             bool isCurrentText = false;
-            int currentEdit = editComment;
-            for (int i = 0; i < commentsCount; i++)
+            int currentEdit = context->editComment;
+            for (int i = 0; i < context->commentsCount; i++)
             {
-                if (comments[i]->id == editComment)
+                if (context->comments[i]->id == context->editComment)
                 {
-                    if (CheckCollisionPointRec(mousePosition, CameraToViewRec(comments[i]->valueShape, camera)))
+                    if (CheckCollisionPointRec(mousePosition, CameraToViewRec(context->comments[i]->valueShape, context->camera)))
                     {
                         isCurrentText = true;
                         break;
                     }
                 }
 
-                if (CheckCollisionPointRec(mousePosition, CameraToViewRec(comments[i]->valueShape, camera)))
+                if (CheckCollisionPointRec(mousePosition, CameraToViewRec(context->comments[i]->valueShape, context->camera)))
                 {
-                    editComment = i;
+                    context->editComment = i;
                     break;
                 }
             }
 
             // Reset current editing text any other text label is pressed
-            if (!isCurrentText && (currentEdit == editComment)) editComment = -1;
+            if (!isCurrentText && (currentEdit == context->editComment)) context->editComment = -1;
         }
     }
 }
 
+// Pins nodes inside canvas view so their values are calculated even if unused
+void UpdateNodesVisibility(void)
+{
+    Rectangle view = { 0, 0, screenSize.x, screenSize.y };
+
+    for (int i = 0; i < context->nodesOrderCount; i++)
+    {
+        if (context->nodesOrder[i] != NULL) PinNode(context, context->nodesOrder[i], CheckCollisionRecs(CameraToViewRec(context->nodesOrder[i]->shape, context->camera), view));
+    }
+}
+
 // Update required values to created shader for geometry data calculations
 void UpdateShaderData(void)
 {
@@ -1243,8 +1165,7 @@ void UpdateShaderData(void)
 
             if (index != -1)
             {
-                if (textures[index].id != 0) UnloadTexture(textures[index]);
-                textures[index] = LoadTexture(droppedFiles[0]);
+                LoadTextureUnit(index, droppedFiles[0]);
                 texPaths[index] = droppedFiles[0];
 
                 if (shader.id > 0)
@@ -1331,66 +1252,73 @@ void SaveChanges(void)
     {
         // Nodes data reading
         int count = 0;
-        for (int i = 0; i < MAX_NODES; i++)
+        for (int i = 0; i < context->nodesCapacity; i++)
         {
-            for (int k = 0; k < nodesCount; k++)
-            {
-                if (nodes[k] == NULL) continue;
+            int k = context->nodesIndex[i];
 
-                if (nodes[k]->id == i)
-                {
-                    float type = (float)nodes[k]->type;
-                    float property = (float)nodes[k]->property;
-                    float inputs[MAX_INPUTS] = { (float)nodes[k]->inputs[0], (float)nodes[k]->inputs[1], (float)nodes[k]->inputs[2], (float)nodes[k]->inputs[3] };
-                    float inputsCount = (float)nodes[k]->inputsCount;
-                    float inputsLimit = (float)nodes[k]->inputsLimit;
-                    float dataCount = (float)nodes[k]->output.dataCount;
-                    float data[MAX_VALUES] = { nodes[k]->output.data[0].value, nodes[k]->output.data[1].value, nodes[k]->output.data[2].value, nodes[k]->output.data[3].value, nodes[k]->output.data[4].value,
-                    nodes[k]->output.data[5].value, nodes[k]->output.data[6].value, nodes[k]->output.data[7].value, nodes[k]->output.data[8].value, nodes[k]->output.data[9].value, nodes[k]->output.data[10].value,
-                    nodes[k]->output.data[11].value, nodes[k]->output.data[12].value, nodes[k]->output.data[13].value, nodes[k]->output.data[14].value, nodes[k]->output.data[15].value };
-                    float shapeX = (float)nodes[k]->shape.x;
-                    float shapeY = (float)nodes[k]->shape.y;
-
-                    fprintf(dataFile, "%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,\n", type, property,
-                    inputs[0], inputs[1], inputs[2], inputs[3], inputsCount, inputsLimit, dataCount, data[0], data[1], data[2],
-                    data[3], data[4], data[5], data[6], data[7], data[8], data[9], data[10], data[11], data[12], data[13], data[14],
-                    data[15], shapeX, shapeY);
-                    
-                    count++;
-                    break;
-                }
+            if (k != -1)
+            {
+                float type = (float)context->nodes[k]->type;
+                float property = (float)context->nodes[k]->property;
+                float inputs[MAX_INPUTS] = { (float)context->nodes[k]->inputs[0], (float)context->nodes[k]->inputs[1], (float)context->nodes[k]->inputs[2], (float)context->nodes[k]->inputs[3] };
+                float inputsCount = (float)context->nodes[k]->inputsCount;
+                float inputsLimit = (float)context->nodes[k]->inputsLimit;
+                float dataCount = (float)context->nodes[k]->output.dataCount;
+                float data[MAX_VALUES] = { context->nodes[k]->output.data[0], context->nodes[k]->output.data[1], context->nodes[k]->output.data[2], context->nodes[k]->output.data[3], context->nodes[k]->output.data[4],
+                context->nodes[k]->output.data[5], context->nodes[k]->output.data[6], context->nodes[k]->output.data[7], context->nodes[k]->output.data[8], context->nodes[k]->output.data[9], context->nodes[k]->output.data[10],
+                context->nodes[k]->output.data[11], context->nodes[k]->output.data[12], context->nodes[k]->output.data[13], context->nodes[k]->output.data[14], context->nodes[k]->output.data[15] };
+                float shapeX = (float)context->nodes[k]->shape.x;
+                float shapeY = (float)context->nodes[k]->shape.y;
+
+                fprintf(dataFile, "%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,\n", type, property,
+                inputs[0], inputs[1], inputs[2], inputs[3], inputsCount, inputsLimit, dataCount, data[0], data[1], data[2],
+                data[3], data[4], data[5], data[6], data[7], data[8], data[9], data[10], data[11], data[12], data[13], data[14],
+                data[15], shapeX, shapeY);
+
+                count++;
             }
 
-            if (count == nodesCount) break;
+            if (count == context->nodesCount) break;
         }
 
-        // Lines data reading
-        count = 0;
-
-        for (int i = 0; i < MAX_NODES; i++)
+        // Lines data reading (written per target node to keep nodes inputs order)
+        for (int i = 0; i < context->nodesCapacity; i++)
         {
-            for (int k = 0; k < nodesCount; k++)
-            {
-                if (lines[k] == NULL) continue;
+            int k = context->nodesIndex[i];
+            if (k == -1) continue;
 
-                if (lines[k]->id == i)
-                {
-                    fprintf(dataFile, "?%i?%i\n", lines[k]->from, lines[k]->to);
-                    
-                    count++;
-                    break;
-                }
-            }
-
-            if (count == linesCount) break;
+            for (int j = 0; j < context->nodes[k]->inputsCount; j++) fprintf(dataFile, "?%i?%i\n", context->nodes[k]->inputs[j], context->nodes[k]->id);
         }
 
         fclose(dataFile);
     }
 }
 
+// Renders fragment output node on CPU and writes it as an image in output folder
+void ExportPreview(void)
+{
+    FNode fragment = NULL;
+
+    for (int i = 0; i < context->nodesCount; i++)
+    {
+        if (context->nodes[i]->type == FNODE_FRAGMENT) fragment = context->nodes[i];
+    }
+
+    if (fragment != NULL)
+    {
+        // Sampler nodes read textures from the source images kept in RAM when loading them
+        Image preview = GenImageColor(PREVIEW_SIZE, PREVIEW_SIZE, BLANK);
+
+        // Previous preview is kept if fragment output cannot be rendered
+        if (RenderFragmentPixels(context, fragment, preview.width, preview.height, images, MAX_TEXTURES, currentTime, (unsigned char *)preview.data)) ExportImage(preview, PREVIEW_PATH);
+        else TraceLogFNode(false, "error when trying to render fragment output preview, previous preview was kept");
+
+        UnloadImage(preview);
+    }
+}
+
 // Compiles all node structure to create the GLSL fragment shader in output folder
-void CompileShader(void)
+void CompileShader(FNodeContext *ctx, ShaderVersion version)
 {
     SaveChanges();
 
@@ -1401,7 +1329,8 @@ void CompileShader(void)
     remove(FRAGMENT_PATH);
 
     model.materials[0] = LoadMaterialDefault();
-    for (int i = 0; i < MAX_TEXTURES; i++) usedUnits[i] = false;
+    bool usedUnits[MAX_TEXTURES] = { false };
+
     viewUniform = -1;
     transformUniform = -1;
     timeUniformV = -1;
@@ -1416,54 +1345,42 @@ void CompileShader(void)
     {
         // Nodes data reading
         int count = 0;
-        for (int i = 0; i < MAX_NODES; i++)
+        for (int i = 0; i < ctx->nodesCapacity; i++)
         {
-            for (int k = 0; k < nodesCount; k++)
+            int k = ctx->nodesIndex[i];
+
+            if (k != -1)
             {
-                if (nodes[k]->id == i)
-                {
-                    float type = (float)nodes[k]->type;
-                    float property = (float)nodes[k]->property;
-                    float inputs[MAX_INPUTS] = { (float)nodes[k]->inputs[0], (float)nodes[k]->inputs[1], (float)nodes[k]->inputs[2], (float)nodes[k]->inputs[3] };
-                    float inputsCount = (float)nodes[k]->inputsCount;
-                    float inputsLimit = (float)nodes[k]->inputsLimit;
-                    float dataCount = (float)nodes[k]->output.dataCount;
-                    float data[MAX_VALUES] = { nodes[k]->output.data[0].value, nodes[k]->output.data[1].value, nodes[k]->output.data[2].value, nodes[k]->output.data[3].value, nodes[k]->output.data[4].value,
-                    nodes[k]->output.data[5].value, nodes[k]->output.data[6].value, nodes[k]->output.data[7].value, nodes[k]->output.data[8].value, nodes[k]->output.data[9].value, nodes[k]->output.data[10].value,
-                    nodes[k]->output.data[11].value, nodes[k]->output.data[12].value, nodes[k]->output.data[13].value, nodes[k]->output.data[14].value, nodes[k]->output.data[15].value };
-                    float shapeX = (float)nodes[k]->shape.x;
-                    float shapeY = (float)nodes[k]->shape.y;
-
-                    fprintf(dataFile, "%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,\n", type, property,
-                    inputs[0], inputs[1], inputs[2], inputs[3], inputsCount, inputsLimit, dataCount, data[0], data[1], data[2],
-                    data[3], data[4], data[5], data[6], data[7], data[8], data[9], data[10], data[11], data[12], data[13], data[14],
-                    data[15], shapeX, shapeY);
-
-                    count++;
-                    break;
-                }
+                float type = (float)ctx->nodes[k]->type;
+                float property = (float)ctx->nodes[k]->property;
+                float inputs[MAX_INPUTS] = { (float)ctx->nodes[k]->inputs[0], (float)ctx->nodes[k]->inputs[1], (float)ctx->nodes[k]->inputs[2], (float)ctx->nodes[k]->inputs[3] };
+                float inputsCount = (float)ctx->nodes[k]->inputsCount;
+                float inputsLimit = (float)ctx->nodes[k]->inputsLimit;
+                float dataCount = (float)ctx->nodes[k]->output.dataCount;
+                float data[MAX_VALUES] = { ctx->nodes[k]->output.data[0], ctx->nodes[k]->output.data[1], ctx->nodes[k]->output.data[2], ctx->nodes[k]->output.data[3], ctx->nodes[k]->output.data[4],
+                ctx->nodes[k]->output.data[5], ctx->nodes[k]->output.data[6], ctx->nodes[k]->output.data[7], ctx->nodes[k]->output.data[8], ctx->nodes[k]->output.data[9], ctx->nodes[k]->output.data[10],
+                ctx->nodes[k]->output.data[11], ctx->nodes[k]->output.data[12], ctx->nodes[k]->output.data[13], ctx->nodes[k]->output.data[14], ctx->nodes[k]->output.data[15] };
+                float shapeX = (float)ctx->nodes[k]->shape.x;
+                float shapeY = (float)ctx->nodes[k]->shape.y;
+
+                fprintf(dataFile, "%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,\n", type, property,
+                inputs[0], inputs[1], inputs[2], inputs[3], inputsCount, inputsLimit, dataCount, data[0], data[1], data[2],
+                data[3], data[4], data[5], data[6], data[7], data[8], data[9], data[10], data[11], data[12], data[13], data[14],
+                data[15], shapeX, shapeY);
+
+                count++;
             }
 
-            if (count == nodesCount) break;
+            if (count == ctx->nodesCount) break;
         }
 
-        // Lines data reading
-        count = 0;
-
-        for (int i = 0; i < MAX_NODES; i++)
+        // Lines data reading (written per target node to keep nodes inputs order)
+        for (int i = 0; i < ctx->nodesCapacity; i++)
         {
-            for (int k = 0; k < nodesCount; k++)
-            {
-                if (lines[k]->id == i)
-                {
-                    fprintf(dataFile, "?%i?%i\n", lines[k]->from, lines[k]->to);
+            int k = ctx->nodesIndex[i];
+            if (k == -1) continue;
 
-                    count++;
-                    break;
-                }
-            }
-
-            if (count == linesCount) break;
+            for (int j = 0; j < ctx->nodes[k]->inputsCount; j++) fprintf(dataFile, "?%i?%i\n", ctx->nodes[k]->inputs[j], ctx->nodes[k]->id);
         }
 
         fclose(dataFile);
@@ -1536,8 +1453,9 @@ void CompileShader(void)
         fprintf(vertexFile, vUniforms);
 
         fprintf(vertexFile, "// Constant and uniform values\n");
-        int index = GetNodeIndex(nodes[0]->inputs[0]);
-        CheckConstant(nodes[index], vertexFile);
+        int index = GetNodeIndex(ctx, ctx->nodes[0]->inputs[0]);
+        memset(ctx->nodesDeclared, 0, sizeof(bool)*ctx->nodesCapacity);
+        CheckConstant(ctx, ctx->nodes[index], vertexFile, usedUnits);
 
         const char vMain[] = 
         "\nvoid main()\n"
@@ -1548,15 +1466,15 @@ void CompileShader(void)
         "    fragColor = vertexColor;\n\n";
         fprintf(vertexFile, vMain);
 
-        CompileNode(nodes[index], vertexFile, false);
+        CompileNode(ctx, ctx->nodes[index], vertexFile, false, version);
 
-        switch (nodes[index]->output.dataCount)
+        switch (ctx->nodes[index]->output.dataCount)
         {
-            case 1: fprintf(vertexFile, "\n    gl_Position = vec4(node_%02i, node_%02i, node_%02i, 1.0);\n}", nodes[0]->inputs[0], nodes[0]->inputs[0], nodes[0]->inputs[0]); break;
-            case 2: fprintf(vertexFile, "\n    gl_Position = vec4(node_%02i.xy, 0.0, 1.0);\n}", nodes[0]->inputs[0]); break;
-            case 3: fprintf(vertexFile, "\n    gl_Position = vec4(node_%02i.xyz, 1.0);\n}", nodes[0]->inputs[0]); break;
-            case 4: fprintf(vertexFile, "\n    gl_Position = node_%02i;\n}", nodes[0]->inputs[0]); break;
-            case 16: fprintf(vertexFile, "\n    gl_Position = node_%02i;\n}", nodes[0]->inputs[0]); break;
+            case 1: fprintf(vertexFile, "\n    gl_Position = vec4(node_%02i, node_%02i, node_%02i, 1.0);\n}", ctx->nodes[0]->inputs[0], ctx->nodes[0]->inputs[0], ctx->nodes[0]->inputs[0]); break;
+            case 2: fprintf(vertexFile, "\n    gl_Position = vec4(node_%02i.xy, 0.0, 1.0);\n}", ctx->nodes[0]->inputs[0]); break;
+            case 3: fprintf(vertexFile, "\n    gl_Position = vec4(node_%02i.xyz, 1.0);\n}", ctx->nodes[0]->inputs[0]); break;
+            case 4: fprintf(vertexFile, "\n    gl_Position = node_%02i;\n}", ctx->nodes[0]->inputs[0]); break;
+            case 16: fprintf(vertexFile, "\n    gl_Position = node_%02i;\n}", ctx->nodes[0]->inputs[0]); break;
             default: break;
         }
 
@@ -1629,37 +1547,38 @@ void CompileShader(void)
         }
 
         fprintf(fragmentFile, "// Constant and uniform values\n");
-        int index = GetNodeIndex(nodes[1]->inputs[0]);
-        CheckConstant(nodes[index], fragmentFile);
+        int index = GetNodeIndex(ctx, ctx->nodes[1]->inputs[0]);
+        memset(ctx->nodesDeclared, 0, sizeof(bool)*ctx->nodesCapacity);
+        CheckConstant(ctx, ctx->nodes[index], fragmentFile, usedUnits);
 
         const char fMain[] = 
         "\nvoid main()\n"
         "{\n";
         fprintf(fragmentFile, fMain);
 
-        CompileNode(nodes[index], fragmentFile, true);
+        CompileNode(ctx, ctx->nodes[index], fragmentFile, true, version);
 
         switch (version)
         {
             case GLSL_330:
             {
-                switch (nodes[index]->output.dataCount)
+                switch (ctx->nodes[index]->output.dataCount)
                 {
-                    case 1: fprintf(fragmentFile, "\n    finalColor = vec4(node_%02i, node_%02i, node_%02i, 1.0);\n}", nodes[1]->inputs[0], nodes[1]->inputs[0], nodes[1]->inputs[0]); break;
-                    case 2: fprintf(fragmentFile, "\n    finalColor = vec4(node_%02i.xy, 0.0, 1.0);\n}", nodes[1]->inputs[0]); break;
-                    case 3: fprintf(fragmentFile, "\n    finalColor = vec4(node_%02i.xyz, 1.0);\n}", nodes[1]->inputs[0]); break;
-                    case 4: fprintf(fragmentFile, "\n    finalColor = node_%02i;\n}", nodes[1]->inputs[0]); break;
+                    case 1: fprintf(fragmentFile, "\n    finalColor = vec4(node_%02i, node_%02i, node_%02i, 1.0);\n}", ctx->nodes[1]->inputs[0], ctx->nodes[1]->inputs[0], ctx->nodes[1]->inputs[0]); break;
+                    case 2: fprintf(fragmentFile, "\n    finalColor = vec4(node_%02i.xy, 0.0, 1.0);\n}", ctx->nodes[1]->inputs[0]); break;
+                    case 3: fprintf(fragmentFile, "\n    finalColor = vec4(node_%02i.xyz, 1.0);\n}", ctx->nodes[1]->inputs[0]); break;
+                    case 4: fprintf(fragmentFile, "\n    finalColor = node_%02i;\n}", ctx->nodes[1]->inputs[0]); break;
                     default: break;
                 }
             } break;
             case GLSL_100:
             {
-                switch (nodes[index]->output.dataCount)
+                switch (ctx->nodes[index]->output.dataCount)
                 {
-                    case 1: fprintf(fragmentFile, "\n    gl_FragColor = vec4(node_%02i, node_%02i, node_%02i, 1.0);\n}", nodes[1]->inputs[0], nodes[1]->inputs[0], nodes[1]->inputs[0]); break;
-                    case 2: fprintf(fragmentFile, "\n    gl_FragColor = vec4(node_%02i.xy, 0.0, 1.0);\n}", nodes[1]->inputs[0]); break;
-                    case 3: fprintf(fragmentFile, "\n    gl_FragColor = vec4(node_%02i.xyz, 1.0);\n}", nodes[1]->inputs[0]); break;
-                    case 4: fprintf(fragmentFile, "\n    gl_FragColor = node_%02i;\n}", nodes[1]->inputs[0]); break;
+                    case 1: fprintf(fragmentFile, "\n    gl_FragColor = vec4(node_%02i, node_%02i, node_%02i, 1.0);\n}", ctx->nodes[1]->inputs[0], ctx->nodes[1]->inputs[0], ctx->nodes[1]->inputs[0]); break;
+                    case 2: fprintf(fragmentFile, "\n    gl_FragColor = vec4(node_%02i.xy, 0.0, 1.0);\n}", ctx->nodes[1]->inputs[0]); break;
+                    case 3: fprintf(fragmentFile, "\n    gl_FragColor = vec4(node_%02i.xyz, 1.0);\n}", ctx->nodes[1]->inputs[0]); break;
+                    case 4: fprintf(fragmentFile, "\n    gl_FragColor = node_%02i;\n}", ctx->nodes[1]->inputs[0]); break;
                     default: break;
                 }
             } break;
@@ -1677,12 +1596,25 @@ void CompileShader(void)
 }
 
 // Check nodes searching for constant values to define them in shaders
-void CheckConstant(FNode node, FILE *file)
+void CheckConstant(FNodeContext *ctx, FNode node, FILE *file, bool *usedUnits)
 {
+    // Constants used by several nodes are declared once (uniform nodes are declared by nodes compilation)
+    if ((node->type <= FNODE_E) || ((node->type >= FNODE_MATRIX) && (node->type <= FNODE_VECTOR4)))
+    {
+        if (ctx->nodesDeclared[node->id]) return;
+        ctx->nodesDeclared[node->id] = true;
+    }
+
     switch (node->type)
     {
         case FNODE_PI: fprintf(file, "const float node_%02i = 3.14159265358979323846;\n", node->id); break;
         case FNODE_E: fprintf(file, "const float node_%02i = 2.71828182845904523536;\n", node->id); break;
+        case FNODE_MATRIX:
+        {
+            const char fConstantMatrix[] = "const mat4 node_%02i = mat4(%.3f, %.3f, %.3f, %.3f, %.3f, %.3f, %.3f, %.3f, %.3f, %.3f, %.3f, %.3f, %.3f, %.3f, %.3f, %.3f);\n";
+            fprintf(file, fConstantMatrix, node->id, node->output.data[0], node->output.data[1], node->output.data[2], node->output.data[3], node->output.data[4], node->output.data[5], node->output.data[6], node->output.data[7],
+            node->output.data[8], node->output.data[9], node->output.data[10], node->output.data[11], node->output.data[12], node->output.data[13], node->output.data[14], node->output.data[15]);
+        } break;
         case FNODE_VALUE:
         {
             if (node->property)
@@ -1693,18 +1625,18 @@ void CheckConstant(FNode node, FILE *file)
             else
             {
                 const char fConstantValue[] = "const float node_%02i = %.3f;\n";
-                fprintf(file, fConstantValue, node->id, node->output.data[0].value);
+                fprintf(file, fConstantValue, node->id, node->output.data[0]);
             }
         } break;
         case FNODE_VECTOR2:
         {
             const char fConstantVector2[] = "const vec2 node_%02i = vec2(%.3f, %.3f);\n";
-            fprintf(file, fConstantVector2, node->id, node->output.data[0].value, node->output.data[1].value);
+            fprintf(file, fConstantVector2, node->id, node->output.data[0], node->output.data[1]);
         } break;
         case FNODE_VECTOR3:
         {
             const char fConstantVector3[] = "const vec3 node_%02i = vec3(%.3f, %.3f, %.3f);\n";
-            fprintf(file, fConstantVector3, node->id, node->output.data[0].value, node->output.data[1].value, node->output.data[2].value);
+            fprintf(file, fConstantVector3, node->id, node->output.data[0], node->output.data[1], node->output.data[2]);
         } break;
         case FNODE_VECTOR4:
         {
@@ -1716,58 +1648,51 @@ void CheckConstant(FNode node, FILE *file)
             else
             {
                 const char fConstantVector4[] = "const vec4 node_%02i = vec4(%.3f, %.3f, %.3f, %.3f);\n";
-                fprintf(file, fConstantVector4, node->id, node->output.data[0].value, node->output.data[1].value, node->output.data[2].value, node->output.data[3].value);
+                fprintf(file, fConstantVector4, node->id, node->output.data[0], node->output.data[1], node->output.data[2], node->output.data[3]);
             }
         } break;
         case FNODE_SAMPLER2D:
         {
             char fConstantSampler[32] = { '\0' };
-            int index = GetNodeIndex(node->inputs[0]);
-            sprintf(fConstantSampler, "uniform sampler2D texture%i;\n", (int)nodes[index]->output.data[0].value);
-            if (!usedUnits[(int)nodes[index]->output.data[0].value])
+            int index = GetNodeIndex(ctx, node->inputs[0]);
+            sprintf(fConstantSampler, "uniform sampler2D texture%i;\n", (int)ctx->nodes[index]->output.data[0]);
+            if (!usedUnits[(int)ctx->nodes[index]->output.data[0]])
             {
                 fprintf(file, fConstantSampler);
-                usedUnits[(int)nodes[index]->output.data[0].value] = true;
+                usedUnits[(int)ctx->nodes[index]->output.data[0]] = true;
             }
         } break;
         default:
         {
             for (int i = 0; i < node->inputsCount; i++)
             {
-                int index = GetNodeIndex(node->inputs[i]);
-                CheckConstant(nodes[index], file);
+                int index = GetNodeIndex(ctx, node->inputs[i]);
+                CheckConstant(ctx, ctx->nodes[index], file, usedUnits);
             }
         } break;
     }
 }
 
 // Compiles a specific node checking its inputs and writing current node operation in shader
-void CompileNode(FNode node, FILE *file, bool fragment)
+void CompileNode(FNodeContext *ctx, FNode node, FILE *file, bool fragment, ShaderVersion version)
 {
     // Check if current node is an operator
     if ((node->inputsCount > 0) || ((node->type < FNODE_MATRIX) && (node->type > FNODE_E)) || (node->type == FNODE_SAMPLER2D))
     {
+        // Check if current node is previously declared in current shader stage (its inputs were compiled then)
+        if (ctx->nodesDeclared[node->id]) return;
+        ctx->nodesDeclared[node->id] = true;
+
         // Check for operator nodes in inputs to compile them first
         for (int i = 0; i < node->inputsCount; i++)
         {
-            int index = GetNodeIndex(node->inputs[i]);
-            if (nodes[index]->type > FNODE_VECTOR4 || ((nodes[index]->type < FNODE_MATRIX) && (nodes[index]->type > FNODE_E))) CompileNode(nodes[index], file, fragment);
+            int index = GetNodeIndex(ctx, node->inputs[i]);
+            if (ctx->nodes[index]->type > FNODE_VECTOR4 || ((ctx->nodes[index]->type < FNODE_MATRIX) && (ctx->nodes[index]->type > FNODE_E))) CompileNode(ctx, ctx->nodes[index], file, fragment, version);
         }
 
-        // Store variable declaration into a string
-        char check[16] = { '\0' };
-        switch (node->output.dataCount)
-        {
-            case 1: sprintf(check, "float node_%02i", node->id); break;
-            case 2: sprintf(check, "vec2 node_%02i", node->id); break;
-            case 3: sprintf(check, "vec3 node_%02i", node->id); break;
-            case 4: sprintf(check, "vec4 node_%02i", node->id); break;
-            case 16: sprintf(check, "mat4 node_%02i", node->id); break;
-            default: break;
-        }
-
-        // Check if current node is previously defined and declared
-        if (!FSearch(FRAGMENT_PATH, check))
+        // Only output data counts with a GLSL type can be declared
+        int dataCount = node->output.dataCount;
+        if ((dataCount >= 1) && ((dataCount <= 4) || (dataCount == 16)))
         {
             // Variable definition based on current node output data count
             char body[4096] = { '\0' };
@@ -1811,35 +1736,35 @@ void CompileNode(FNode node, FILE *file, bool fragment)
                     {
                         char test[CHAR_SIZE] = { '\0' };
 
-                        int indexA = GetNodeIndex(node->inputs[0]);
-                        int indexB = GetNodeIndex(node->inputs[1]);
+                        int indexA = GetNodeIndex(ctx, node->inputs[0]);
+                        int indexB = GetNodeIndex(ctx, node->inputs[1]);
 
                         switch (version)
                         {
                             case GLSL_330:
                             {
-                                switch ((int)nodes[indexB]->output.data[0].value)
+                                switch ((int)ctx->nodes[indexB]->output.data[0])
                                 {
-                                    case 0: sprintf(test, "texture(texture%i, fragTexCoord);\n    if (node_%02i.a == 0.0) discard;\n", (int)nodes[indexA]->output.data[0].value, node->id); break;
-                                    case 1: sprintf(test, "texture(texture%i, fragTexCoord).rgb;\n", (int)nodes[indexA]->output.data[0].value); break;
-                                    case 2: sprintf(test, "texture(texture%i, fragTexCoord).r;\n", (int)nodes[indexA]->output.data[0].value); break;
-                                    case 3: sprintf(test, "texture(texture%i, fragTexCoord).g;\n", (int)nodes[indexA]->output.data[0].value); break;
-                                    case 4: sprintf(test, "texture(texture%i, fragTexCoord).b;\n", (int)nodes[indexA]->output.data[0].value); break;
-                                    case 5: sprintf(test, "texture(texture%i, fragTexCoord).a;\n    if (node_%02i == 0.0) discard;\n", (int)nodes[indexA]->output.data[0].value, node->id); break;
-                                    default: sprintf(test, "texture(texture%i, fragTexCoord);\n", (int)nodes[indexA]->output.data[0].value); break;
+                                    case 0: sprintf(test, "texture(texture%i, fragTexCoord);\n    if (node_%02i.a == 0.0) discard;\n", (int)ctx->nodes[indexA]->output.data[0], node->id); break;
+                                    case 1: sprintf(test, "texture(texture%i, fragTexCoord).rgb;\n", (int)ctx->nodes[indexA]->output.data[0]); break;
+                                    case 2: sprintf(test, "texture(texture%i, fragTexCoord).r;\n", (int)ctx->nodes[indexA]->output.data[0]); break;
+                                    case 3: sprintf(test, "texture(texture%i, fragTexCoord).g;\n", (int)ctx->nodes[indexA]->output.data[0]); break;
+                                    case 4: sprintf(test, "texture(texture%i, fragTexCoord).b;\n", (int)ctx->nodes[indexA]->output.data[0]); break;
+                                    case 5: sprintf(test, "texture(texture%i, fragTexCoord).a;\n    if (node_%02i == 0.0) discard;\n", (int)ctx->nodes[indexA]->output.data[0], node->id); break;
+                                    default: sprintf(test, "texture(texture%i, fragTexCoord);\n", (int)ctx->nodes[indexA]->output.data[0]); break;
                                 }
                             } break;
                             case GLSL_100:
                             {
-                                switch ((int)nodes[indexB]->output.data[0].value)
+                                switch ((int)ctx->nodes[indexB]->output.data[0])
                                 {
-                                    case 0: sprintf(test, "texture2D(texture%i, fragTexCoord);\n    if (node_%02i.a == 0.0) discard;\n", (int)nodes[indexA]->output.data[0].value, node->id); break;
-                                    case 1: sprintf(test, "texture2D(texture%i, fragTexCoord).rgb;\n", (int)nodes[indexA]->output.data[0].value); break;
-                                    case 2: sprintf(test, "texture2D(texture%i, fragTexCoord).r;\n", (int)nodes[indexA]->output.data[0].value); break;
-                                    case 3: sprintf(test, "texture2D(texture%i, fragTexCoord).g;\n", (int)nodes[indexA]->output.data[0].value); break;
-                                    case 4: sprintf(test, "texture2D(texture%i, fragTexCoord).b;\n", (int)nodes[indexA]->output.data[0].value); break;
-                                    case 5: sprintf(test, "texture2D(texture%i, fragTexCoord).a;\n    if (node_%02i == 0.0) discard;\n", (int)nodes[indexA]->output.data[0].value, node->id); break;
-                                    default: sprintf(test, "texture2D(texture%i, fragTexCoord);\n", (int)nodes[indexA]->output.data[0].value); break;
+                                    case 0: sprintf(test, "texture2D(texture%i, fragTexCoord);\n    if (node_%02i.a == 0.0) discard;\n", (int)ctx->nodes[indexA]->output.data[0], node->id); break;
+                                    case 1: sprintf(test, "texture2D(texture%i, fragTexCoord).rgb;\n", (int)ctx->nodes[indexA]->output.data[0]); break;
+                                    case 2: sprintf(test, "texture2D(texture%i, fragTexCoord).r;\n", (int)ctx->nodes[indexA]->output.data[0]); break;
+                                    case 3: sprintf(test, "texture2D(texture%i, fragTexCoord).g;\n", (int)ctx->nodes[indexA]->output.data[0]); break;
+                                    case 4: sprintf(test, "texture2D(texture%i, fragTexCoord).b;\n", (int)ctx->nodes[indexA]->output.data[0]); break;
+                                    case 5: sprintf(test, "texture2D(texture%i, fragTexCoord).a;\n    if (node_%02i == 0.0) discard;\n", (int)ctx->nodes[indexA]->output.data[0], node->id); break;
+                                    default: sprintf(test, "texture2D(texture%i, fragTexCoord);\n", (int)ctx->nodes[indexA]->output.data[0]); break;
                                 }
                             } break;
                             default: break;
@@ -1860,8 +1785,8 @@ void CompileNode(FNode node, FILE *file, bool fragment)
                     if ((i+1) == node->inputsCount) sprintf(temp, "node_%02i;\n", node->inputs[i]);
                     else
                     {
-                        int nextIndex = GetNodeIndex(node->inputs[i+1]);
-                        if ((nodes[nextIndex]->output.dataCount - 1) == node->output.dataCount)
+                        int nextIndex = GetNodeIndex(ctx, node->inputs[i+1]);
+                        if ((ctx->nodes[nextIndex]->output.dataCount - 1) == node->output.dataCount)
                         {
                             switch (node->output.dataCount)
                             {
@@ -1925,8 +1850,8 @@ void CompileNode(FNode node, FILE *file, bool fragment)
                     case FNODE_ROUND: sprintf(temp, "round(node_%02i);\n", node->inputs[0]); break;
                     case FNODE_VERTEXCOLOR:
                     {
-                        int index = GetNodeIndex(node->inputs[0]);
-                        switch ((int)nodes[index]->output.data[0].value)
+                        int index = GetNodeIndex(ctx, node->inputs[0]);
+                        switch ((int)ctx->nodes[index]->output.data[0])
                         {
                             case 0: sprintf(temp, (fragment ? "fragColor;\n" : "vertexColor;\n")); break;
                             case 1: sprintf(temp, (fragment ? "fragColor.rgb;\n" : "vertexColor.rgb;\n")); break;
@@ -2005,49 +1930,63 @@ void CompileNode(FNode node, FILE *file, bool fragment)
 // Aligns all created nodes
 void AlignAllNodes(void)
 {
-    for (int i = 0; i < nodesCount; i++)
+    for (int i = 0; i < context->nodesCount; i++)
     {
-        AlignNode(nodes[i]);
-        UpdateNodeShapes(nodes[i]);
+        AlignNode(context->nodes[i]);
+        UpdateNodeShapes(context->nodes[i]);
     }
 }
 
 // Destroys all unused nodes
 void ClearUnusedNodes(void)
 {
-    for (int i = nodesCount - 1; i >= 0; i--)
-    {
-        bool used = (nodes[i]->type >= FNODE_VERTEX);
+    BeginGraphEdit(context);
 
-        if (!used)
-        {
-            for (int k = 0; k < linesCount; k++)
-            {
-                if ((nodes[i]->id == lines[k]->from) || (nodes[i]->id == lines[k]->to))
-                {
-                    used = true;
-                    break;
-                }
-            }
-        }
+    for (int i = context->nodesCount - 1; i >= 0; i--)
+    {
+        bool used = ((context->nodes[i]->type >= FNODE_VERTEX) || (context->nodes[i]->inputsCount > 0) || (context->nodes[i]->outputsCount > 0));
 
-        if (!used) DestroyNode(nodes[i]);
+        if (!used) DestroyNode(context, context->nodes[i]);
     }
 
-    TraceLogFNode(false, "all unused nodes have been deleted [USED RAM: %i bytes]", usedMemory);
+    EndGraphEdit(context);
+
+    TraceLogFNode(false, "all unused nodes have been deleted [USED RAM: %i bytes]", context->usedMemory);
 }
 
 // Destroys all created nodes and its linked lines
 void ClearGraph(void)
 {
-    for (int i = nodesCount - 1; i >= 0; i--)
+    // Store output nodes to create them again after releasing the whole graph
+    FNodeType outputTypes[2] = { FNODE_VERTEX, FNODE_FRAGMENT };
+    const char *outputNames[2] = { NULL, NULL };
+    Vector2 outputPositions[2] = { 0 };
+    int outputsCount = 0;
+
+    for (int i = 0; (i < context->nodesCount) && (outputsCount < 2); i++)
     {
-        if (nodes[i]->type < FNODE_VERTEX) DestroyNode(nodes[i]);
+        if (context->nodes[i]->type >= FNODE_VERTEX)
+        {
+            outputTypes[outputsCount] = context->nodes[i]->type;
+            outputNames[outputsCount] = context->nodes[i]->name;
+            outputPositions[outputsCount] = (Vector2){ context->nodes[i]->shape.x, context->nodes[i]->shape.y };
+            outputsCount++;
+        }
     }
 
-    for (int i = commentsCount - 1; i >= 0; i--) DestroyComment(comments[i]);
+    BeginGraphEdit(context);
+    ClearFNodeGraph(context);
+
+    for (int i = 0; i < outputsCount; i++)
+    {
+        FNode output = CreateNodeMaterial(context, outputTypes[i], outputNames[i], 0);
+        output->shape.x = outputPositions[i].x;
+        output->shape.y = outputPositions[i].y;
+    }
 
-    TraceLogFNode(false, "all nodes have been deleted [USED RAM: %i bytes]", usedMemory);
+    EndGraphEdit(context);
+
+    TraceLogFNode(false, "all nodes have been deleted [USED RAM: %i bytes]", context->usedMemory);
 }
 
 // Draw canvas space to create nodes
@@ -2063,7 +2002,7 @@ void DrawCanvas(void)
             DrawText("FNODE 1.0", (screenSize.x - MeasureText("FNODE 1.0", 120))/2, screenSize.y/2 - 60, 120, Fade(LIGHTGRAY, UI_GRID_ALPHA*2));
             DrawText("VICTOR FISAC", (screenSize.x - MeasureText("VICTOR FISAC", 40))/2, screenSize.y*0.65f - 20, 40, Fade(LIGHTGRAY, UI_GRID_ALPHA*2));
 
-            BeginMode2D(camera);
+            BeginMode2D(context->camera);
 
                 DrawCanvasGrid(UI_GRID_COUNT);
 
@@ -2073,12 +2012,16 @@ void DrawCanvas(void)
 
         DrawTexturePro(gridTarget.texture, (Rectangle){ 0, 0, gridTarget.texture.width, -gridTarget.texture.height }, (Rectangle){ 0, 0, screenSize.x, screenSize.y }, (Vector2){ 0, 0 }, 0, WHITE);
 
-        BeginMode2D(camera);
+        BeginMode2D(context->camera);
 
             // Draw all created comments, lines and nodes
-            for (int i = 0; i < commentsCount; i++) DrawComment(comments[i]);
-            for (int i = 0; i < nodesCount; i++) DrawNode(nodes[i]);
-            for (int i = 0; i < linesCount; i++) DrawNodeLine(lines[i]);
+            for (int i = 0; i < context->commentsCount; i++) DrawComment(context, context->comments[i]);
+            for (int i = 0; i < context->nodesOrderCount; i++)
+            {
+                if (context->nodesOrder[i] != NULL) DrawNode(context, context->nodesOrder[i]);
+            }
+
+            for (int i = 0; i < context->linesCount; i++) DrawNodeLine(context, context->lines[i]);
 
         EndMode2D();
 
@@ -2171,7 +2114,7 @@ void DrawInterface(void)
     if (InterfaceButton(LEFT_LAYOUT_RECT, "Clear Unused")) ClearUnusedNodes();
 
     DrawLeftSection("Compilation", &layoutRect, (Vector4){ 4, 1.25f, 2, 1 });
-    if (InterfaceButtonGroup(LEFT_LAYOUT_RECT, "Compile", (compileState >= 0))) CompileShader();
+    if (InterfaceButtonGroup(LEFT_LAYOUT_RECT, "Compile", (compileState >= 0))) CompileShader(context, version);
     if (InterfaceButton(LEFT_LAYOUT_RECT, "Save Changes")) SaveChanges();
 
     DrawLeftSection("Configuration", &layoutRect, (Vector4){ 7, 1.5f, 3, 0.05f });
@@ -2215,73 +2158,73 @@ void DrawInterface(void)
     DrawRectangle(interfaceRect.x - WIDTH_INTERFACE_BORDER*2, interfaceRect.y, WIDTH_INTERFACE_BORDER, interfaceRect.height, COLOR_INTERFACE_BORDER);
 
     DrawRightSection("Constant Properties", &layoutRect, (Vector4){ 0, 0.75f, 5, 1.6f });
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Value")) CreateNodeValue((float)GetRandomValue(-11, 10));
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Vector 2")) CreateNodeVector2((Vector2){ (float)GetRandomValue(0, 10), (float)GetRandomValue(0, 10) });
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Vector 3")) CreateNodeVector3((Vector3){ (float)GetRandomValue(0, 10), (float)GetRandomValue(0, 10), (float)GetRandomValue(0, 10) });
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Vector 4")) CreateNodeVector4((Vector4){ (float)GetRandomValue(0, 10), (float)GetRandomValue(0, 10), (float)GetRandomValue(0, 10), (float)GetRandomValue(0, 10) });
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Matrix 4x4")) CreateNodeMatrix(FMatrixIdentity());
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Value")) CreateNodeValue(context, (float)GetRandomValue(-11, 10));
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Vector 2")) CreateNodeVector2(context, (Vector2){ (float)GetRandomValue(0, 10), (float)GetRandomValue(0, 10) });
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Vector 3")) CreateNodeVector3(context, (Vector3){ (float)GetRandomValue(0, 10), (float)GetRandomValue(0, 10), (float)GetRandomValue(0, 10) });
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Vector 4")) CreateNodeVector4(context, (Vector4){ (float)GetRandomValue(0, 10), (float)GetRandomValue(0, 10), (float)GetRandomValue(0, 10), (float)GetRandomValue(0, 10) });
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Matrix 4x4")) CreateNodeMatrix(context, FMatrixIdentity());
 
     DrawRightSection("Properties", &layoutRect, (Vector4){ 6, 1.75f, 3, 1.25f });
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Value")) CreateNodeProperty(FNODE_VALUE, "Value", 1, 0);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Color")) CreateNodeProperty(FNODE_VECTOR4, "Color", 4, 0);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Sampler2D")) CreateNodeProperty(FNODE_SAMPLER2D, "Sampler 2D", 4, 2);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Value")) CreateNodeProperty(context, FNODE_VALUE, "Value", 1, 0);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Color")) CreateNodeProperty(context, FNODE_VECTOR4, "Color", 4, 0);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Sampler2D")) CreateNodeProperty(context, FNODE_SAMPLER2D, "Sampler 2D", 4, 2);
 
     DrawRightSection("Arithmetic", &layoutRect, (Vector4){ 11, 0.85f, 24, 2 });
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Add")) CreateNodeOperator(FNODE_ADD, "Add", MAX_INPUTS);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Subtract")) CreateNodeOperator(FNODE_SUBTRACT, "Subtract", MAX_INPUTS);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Multiply")) CreateNodeOperator(FNODE_MULTIPLY, "Multiply", MAX_INPUTS);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Multiply Matrix")) CreateNodeOperator(FNODE_MULTIPLYMATRIX, "Multiply Matrix", 2);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Divide")) CreateNodeOperator(FNODE_DIVIDE, "Divide", MAX_INPUTS);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "One Minus")) CreateNodeOperator(FNODE_ONEMINUS, "One Minus", 1);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Abs")) CreateNodeOperator(FNODE_ABS, "Abs", 1);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Clamp 0-1")) CreateNodeOperator(FNODE_CLAMP01, "Clamp 0-1", 1);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Max")) CreateNodeOperator(FNODE_MAX, "Max", 2);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Min")) CreateNodeOperator(FNODE_MIN, "Min", 2);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Negate")) CreateNodeOperator(FNODE_NEGATE, "Negate", 1);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Reciprocal")) CreateNodeOperator(FNODE_RECIPROCAL, "Reciprocal", 1);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Square Root")) CreateNodeOperator(FNODE_SQRT, "Square Root", 1);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Power")) CreateNodeOperator(FNODE_POWER, "Power", 2);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Exp 2")) CreateNodeOperator(FNODE_EXP2, "Exp 2", 1);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Posterize")) CreateNodeOperator(FNODE_POSTERIZE, "Posterize", 2);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Ceil")) CreateNodeOperator(FNODE_CEIL, "Ceil", 1);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Round")) CreateNodeOperator(FNODE_ROUND, "Round", 1);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Trunc")) CreateNodeOperator(FNODE_TRUNC, "Trunc", 1);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Lerp")) CreateNodeOperator(FNODE_LERP, "Lerp", 3);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Step")) CreateNodeOperator(FNODE_STEP, "Step", 2);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "SmoothStep")) CreateNodeOperator(FNODE_SMOOTHSTEP, "SmoothStep", 3);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Add")) CreateNodeOperator(context, FNODE_ADD, "Add", MAX_INPUTS);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Subtract")) CreateNodeOperator(context, FNODE_SUBTRACT, "Subtract", MAX_INPUTS);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Multiply")) CreateNodeOperator(context, FNODE_MULTIPLY, "Multiply", MAX_INPUTS);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Multiply Matrix")) CreateNodeOperator(context, FNODE_MULTIPLYMATRIX, "Multiply Matrix", 2);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Divide")) CreateNodeOperator(context, FNODE_DIVIDE, "Divide", MAX_INPUTS);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "One Minus")) CreateNodeOperator(context, FNODE_ONEMINUS, "One Minus", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Abs")) CreateNodeOperator(context, FNODE_ABS, "Abs", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Clamp 0-1")) CreateNodeOperator(context, FNODE_CLAMP01, "Clamp 0-1", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Max")) CreateNodeOperator(context, FNODE_MAX, "Max", 2);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Min")) CreateNodeOperator(context, FNODE_MIN, "Min", 2);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Negate")) CreateNodeOperator(context, FNODE_NEGATE, "Negate", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Reciprocal")) CreateNodeOperator(context, FNODE_RECIPROCAL, "Reciprocal", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Square Root")) CreateNodeOperator(context, FNODE_SQRT, "Square Root", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Power")) CreateNodeOperator(context, FNODE_POWER, "Power", 2);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Exp 2")) CreateNodeOperator(context, FNODE_EXP2, "Exp 2", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Posterize")) CreateNodeOperator(context, FNODE_POSTERIZE, "Posterize", 2);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Ceil")) CreateNodeOperator(context, FNODE_CEIL, "Ceil", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Round")) CreateNodeOperator(context, FNODE_ROUND, "Round", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Trunc")) CreateNodeOperator(context, FNODE_TRUNC, "Trunc", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Lerp")) CreateNodeOperator(context, FNODE_LERP, "Lerp", 3);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Step")) CreateNodeOperator(context, FNODE_STEP, "Step", 2);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "SmoothStep")) CreateNodeOperator(context, FNODE_SMOOTHSTEP, "SmoothStep", 3);
 
     DrawRightSection("Vector Operations", &layoutRect, (Vector4){ 37, 0.75f, 12, 1.35f});
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Append")) CreateNodeOperator(FNODE_APPEND, "Append", 4);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Normalize")) CreateNodeOperator(FNODE_NORMALIZE, "Normalize", 1);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Cross Product")) CreateNodeOperator(FNODE_CROSSPRODUCT, "Cross Product", 2);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Desaturate")) CreateNodeOperator(FNODE_DESATURATE, "Desaturate", 2);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Distance")) CreateNodeOperator(FNODE_DISTANCE, "Distance", 2);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Dot Product")) CreateNodeOperator(FNODE_DOTPRODUCT, "Dot Product", 2);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Length")) CreateNodeOperator(FNODE_LENGTH, "Length", 1);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Transpose")) CreateNodeOperator(FNODE_TRANSPOSE, "Transpose", 1);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Vector Projection")) CreateNodeOperator(FNODE_PROJECTION, "Vector Projection", 2);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Vector Rejection")) CreateNodeOperator(FNODE_REJECTION, "Vector Rejection", 2);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Half Direction")) CreateNodeOperator(FNODE_HALFDIRECTION, "Half Direction", 2);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Append")) CreateNodeOperator(context, FNODE_APPEND, "Append", 4);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Normalize")) CreateNodeOperator(context, FNODE_NORMALIZE, "Normalize", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Cross Product")) CreateNodeOperator(context, FNODE_CROSSPRODUCT, "Cross Product", 2);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Desaturate")) CreateNodeOperator(context, FNODE_DESATURATE, "Desaturate", 2);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Distance")) CreateNodeOperator(context, FNODE_DISTANCE, "Distance", 2);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Dot Product")) CreateNodeOperator(context, FNODE_DOTPRODUCT, "Dot Product", 2);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Length")) CreateNodeOperator(context, FNODE_LENGTH, "Length", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Transpose")) CreateNodeOperator(context, FNODE_TRANSPOSE, "Transpose", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Vector Projection")) CreateNodeOperator(context, FNODE_PROJECTION, "Vector Projection", 2);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Vector Rejection")) CreateNodeOperator(context, FNODE_REJECTION, "Vector Rejection", 2);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Half Direction")) CreateNodeOperator(context, FNODE_HALFDIRECTION, "Half Direction", 2);
 
     DrawRightSection("Geometry Data", &layoutRect, (Vector4){ 50, 1.45f, 6, 1.85f });
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Vertex Position")) CreateNodeUniform(FNODE_VERTEXPOSITION, "Vertex Position", 3);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Normal Direction")) CreateNodeUniform(FNODE_VERTEXNORMAL, "Normal Direction", 3);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Vertex Color")) CreateNodeOperator(FNODE_VERTEXCOLOR, "Vertex Color", 1);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "View Direction")) CreateNodeUniform(FNODE_VIEWDIRECTION, "View Direction", 3);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Fresnel")) CreateNodeUniform(FNODE_FRESNEL, "Fresnel", 1);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "MVP Matrix")) CreateNodeUniform(FNODE_MVP, "MVP Matrix", 16);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Vertex Position")) CreateNodeUniform(context, FNODE_VERTEXPOSITION, "Vertex Position", 3);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Normal Direction")) CreateNodeUniform(context, FNODE_VERTEXNORMAL, "Normal Direction", 3);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Vertex Color")) CreateNodeOperator(context, FNODE_VERTEXCOLOR, "Vertex Color", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "View Direction")) CreateNodeUniform(context, FNODE_VIEWDIRECTION, "View Direction", 3);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Fresnel")) CreateNodeUniform(context, FNODE_FRESNEL, "Fresnel", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "MVP Matrix")) CreateNodeUniform(context, FNODE_MVP, "MVP Matrix", 16);
 
     DrawRightSection("Math Constants", &layoutRect, (Vector4){ 58, 1.25f, 2, 1.05f });
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "PI")) CreateNodePI();
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "e")) CreateNodeE();
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "PI")) CreateNodePI(context);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "e")) CreateNodeE(context);
 
     DrawRightSection("Trigonometry", &layoutRect, (Vector4){ 61, 1.72f, 7, 0.3f });
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Current Time")) CreateNodeUniform(FNODE_TIME, "Current Time", 1);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Cosine")) CreateNodeOperator(FNODE_COS, "Cosine", 1);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Sine")) CreateNodeOperator(FNODE_SIN, "Sine", 1);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Tangent")) CreateNodeOperator(FNODE_TAN, "Tangent", 1);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Deg to Rad")) CreateNodeOperator(FNODE_DEG2RAD, "Deg to Rad", 1);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Rad to Deg")) CreateNodeOperator(FNODE_RAD2DEG, "Rad to Deg", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Current Time")) CreateNodeUniform(context, FNODE_TIME, "Current Time", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Cosine")) CreateNodeOperator(context, FNODE_COS, "Cosine", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Sine")) CreateNodeOperator(context, FNODE_SIN, "Sine", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Tangent")) CreateNodeOperator(context, FNODE_TAN, "Tangent", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Deg to Rad")) CreateNodeOperator(context, FNODE_DEG2RAD, "Deg to Rad", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Rad to Deg")) CreateNodeOperator(context, FNODE_RAD2DEG, "Rad to Deg", 1);
 
     DrawScrollbar();
 }
@@ -2292,8 +2235,8 @@ void DrawHelp(void)
     if (help)
     {
         int leftPadding = screenSize.x - canvasSize.x;
-        DrawRectangle(leftPadding + PADDING_MAIN_LEFT, PADDING_MAIN_BOTTOM, 450, 200, COLOR_HELP_BACKGROUND);
-        DrawRectangleLines(leftPadding + PADDING_MAIN_LEFT, PADDING_MAIN_BOTTOM, 450, 200, COLOR_HELP_BORDER);
+        DrawRectangle(leftPadding + PADDING_MAIN_LEFT, PADDING_MAIN_BOTTOM, 450, 220, COLOR_HELP_BACKGROUND);
+        DrawRectangleLines(leftPadding + PADDING_MAIN_LEFT, PADDING_MAIN_BOTTOM, 450, 220, COLOR_HELP_BORDER);
 
         DrawText("Welcome to FNode, adventurer!", leftPadding + PADDING_MAIN_LEFT + 15, PADDING_MAIN_BOTTOM + 15, 10, COLOR_HELP_TEXT);
         DrawText("Controls:", leftPadding + PADDING_MAIN_LEFT + 15, PADDING_MAIN_BOTTOM + 35, 10, COLOR_HELP_TEXT);
@@ -2303,9 +2246,10 @@ void DrawHelp(void)
         DrawText("- Delete Node/Line/Comment: RIGHT MOUSE BUTTON", leftPadding + PADDING_MAIN_LEFT + 35, PADDING_MAIN_BOTTOM + 115, 10, COLOR_HELP_TEXT);
         DrawText("- Link: LEFT MOUSE BUTTON (INPUT/OUTPUT RECTANGLES)", leftPadding + PADDING_MAIN_LEFT + 35, PADDING_MAIN_BOTTOM + 135, 10, COLOR_HELP_TEXT);
         DrawText("- Preview: RIGHT ALT BUTTON", PADDING_MAIN_LEFT + 35, leftPadding + PADDING_MAIN_BOTTOM + 155, 10, COLOR_HELP_TEXT);
-        DrawText("Powered by raylib", leftPadding + PADDING_MAIN_LEFT + 15, PADDING_MAIN_BOTTOM + 180, 10, COLOR_HELP_TEXT);
+        DrawText("- Export CPU Preview: P", leftPadding + PADDING_MAIN_LEFT + 35, PADDING_MAIN_BOTTOM + 175, 10, COLOR_HELP_TEXT);
+        DrawText("Powered by raylib", leftPadding + PADDING_MAIN_LEFT + 15, PADDING_MAIN_BOTTOM + 200, 10, COLOR_HELP_TEXT);
 
-        Rectangle iconRect = (Rectangle){ leftPadding + PADDING_MAIN_LEFT + 440 - iconTex.width, PADDING_MAIN_BOTTOM + 190 - iconTex.height, iconTex.width, iconTex.height };
+        Rectangle iconRect = (Rectangle){ leftPadding + PADDING_MAIN_LEFT + 440 - iconTex.width, PADDING_MAIN_BOTTOM + 210 - iconTex.height, iconTex.width, iconTex.height };
         DrawTexturePro(iconTex, (Rectangle){ 0, 0, iconTex.width, iconTex.height }, iconRect, (Vector2){ 0.0f, 0.0f }, 0.0f, WHITE);
     }
     else
@@ -2391,8 +2335,7 @@ void DrawTexturesPanel(Rectangle rect)
 
             if (InterfaceButton((Rectangle){ texRects[i].x + texRects[i].width - 20 - 10, texRects[i].y + 4, 20, 20 }, "X"))
             {
-                UnloadTexture(textures[i]);
-                textures[i].id = 0;
+                UnloadTextureUnit(i);
                 texPaths[i] = NULL;
             }
         }
@@ -2555,7 +2498,8 @@ int main(void)
     fxaa = LoadShader(FXAA_VERTEX, FXAA_FRAGMENT);
 
     // Initialize values
-    camera = (Camera2D){ (Vector2){ 0, 0 }, (Vector2){ screenSize.x/2, screenSize.y/2 }, 0.0f, 1.0f };
+    context = InitFNode();
+    context->camera = (Camera2D){ (Vector2){ 0, 0 }, (Vector2){ screenSize.x/2, screenSize.y/2 }, 0.0f, 1.0f };
     canvasSize = (Vector2){ screenSize.x*0.85f, screenSize.y };
     interfaceRect = (Rectangle){ canvasSize.x, 0.0f, screenSize.x - canvasSize.x, screenSize.y };
     sidebarRect = (Rectangle){ 0, 0, screenSize.x - canvasSize.x, screenSize.y };
@@ -2567,7 +2511,6 @@ int main(void)
     // Initialize shaders values
     fxaaUniform = GetShaderLocation(fxaa, FXAA_SCREENSIZE_UNIFORM);
 
-    InitFNode();
     CheckPreviousShader(true);
     UpdateCamera(&camera3d);
 
@@ -2603,6 +2546,8 @@ int main(void)
             }
         }
 
+        if (!fullVisor) UpdateNodesVisibility();
+        UpdateValues(context);
         UpdateShaderData();
         //----------------------------------------------------------------------------------
 
@@ -2640,7 +2585,7 @@ int main(void)
     UnloadShader(fxaa);
     if (loadedShader) UnloadShader(shader);
 
-    for (int i = 0; i < MAX_TEXTURES; i++) UnloadTexture(textures[i]);
+    for (int i = 0; i < MAX_TEXTURES; i++) UnloadTextureUnit(i);
 
     CloseFNode();
     CloseWindow();        // Close window and OpenGL context
@@ -0,0 +1,440 @@
+/**********************************************************************************************
+*
+*   FNode 1.1 - Calculation accuracy tiers regression test
+*
+*   DESCRIPTION:
+*
+*   Checks fast accuracy math against exact accuracy reference outputs stored below, which were
+*   generated with FSin(), FCos(), FTan() and FPower() exact functions:
+*     - Fast sine, cosine, tangent, exp2 and power errors stay inside their bounds.
+*     - Inputs fast accuracy does not reduce (angles past FAST_MAX_ANGLE, exp2 values outside
+*       [-126, 127], not finite values...) return exactly the exact accuracy results.
+*     - Float4 lanes kernels results are bit identical to scalar fast accuracy ones.
+*   Returns a non zero exit code if any check fails.
+*
+*   Enable FNODE_TESTS option in CMake to build it and run it with ctest:
+*   cmake -S . -B build -DFNODE_TESTS=ON && cmake --build build && ctest --test-dir build
+*
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2016-2020 Victor Fisac
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*
+**********************************************************************************************/
+
+//----------------------------------------------------------------------------------
+// Includes
+//----------------------------------------------------------------------------------
+#define FNODE_IMPLEMENTATION
+#include "fnode.h"
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define     SINCOS_MAX_ERROR            2.5e-7                                      // Fast sine and cosine max absolute error
+#define     TAN_MAX_ERROR               3.0e-7                                      // Fast tangent max relative error
+#define     EXP2_MAX_ERROR              3.0e-7                                      // Fast exp2 max relative error
+#define     POWER_MAX_ERROR             2.0e-6                                      // Fast power max relative error
+#define     REFERENCE_MAX_ULPS          2                                           // Exact accuracy max distance to stored references (platforms math libraries differ)
+#define     SWEEP_SAMPLES               65536                                       // Random inputs count checked for every function
+#define     SWEEP_SEED                  9                                           // Random inputs seed, so every run checks the same inputs
+#define     LANES_PADDING               4                                           // Lanes values after count, which kernels must keep unchanged
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef enum {
+    FUNCTION_SIN = 0,
+    FUNCTION_COS,
+    FUNCTION_TAN,
+    FUNCTION_EXP2
+} AccuracyFunction;
+
+typedef struct AngleReference {
+    float angle;                // Radian angle input
+    float sine;                 // Exact accuracy sine output
+    float cosine;               // Exact accuracy cosine output
+} AngleReference;
+
+typedef struct ValueReference {
+    float value;                // Input value
+    float output;               // Exact accuracy output
+} ValueReference;
+
+typedef struct PowerReference {
+    float value;                // Base input value
+    float exp;                  // Exponent input value
+    float output;               // Exact accuracy output
+} PowerReference;
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static const AngleReference sinCosReferences[] = {
+    { 0.0f, 0.0f, 1.0f },
+    { 0.5f, 0.47942555f, 0.87758255f },
+    { 1.0f, 0.841470957f, 0.540302277f },
+    { -1.25f, -0.948984623f, 0.315322369f },
+    { 0.785398185f, 0.707106769f, 0.707106769f },
+    { 3.14159274f, -8.74227766e-08f, -1.0f },
+    { 100.0f, -0.506365657f, 0.862318873f },
+    { -100.5f, 0.0309599675f, 0.9995206f },
+    { 1000.25f, 0.94030869f, 0.340322793f },
+    { 8191.75f, -0.998888373f, 0.0471382886f },
+    { -8192.0f, 0.956173182f, 0.292801827f },
+    { 8192.5f, -0.698744237f, 0.715371609f },
+    { -9000.0f, -0.615446627f, -0.788178563f },
+    { 200000.0f, -0.0714518949f, 0.997444034f },
+    { 1000000.0f, -0.349993497f, 0.936752141f }
+};
+
+static const ValueReference tanReferences[] = {
+    { 0.0f, 0.0f },
+    { 0.5f, 0.546302497f },
+    { -1.20000005f, -2.5721519f },
+    { 1.5f, 14.1014204f },
+    { 1.5703125f, 2066.85522f },
+    { 10.0f, 0.648360848f },
+    { -100.25f, 0.288599312f },
+    { 8000.0f, 15.2005653f },
+    { 8192.5f, -0.97675699f },
+    { -9000.0f, 0.780846775f },
+    { 1000000.0f, -0.373624444f }
+};
+
+static const ValueReference exp2References[] = {
+    { -150.0f, 0.0f },
+    { -127.5f, 4.15600041e-39f },
+    { -126.5f, 8.31200083e-39f },
+    { -126.0f, 1.17549435e-38f },
+    { -10.25f, 0.000821187918f },
+    { -0.5f, 0.707106769f },
+    { 0.0f, 1.0f },
+    { 0.300000012f, 1.23114443f },
+    { 1.0f, 2.0f },
+    { 10.75f, 1722.15588f },
+    { 126.900002f, 1.58747509e+38f },
+    { 127.0f, 1.70141183e+38f },
+    { 127.25f, 2.02333099e+38f },
+    { 128.0f, INFINITY },
+    { 130.0f, INFINITY }
+};
+
+static const PowerReference powerReferences[] = {
+    { 2.0f, 10.0f, 1024.0f },
+    { 0.5f, -3.25f, 9.51365662f },
+    { 10.0f, 2.5f, 316.227753f },
+    { 3.70000005f, 0.330000013f, 1.53994989f },
+    { 100.0f, -4.0f, 9.99999994e-09f },
+    { 0.00100000005f, 3.0f, 1.00000019e-09f },
+    { -2.0f, 2.0f, 4.0f },
+    { 0.0f, 3.0f, 0.0f },
+    { 1.0f, 1000.0f, 1.0f },
+    { 2.0f, 200.0f, INFINITY }
+};
+
+static const char *functionNames[] = { "sin", "cos", "tan", "exp2" };
+static int failures = 0;                // Failed checks count
+
+//----------------------------------------------------------------------------------
+// Functions Declaration
+//----------------------------------------------------------------------------------
+static void CheckReferences(void);                                          // Checks exact and fast accuracy outputs against stored references
+static void CheckSweep(AccuracyFunction function, float min, float max);    // Checks fast accuracy errors and lanes kernels of random inputs in a range
+static void CheckPowerSweep(void);                                          // Checks fast accuracy power errors of random inputs
+static void CheckLanes(AccuracyFunction function, const float *values, int count);  // Checks lanes kernel results are bit identical to scalar fast accuracy ones
+static void CheckExact(const char *name, float input, float exact, float reference);  // Checks an exact accuracy output is close to its stored reference
+static void CheckFast(const char *name, float input, float fast, float exact, double error, double maxError, bool reduced);  // Checks a fast accuracy output error or its fallback to exact accuracy
+static bool IsReduced(AccuracyFunction function, float value);             // Returns true if fast accuracy reduces a value instead of using exact accuracy
+static float Exact(AccuracyFunction function, float value);                // Returns a function exact accuracy output
+static float Fast(AccuracyFunction function, float value);                 // Returns a function scalar fast accuracy output
+static double Error(AccuracyFunction function, float value, float fast);   // Returns a function fast accuracy error measured in double precision
+static bool SameBits(float a, float b);                                    // Returns true if two values are bit identical (any not a number values are equal)
+static float RandomValue(float min, float max);                            // Returns a random value between min and max
+
+//----------------------------------------------------------------------------------
+// Main Entry Point
+//----------------------------------------------------------------------------------
+int main(void)
+{
+    srand(SWEEP_SEED);
+
+    CheckReferences();
+
+    CheckSweep(FUNCTION_SIN, -FAST_MAX_ANGLE*1.25f, FAST_MAX_ANGLE*1.25f);
+    CheckSweep(FUNCTION_COS, -FAST_MAX_ANGLE*1.25f, FAST_MAX_ANGLE*1.25f);
+    CheckSweep(FUNCTION_SIN, -100.0f, 100.0f);
+    CheckSweep(FUNCTION_COS, -100.0f, 100.0f);
+    CheckSweep(FUNCTION_TAN, -100.0f, 100.0f);
+    CheckSweep(FUNCTION_EXP2, -140.0f, 140.0f);
+    CheckSweep(FUNCTION_EXP2, -30.0f, 30.0f);
+    CheckPowerSweep();
+
+#if defined(FNODE_SIMD_SSE2)
+    printf("FNode accuracy tiers (SSE2 lanes): %i failed checks\n", failures);
+#else
+    printf("FNode accuracy tiers (scalar lanes): %i failed checks\n", failures);
+#endif
+
+    return ((failures > 0) ? 1 : 0);
+}
+
+//----------------------------------------------------------------------------------
+// Functions Definition
+//----------------------------------------------------------------------------------
+// Checks exact and fast accuracy outputs against stored references
+static void CheckReferences(void)
+{
+    int anglesCount = sizeof(sinCosReferences)/sizeof(AngleReference);
+    int tanCount = sizeof(tanReferences)/sizeof(ValueReference);
+    int exp2Count = sizeof(exp2References)/sizeof(ValueReference);
+    int powerCount = sizeof(powerReferences)/sizeof(PowerReference);
+    float angles[sizeof(sinCosReferences)/sizeof(AngleReference)] = { 0 };
+    float tanValues[sizeof(tanReferences)/sizeof(ValueReference)] = { 0 };
+    float exp2Values[sizeof(exp2References)/sizeof(ValueReference)] = { 0 };
+
+    for (int i = 0; i < anglesCount; i++)
+    {
+        AngleReference reference = sinCosReferences[i];
+        angles[i] = reference.angle;
+
+        CheckExact("sin", reference.angle, FSin(reference.angle), reference.sine);
+        CheckExact("cos", reference.angle, FCos(reference.angle), reference.cosine);
+        CheckFast("sin", reference.angle, FFastSinCos(reference.angle, 0), reference.sine, fabs(FFastSinCos(reference.angle, 0) - reference.sine), SINCOS_MAX_ERROR, IsReduced(FUNCTION_SIN, reference.angle));
+        CheckFast("cos", reference.angle, FFastSinCos(reference.angle, 1), reference.cosine, fabs(FFastSinCos(reference.angle, 1) - reference.cosine), SINCOS_MAX_ERROR, IsReduced(FUNCTION_COS, reference.angle));
+    }
+
+    CheckLanes(FUNCTION_SIN, angles, anglesCount);
+    CheckLanes(FUNCTION_COS, angles, anglesCount);
+
+    for (int i = 0; i < tanCount; i++)
+    {
+        ValueReference reference = tanReferences[i];
+        float fast = FFastTan(reference.value);
+        tanValues[i] = reference.value;
+
+        CheckExact("tan", reference.value, FTan(reference.value), reference.output);
+        CheckFast("tan", reference.value, fast, reference.output, fabs(fast - reference.output)/fabs(reference.output), TAN_MAX_ERROR, IsReduced(FUNCTION_TAN, reference.value) && (reference.output != 0.0f));
+    }
+
+    CheckLanes(FUNCTION_TAN, tanValues, tanCount);
+
+    for (int i = 0; i < exp2Count; i++)
+    {
+        ValueReference reference = exp2References[i];
+        float fast = FFastExp2(reference.value);
+        exp2Values[i] = reference.value;
+
+        CheckExact("exp2", reference.value, FPower(2.0f, reference.value), reference.output);
+        CheckFast("exp2", reference.value, fast, reference.output, fabs(fast - reference.output)/reference.output, EXP2_MAX_ERROR, IsReduced(FUNCTION_EXP2, reference.value));
+    }
+
+    CheckLanes(FUNCTION_EXP2, exp2Values, exp2Count);
+
+    for (int i = 0; i < powerCount; i++)
+    {
+        PowerReference reference = powerReferences[i];
+        float fast = FFastPower(reference.value, reference.exp);
+        bool reduced = ((reference.value >= FLT_MIN) && (reference.value <= FLT_MAX) && IsReduced(FUNCTION_EXP2, reference.exp*log2f(reference.value)));
+
+        CheckExact("pow", reference.value, FPower(reference.value, reference.exp), reference.output);
+        CheckFast("pow", reference.value, fast, reference.output, fabs(fast - reference.output)/reference.output, POWER_MAX_ERROR, reduced);
+    }
+
+    // Not finite values are never reduced by fast accuracy
+    float special[] = { NAN, -NAN, INFINITY, -INFINITY, FLT_MAX, -FLT_MAX };
+    int specialCount = sizeof(special)/sizeof(float);
+
+    for (int f = FUNCTION_SIN; f <= FUNCTION_EXP2; f++)
+    {
+        for (int i = 0; i < specialCount; i++) CheckFast(functionNames[f], special[i], Fast(f, special[i]), Exact(f, special[i]), 0.0, 0.0, false);
+
+        CheckLanes(f, special, specialCount);
+    }
+}
+
+// Checks fast accuracy errors and lanes kernels of random inputs in a range
+static void CheckSweep(AccuracyFunction function, float min, float max)
+{
+    static float values[SWEEP_SAMPLES] = { 0 };
+    double maxError = ((function <= FUNCTION_COS) ? SINCOS_MAX_ERROR : ((function == FUNCTION_TAN) ? TAN_MAX_ERROR : EXP2_MAX_ERROR));
+
+    for (int i = 0; i < SWEEP_SAMPLES; i++)
+    {
+        values[i] = RandomValue(min, max);
+
+        float fast = Fast(function, values[i]);
+        CheckFast(functionNames[function], values[i], fast, Exact(function, values[i]), Error(function, values[i], fast), maxError, IsReduced(function, values[i]));
+    }
+
+    // Lanes count is not a multiple of four, so kernels remainders are checked too
+    CheckLanes(function, values, SWEEP_SAMPLES - 3);
+}
+
+// Checks fast accuracy power errors of random inputs
+static void CheckPowerSweep(void)
+{
+    for (int i = 0; i < SWEEP_SAMPLES; i++)
+    {
+        float value = RandomValue(0.001f, 100.0f);
+        float exp = RandomValue(-4.0f, 4.0f);
+        float fast = FFastPower(value, exp);
+        double exact = pow(value, exp);
+
+        CheckFast("pow", value, fast, FPower(value, exp), fabs(fast - exact)/exact, POWER_MAX_ERROR, true);
+    }
+}
+
+// Checks lanes kernel results are bit identical to scalar fast accuracy ones
+static void CheckLanes(AccuracyFunction function, const float *values, int count)
+{
+    float *lanes = (float *)FNODE_MALLOC((count + LANES_PADDING)*sizeof(float));
+    if (lanes == NULL) TraceLogFNode(true, "accuracy test failed when trying to allocate %i lanes", count + LANES_PADDING);
+
+    memcpy(lanes, values, count*sizeof(float));
+    for (int i = count; i < count + LANES_PADDING; i++) lanes[i] = (float)i;
+
+    switch (function)
+    {
+        case FUNCTION_SIN: FLanesSinCos(lanes, 0, count); break;
+        case FUNCTION_COS: FLanesSinCos(lanes, 1, count); break;
+        case FUNCTION_TAN: FLanesTan(lanes, count); break;
+        case FUNCTION_EXP2: FLanesExp2(lanes, count); break;
+        default: break;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        float fast = Fast(function, values[i]);
+
+        if (!SameBits(lanes[i], fast))
+        {
+            printf("%s lanes(%.9g) = %.9g, scalar fast = %.9g\n", functionNames[function], values[i], lanes[i], fast);
+            failures++;
+        }
+    }
+
+    for (int i = count; i < count + LANES_PADDING; i++)
+    {
+        if (lanes[i] != (float)i)
+        {
+            printf("%s lanes changed value %i after count %i\n", functionNames[function], i, count);
+            failures++;
+        }
+    }
+
+    FNODE_FREE(lanes);
+}
+
+// Checks an exact accuracy output is close to its stored reference
+static void CheckExact(const char *name, float input, float exact, float reference)
+{
+    int exactBits = 0;
+    int referenceBits = 0;
+
+    memcpy(&exactBits, &exact, sizeof(float));
+    memcpy(&referenceBits, &reference, sizeof(float));
+
+    bool close = (((exactBits < 0) == (referenceBits < 0)) && (abs(exactBits - referenceBits) <= REFERENCE_MAX_ULPS));
+
+    if (!close && !((exact == 0.0f) && (reference == 0.0f)))
+    {
+        printf("%s exact(%.9g) = %.9g, reference = %.9g\n", name, input, exact, reference);
+        failures++;
+    }
+}
+
+// Checks a fast accuracy output error or its fallback to exact accuracy
+static void CheckFast(const char *name, float input, float fast, float exact, double error, double maxError, bool reduced)
+{
+    if (reduced)
+    {
+        if (!(error <= maxError))
+        {
+            printf("%s fast(%.9g) = %.9g, error %.3g exceeds %.3g\n", name, input, fast, error, maxError);
+            failures++;
+        }
+    }
+    else if (!SameBits(fast, exact))
+    {
+        printf("%s fast(%.9g) = %.9g, expected exact %.9g\n", name, input, fast, exact);
+        failures++;
+    }
+}
+
+// Returns true if fast accuracy reduces a value instead of using exact accuracy
+static bool IsReduced(AccuracyFunction function, float value)
+{
+    if (function == FUNCTION_EXP2) return ((value >= -126.0f) && (value <= 127.0f));
+
+    return (fabsf(value) <= FAST_MAX_ANGLE);
+}
+
+// Returns a function exact accuracy output
+static float Exact(AccuracyFunction function, float value)
+{
+    switch (function)
+    {
+        case FUNCTION_SIN: return FSin(value);
+        case FUNCTION_COS: return FCos(value);
+        case FUNCTION_TAN: return FTan(value);
+        case FUNCTION_EXP2: return FPower(2.0f, value);
+        default: return 0.0f;
+    }
+}
+
+// Returns a function scalar fast accuracy output
+static float Fast(AccuracyFunction function, float value)
+{
+    switch (function)
+    {
+        case FUNCTION_SIN: return FFastSinCos(value, 0);
+        case FUNCTION_COS: return FFastSinCos(value, 1);
+        case FUNCTION_TAN: return FFastTan(value);
+        case FUNCTION_EXP2: return FFastExp2(value);
+        default: return 0.0f;
+    }
+}
+
+// Returns a function fast accuracy error measured in double precision
+// NOTE: sine and cosine errors are absolute, tangent and exp2 ones are relative
+static double Error(AccuracyFunction function, float value, float fast)
+{
+    switch (function)
+    {
+        case FUNCTION_SIN: return fabs(fast - sin(value));
+        case FUNCTION_COS: return fabs(fast - cos(value));
+        case FUNCTION_TAN: return fabs(fast - tan(value))/fabs(tan(value));
+        case FUNCTION_EXP2: return fabs(fast - pow(2.0, value))/pow(2.0, value);
+        default: return 0.0;
+    }
+}
+
+// Returns true if two values are bit identical (any not a number values are equal)
+static bool SameBits(float a, float b)
+{
+    if (isnan(a) || isnan(b)) return (isnan(a) && isnan(b));
+
+    return (memcmp(&a, &b, sizeof(float)) == 0);
+}
+
+// Returns a random value between min and max
+static float RandomValue(float min, float max)
+{
+    return min + (max - min)*((float)rand()/(float)RAND_MAX);
+}
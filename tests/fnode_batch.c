@@ -0,0 +1,162 @@
+/**********************************************************************************************
+*
+*   FNode 1.1 - Batch calculation parity regression test
+*
+*   DESCRIPTION:
+*
+*   Checks nodes values calculated over time samples in lanes batches by CalculateTimeCurves()
+*   are bit identical to the ones calculated one sample at a time by UpdateValues():
+*     - Vector multiplied by a constant matrix (lanes transformed by the matrix).
+*     - Matrix multiplied by a matrix, constant or calculated (16 values component by component).
+*     - Vector multiplied by a calculated matrix.
+*   Returns a non zero exit code if any check fails.
+*
+*   Enable FNODE_TESTS option in CMake to build it and run it with ctest:
+*   cmake -S . -B build -DFNODE_TESTS=ON && cmake --build build && ctest --test-dir build
+*
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2016-2020 Victor Fisac
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*
+**********************************************************************************************/
+
+//----------------------------------------------------------------------------------
+// Includes
+//----------------------------------------------------------------------------------
+#define FNODE_IMPLEMENTATION
+#include "fnode.h"
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define     TIME_SAMPLES                9                                           // Time samples count calculated for every checked node
+#define     MATRIX_SEED                 5                                           // Random matrices seed, so every run checks the same values
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static const float times[TIME_SAMPLES] = { 0.0f, 0.25f, 0.5f, 1.0f, 2.0f, 3.5f, -1.0f, -3.0f, 10.0f };
+static float curves[TIME_SAMPLES*MAX_VALUES] = { 0 };
+static int failures = 0;                // Failed checks count
+
+//----------------------------------------------------------------------------------
+// Functions Declaration
+//----------------------------------------------------------------------------------
+static void CheckCurves(FNodeContext *ctx, FNode node, FNode time, const char *name);  // Checks a node time curves are bit identical to its values calculated at every time sample
+static FNode Multiply(FNodeContext *ctx, FNode a, FNode b);                 // Creates a multiply operator node linked to two input nodes
+static Matrix RandomMatrix(void);                                           // Returns a matrix of random values between -12.87 and 12.87
+
+//----------------------------------------------------------------------------------
+// Main Entry Point
+//----------------------------------------------------------------------------------
+int main(void)
+{
+    srand(MATRIX_SEED);
+
+    FNodeContext *ctx = CreateFNodeContext();
+
+    FNode time = CreateNodeUniform(ctx, FNODE_TIME, "Time", 1);
+    FNode vector = CreateNodeVector4(ctx, (Vector4){ 1.0f, 2.0f, 3.0f, 1.0f });
+    FNode matA = CreateNodeMatrix(ctx, RandomMatrix());
+    FNode matB = CreateNodeMatrix(ctx, RandomMatrix());
+    FNode timeVector = Multiply(ctx, vector, time);
+    FNode timeMatrix = Multiply(ctx, matA, time);
+
+    CheckCurves(ctx, Multiply(ctx, timeVector, matA), time, "vector x matrix");
+    CheckCurves(ctx, Multiply(ctx, matA, matB), time, "matrix x matrix");
+    CheckCurves(ctx, Multiply(ctx, timeMatrix, matB), time, "time matrix x matrix");
+    CheckCurves(ctx, Multiply(ctx, matB, timeMatrix), time, "matrix x time matrix");
+    CheckCurves(ctx, Multiply(ctx, timeVector, Multiply(ctx, matA, matB)), time, "vector x multiplied matrices");
+    CheckCurves(ctx, Multiply(ctx, timeVector, timeMatrix), time, "vector x time matrix");
+
+    DestroyFNodeContext(ctx);
+
+#if defined(FNODE_SIMD_SSE2)
+    printf("FNode batch parity (SSE2 lanes): %i failed checks\n", failures);
+#else
+    printf("FNode batch parity (scalar lanes): %i failed checks\n", failures);
+#endif
+
+    return ((failures > 0) ? 1 : 0);
+}
+
+//----------------------------------------------------------------------------------
+// Functions Definition
+//----------------------------------------------------------------------------------
+// Checks a node time curves are bit identical to its values calculated at every time sample
+static void CheckCurves(FNodeContext *ctx, FNode node, FNode time, const char *name)
+{
+    int dataCount = CalculateTimeCurves(ctx, node, times, TIME_SAMPLES, curves);
+
+    if (dataCount == 0)
+    {
+        printf("%s: time curves not calculated\n", name);
+        failures++;
+        return;
+    }
+
+    PinNode(ctx, node, true);
+
+    for (int s = 0; s < TIME_SAMPLES; s++)
+    {
+        time->output.data[0] = times[s];
+        MarkNodeDirty(ctx, time);
+        UpdateValues(ctx);
+
+        if (dataCount != node->output.dataCount)
+        {
+            printf("%s: curves data count %i, values data count %i\n", name, dataCount, node->output.dataCount);
+            failures++;
+            break;
+        }
+
+        for (int c = 0; c < dataCount; c++)
+        {
+            if (memcmp(&curves[c*TIME_SAMPLES + s], &node->output.data[c], sizeof(float)) != 0)
+            {
+                printf("%s: time %g component %i curve = %.9g, value = %.9g\n", name, times[s], c, curves[c*TIME_SAMPLES + s], node->output.data[c]);
+                failures++;
+            }
+        }
+    }
+
+    PinNode(ctx, node, false);
+}
+
+// Creates a multiply operator node linked to two input nodes
+static FNode Multiply(FNodeContext *ctx, FNode a, FNode b)
+{
+    FNode node = CreateNodeOperator(ctx, FNODE_MULTIPLY, "Multiply", 4);
+
+    LinkNodeLine(ctx, CreateNodeLine(ctx, a->id), node->id);
+    LinkNodeLine(ctx, CreateNodeLine(ctx, b->id), node->id);
+
+    return node;
+}
+
+// Returns a matrix of random values between -12.87 and 12.87
+static Matrix RandomMatrix(void)
+{
+    Matrix mat = { 0 };
+    float *values = (float *)&mat;
+
+    for (int i = 0; i < 16; i++) values[i] = (rand()%20001 - 10000)/777.0f;
+
+    return mat;
+}
@@ -0,0 +1,122 @@
+/**********************************************************************************************
+*
+*   FNode 1.1 - Lazy values texts regression test
+*
+*   DESCRIPTION:
+*
+*   Checks nodes values texts formatted lazily by UpdateNodeText() match their values after every
+*   CalculateValues() pass, in a graph large enough to be calculated on threads pool when built
+*   defining FNODE_PARALLEL (every calculated node whose values changed must be marked to format
+*   its texts again, in serial and parallel calculation).
+*   Returns a non zero exit code if any check fails.
+*
+*   Enable FNODE_TESTS option in CMake to build it and run it with ctest:
+*   cmake -S . -B build -DFNODE_TESTS=ON && cmake --build build && ctest --test-dir build
+*
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2016-2020 Victor Fisac
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*
+**********************************************************************************************/
+
+//----------------------------------------------------------------------------------
+// Includes
+//----------------------------------------------------------------------------------
+#define FNODE_IMPLEMENTATION
+#include "fnode.h"
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define     TEXT_NODES                  1200                                        // Pinned multiply nodes count (more than PARALLEL_MIN_NODES)
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static FNode values[TEXT_NODES] = { 0 };            // Value nodes multiplied by every multiply node
+static FNode multiplies[TEXT_NODES] = { 0 };        // Pinned multiply nodes which values texts are checked
+static int failures = 0;                            // Failed checks count
+
+//----------------------------------------------------------------------------------
+// Functions Declaration
+//----------------------------------------------------------------------------------
+static void CheckTexts(const char *name);                                   // Checks multiply nodes values texts match their calculated values
+
+//----------------------------------------------------------------------------------
+// Main Entry Point
+//----------------------------------------------------------------------------------
+int main(void)
+{
+    FNodeContext *ctx = CreateFNodeContext();
+    FNode two = CreateNodeValue(ctx, 2.0f);
+
+    for (int i = 0; i < TEXT_NODES; i++)
+    {
+        values[i] = CreateNodeValue(ctx, (float)i);
+        multiplies[i] = CreateNodeOperator(ctx, FNODE_MULTIPLY, "Multiply", 4);
+
+        LinkNodeLine(ctx, CreateNodeLine(ctx, values[i]->id), multiplies[i]->id);
+        LinkNodeLine(ctx, CreateNodeLine(ctx, two->id), multiplies[i]->id);
+        PinNode(ctx, multiplies[i], true);
+    }
+
+    CalculateValues(ctx);
+    CheckTexts("first calculation");
+
+    // Editing a value input must format again its multiply node values texts
+    for (int i = 0; i < TEXT_NODES; i += 3)
+    {
+        values[i]->output.data[0] = -0.5f*i;
+        MarkNodeDirty(ctx, values[i]);
+    }
+
+    CalculateValues(ctx);
+    CheckTexts("edited values calculation");
+
+    DestroyFNodeContext(ctx);
+
+#if defined(FNODE_PARALLEL)
+    printf("FNode lazy values texts (parallel): %i failed checks\n", failures);
+#else
+    printf("FNode lazy values texts (serial): %i failed checks\n", failures);
+#endif
+
+    return ((failures > 0) ? 1 : 0);
+}
+
+//----------------------------------------------------------------------------------
+// Functions Definition
+//----------------------------------------------------------------------------------
+// Checks multiply nodes values texts match their calculated values
+static void CheckTexts(const char *name)
+{
+    char expected[MAX_NODE_LENGTH] = { 0 };
+
+    for (int i = 0; i < TEXT_NODES; i++)
+    {
+        UpdateNodeText(multiplies[i]);
+        FFloatToString(expected, multiplies[i]->output.data[0]);
+
+        if (strcmp(multiplies[i]->values[0].valueText, expected) != 0)
+        {
+            printf("%s: multiply node %i value text = '%s', expected '%s'\n", name, i, multiplies[i]->values[0].valueText, expected);
+            failures++;
+        }
+    }
+}